@@ -0,0 +1,250 @@
+// Compares the frustum test of camera and shadow packets with the
+// interval test it replaced. The cull rate is the share of primitive
+// boxes missed by every ray of a packet that each test rejects, and the
+// time is for BIH traversal of all packets with each test in place.
+//
+// Usage: frustum_bench [scene.lua] [repeats]
+// Run it from the data directory so the scene's require calls resolve.
+
+#include <iostream>
+#include <iomanip>
+#include <stdlib.h>
+#include <vector>
+#include <QElapsedTimer>
+
+#include "a4.hpp"
+#include "bih.hpp"
+#include "camera.hpp"
+#include "capture.hpp"
+#include "packet.hpp"
+#include "primitive.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+// Boxes checked per packet for the cull rate, spread over the scene
+#define MAX_BOXES 2000
+
+#define PACKET_WIDTH 16
+
+// The scene the script passed to gr.render
+static CapturedScene s_scene;
+
+static vector<Ray*>* copyRays(const vector<Ray*>& rays) {
+    vector<Ray*>* copy = new vector<Ray*>();
+
+    for(auto it = rays.begin(); it != rays.end(); ++it) {
+        copy->push_back(*it == NULL ? NULL : new Ray(**it));
+    }
+
+    return copy;
+}
+
+static void deleteRays(const vector<vector<Ray*>*>& rays) {
+    for(auto it = rays.begin(); it != rays.end(); ++it) {
+        for(auto ray = (*it)->begin(); ray != (*it)->end(); ++ray) {
+            delete *ray;
+        }
+
+        delete *it;
+    }
+}
+
+struct CullRate {
+    CullRate() : missed(0), interval(0), frustum(0) {}
+
+    long missed;
+    long interval;
+    long frustum;
+};
+
+static void countCulls(Packet& packet, vector<AABB>& boxes, CullRate* rate) {
+    vector<Ray*>* rays = packet.getRays();
+
+    for(auto box = boxes.begin(); box != boxes.end(); ++box) {
+        bool missed = true;
+
+        for(auto it = rays->begin(); it != rays->end(); ++it) {
+            if(*it != NULL && (box->intersect(**it) || box->contains(**it))) {
+                missed = false;
+                break;
+            }
+        }
+
+        if(!missed) {
+            continue;
+        }
+
+        ++rate->missed;
+
+        if(box->allMiss(packet)) {
+            ++rate->interval;
+        }
+        if(packet.getFrustum().cullsBox(box->m_min, box->m_max)) {
+            ++rate->frustum;
+        }
+    }
+}
+
+// Traverses fresh copies of the packets, returning the time in ms and
+// the number of rays that hit something
+static double timeTraversal(BIHTree& bih, const vector<vector<Ray*>*>& rays, bool closest,
+        bool frusta, int repeats, int* hits)
+{
+    FRUSTA = frusta;
+
+    double total = 0.0;
+    *hits = 0;
+
+    for(int r = 0; r < repeats; ++r) {
+        vector<Packet*> packets;
+
+        for(auto it = rays.begin(); it != rays.end(); ++it) {
+            Packet* packet = new Packet();
+            packet->setRays(copyRays(**it));
+            packets.push_back(packet);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for(auto it = packets.begin(); it != packets.end(); ++it) {
+            int n = (*it)->getRays()->size();
+
+            vector<bool> v_hit(n);
+            vector<Intersection> v_isect(n);
+
+            bih.getIntersection(**it, v_hit, closest ? &v_isect : NULL);
+
+            if(r == 0) {
+                for(int i = 0; i < n; ++i) {
+                    *hits += v_hit.at(i);
+                }
+            }
+        }
+
+        total += (double)timer.nsecsElapsed() / 1.0e6;
+
+        for(auto it = packets.begin(); it != packets.end(); ++it) {
+            delete *it;
+        }
+    }
+
+    return total / repeats;
+}
+
+static void report(const string& name, BIHTree& bih, const vector<vector<Ray*>*>& rays,
+        const CullRate& rate, bool closest, int repeats)
+{
+    // Once untimed so both runs start warm
+    int hits;
+    timeTraversal(bih, rays, closest, true, 1, &hits);
+
+    int intervalHits;
+    int frustumHits;
+
+    double intervalTime = timeTraversal(bih, rays, closest, false, repeats, &intervalHits);
+    double frustumTime = timeTraversal(bih, rays, closest, true, repeats, &frustumHits);
+
+    double missed = rate.missed > 0 ? (double)rate.missed : 1.0;
+
+    cout << std::fixed << std::setprecision(1);
+    cout << name << ": " << rays.size() << " packets, " << rate.missed << " missed boxes" << endl;
+    cout << "    interval  " << 100.0 * rate.interval / missed << "% culled, "
+         << intervalTime << " ms, " << intervalHits << " hits" << endl;
+    cout << "    frustum   " << 100.0 * rate.frustum / missed << "% culled, "
+         << frustumTime << " ms, " << frustumHits << " hits" << endl;
+    cout << std::setprecision(2) << "    speedup   " << intervalTime / frustumTime << "x" << endl;
+
+    if(intervalHits != frustumHits) {
+        cout << "    hit counts differ" << endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    string filename = (argc >= 2) ? argv[1] : "nonhier.lua";
+    int repeats = (argc >= 3) ? atoi(argv[2]) : 5;
+
+    if(!captureScene(filename, &s_scene) || s_scene.root == NULL) {
+        cerr << "Could not load a scene from " << filename << endl;
+        return 1;
+    }
+
+    vector<Primitive*> primitives;
+    s_scene.root->getPrimitives(&primitives);
+
+    if(primitives.empty()) {
+        cerr << filename << " has no primitives" << endl;
+        return 1;
+    }
+
+    vector<AABB> boxes;
+    int stride = (primitives.size() + MAX_BOXES - 1) / MAX_BOXES;
+
+    for(unsigned int i = 0; i < primitives.size(); i += stride) {
+        boxes.push_back(*primitives[i]->getWorldBBox());
+    }
+
+    BIHTree bih(&primitives);
+
+    vector<vector<Ray*>*> cameraRays;
+    vector<vector<Ray*>*> shadowRays;
+
+    CullRate cameraRate;
+    CullRate shadowRate;
+
+    int width = s_scene.camera->getWidth();
+    int height = s_scene.camera->getHeight();
+
+    for(int j = 0; j < height; j += PACKET_WIDTH) {
+        for(int i = 0; i < width; i += PACKET_WIDTH) {
+            int w = (width - i < PACKET_WIDTH) ? width - i : PACKET_WIDTH;
+            int h = (height - j < PACKET_WIDTH) ? height - j : PACKET_WIDTH;
+
+            // The camera packet builds its frustum from its corner rays
+            CameraPacket camPacket(w, h, i, j, 1, NULL, NULL);
+            camPacket.genRays(*s_scene.camera);
+
+            Packet packet(camPacket);
+            countCulls(packet, boxes, &cameraRate);
+            cameraRays.push_back(copyRays(*packet.getRays()));
+
+            if(s_scene.lights.empty()) {
+                continue;
+            }
+
+            int n = packet.getRays()->size();
+
+            vector<bool> v_hit(n);
+            vector<Intersection> v_isect(n);
+            bih.getIntersection(packet, v_hit, &v_isect);
+
+            vector<Ray*>* rays = new vector<Ray*>(n);
+
+            for(int k = 0; k < n; ++k) {
+                rays->at(k) = v_hit.at(k) ?
+                    new Ray(s_scene.lights.front()->position, v_isect.at(k).getPoint()) : NULL;
+            }
+
+            Packet shadow;
+            shadow.setRays(copyRays(*rays));
+            countCulls(shadow, boxes, &shadowRate);
+
+            shadowRays.push_back(rays);
+        }
+    }
+
+    report("camera", bih, cameraRays, cameraRate, true, repeats);
+
+    if(!shadowRays.empty()) {
+        report("shadow", bih, shadowRays, shadowRate, false, repeats);
+    }
+
+    deleteRays(cameraRays);
+    deleteRays(shadowRays);
+
+    return 0;
+}
@@ -0,0 +1,13 @@
+# Compares packet frustum culling with the interval test
+#   qmake && make && cd ../data && ../bench/frustum_bench nonhier.lua
+
+QT += widgets
+CONFIG += c++11
+QMAKE_CXXFLAGS += -W -Wall -O2 -pthread
+TEMPLATE = app
+TARGET = frustum_bench
+INCLUDEPATH += . "/usr/include/lua5.1"
+LIBS += -llua5.1
+
+include(../src/core.pri)
+SOURCES += frustum_bench.cpp
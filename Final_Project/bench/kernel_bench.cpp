@@ -0,0 +1,379 @@
+// Times each intersection kernel on its own, away from any scene. Every
+// primitive gets a hit heavy batch of rays aimed inside its bounding box
+// and a miss heavy batch aimed well outside it. Each batch is traced one
+// ray at a time, as packets through Primitive::getIntersection(Packet&),
+// and as packets through the primitive pool the BIH uses, which is where
+// the lane parallel sphere test lives. AABB::intersect and packetTest
+// stand in for the primitive tests in the box row.
+//
+// Usage: kernel_bench [rays] [repeats]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <stdlib.h>
+#include <vector>
+#include <QElapsedTimer>
+
+#include "a4.hpp"
+#include "bbox.hpp"
+#include "mesh.hpp"
+#include "packet.hpp"
+#include "pool.hpp"
+#include "primitive.hpp"
+
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+// Rays that share an origin form one packet
+#define PACKET_RAYS 256
+
+struct Kernel {
+    string name;
+
+    // Exactly one of these is set
+    Primitive* primitive;
+    AABB* box;
+};
+
+struct Result {
+    Result() : hitRate(0.0), scalar(0.0), packet(0.0), pool(0.0) {}
+
+    double hitRate;
+
+    // ns/ray, the fastest of the repeats
+    double scalar;
+    double packet;
+    double pool;
+};
+
+static double random(double min, double max) {
+    return min + (max - min) * (rand() / (double)RAND_MAX);
+}
+
+static Point3D randomPoint(const Point3D& min, const Point3D& max) {
+    return Point3D(random(min[0], max[0]), random(min[1], max[1]), random(min[2], max[2]));
+}
+
+static Vector3D randomDirection() {
+    while(true) {
+        Vector3D v(random(-1.0, 1.0), random(-1.0, 1.0), random(-1.0, 1.0));
+        double length = v.length();
+
+        if(length > 0.1 && length <= 1.0) {
+            return (1.0 / length) * v;
+        }
+    }
+}
+
+/*  makeRays
+ *
+ *  Groups of PACKET_RAYS rays start from a shared point a few box sizes
+ *  away. Hit heavy rays aim at the middle half of the box, and miss
+ *  heavy ones at points several box sizes to the side of it.
+ */
+static vector<vector<Ray*>*> makeRays(const AABB& bbox, int numRays, bool hitHeavy) {
+    Point3D center = bbox.m_min + 0.5 * (bbox.m_max - bbox.m_min);
+    Vector3D half = 0.5 * (bbox.m_max - bbox.m_min);
+    double size = std::max(half.length(), 1.0e-3);
+
+    vector<vector<Ray*>*> packets;
+
+    for(int n = 0; n < numRays; n += PACKET_RAYS) {
+        Point3D origin = center + 4.0 * size * randomDirection();
+        vector<Ray*>* rays = new vector<Ray*>();
+
+        for(int i = 0; i < PACKET_RAYS && n + i < numRays; ++i) {
+            Point3D target;
+
+            if(hitHeavy) {
+                target = randomPoint(center - 0.5 * half, center + 0.5 * half);
+            } else {
+                target = center + random(2.0, 6.0) * size * randomDirection();
+            }
+
+            rays->push_back(new Ray(origin, target - origin));
+        }
+
+        packets.push_back(rays);
+    }
+
+    return packets;
+}
+
+static vector<Ray*>* copyRays(const vector<Ray*>& rays) {
+    vector<Ray*>* copy = new vector<Ray*>();
+
+    for(auto it = rays.begin(); it != rays.end(); ++it) {
+        copy->push_back(new Ray(**it));
+    }
+
+    return copy;
+}
+
+static void deleteRays(const vector<vector<Ray*>*>& packets) {
+    for(auto it = packets.begin(); it != packets.end(); ++it) {
+        for(auto ray = (*it)->begin(); ray != (*it)->end(); ++ray) {
+            delete *ray;
+        }
+
+        delete *it;
+    }
+}
+
+static double timeScalar(const Kernel& kernel, const vector<vector<Ray*>*>& packets, int* hits) {
+    Intersection isect;
+    *hits = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(auto it = packets.begin(); it != packets.end(); ++it) {
+        for(auto ray = (*it)->begin(); ray != (*it)->end(); ++ray) {
+            bool hit;
+
+            if(kernel.box != NULL) {
+                hit = kernel.box->intersect(**ray) || kernel.box->contains(**ray);
+            } else {
+                hit = kernel.primitive->getIntersection(**ray, &isect);
+            }
+
+            if(hit) {
+                ++*hits;
+            }
+        }
+    }
+
+    return timer.nsecsElapsed();
+}
+
+// Packets, masks, lane layouts and hit buffers are made before the timer
+// starts, so only the tests themselves are timed
+static double timePackets(const Kernel& kernel, PrimitivePool* pool,
+        const vector<vector<Ray*>*>& rays)
+{
+    vector<Packet*> packets;
+    vector<LaneRays*> lanes;
+    vector<LaneMask> masks;
+    vector<vector<bool> > hits;
+    vector<vector<Intersection> > isects;
+
+    for(auto it = rays.begin(); it != rays.end(); ++it) {
+        int n = (*it)->size();
+
+        Packet* packet = new Packet();
+        packet->setRays(copyRays(**it));
+        packets.push_back(packet);
+        lanes.push_back(new LaneRays(*packet));
+
+        LaneMask active(n);
+        for(int i = 0; i < n; ++i) {
+            active.set(i);
+        }
+
+        masks.push_back(active);
+        hits.push_back(vector<bool>(n));
+        isects.push_back(vector<Intersection>(n));
+    }
+
+    double enter[MAX_LANES];
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(uint p = 0; p < packets.size(); ++p) {
+        if(kernel.box != NULL) {
+            kernel.box->packetTest(*packets[p], *lanes[p], &masks[p], enter);
+        } else if(pool != NULL) {
+            // Polygons go into the pool as a fan of triangles
+            for(int r = 0; r < pool->getNumRefs(); ++r) {
+                pool->getIntersection(pool->getRef(r), *packets[p], masks[p], hits[p], &isects[p]);
+            }
+        } else {
+            kernel.primitive->getIntersection(*packets[p], masks[p], hits[p], &isects[p]);
+        }
+    }
+
+    double elapsed = timer.nsecsElapsed();
+
+    for(auto it = packets.begin(); it != packets.end(); ++it) {
+        delete *it;
+    }
+
+    for(auto it = lanes.begin(); it != lanes.end(); ++it) {
+        delete *it;
+    }
+
+    return elapsed;
+}
+
+static Result bench(const Kernel& kernel, bool hitHeavy, int numRays, int repeats) {
+    const AABB& bbox = (kernel.box != NULL) ? *kernel.box : *kernel.primitive->getWorldBBox();
+    vector<vector<Ray*>*> rays = makeRays(bbox, numRays, hitHeavy);
+
+    PrimitivePool* pool = NULL;
+    vector<Primitive*> primitives;
+
+    if(kernel.primitive != NULL) {
+        primitives.push_back(kernel.primitive);
+        pool = new PrimitivePool(&primitives);
+    }
+
+    Result result;
+    int hits = 0;
+
+    // Once untimed so every form starts warm
+    timeScalar(kernel, rays, &hits);
+    result.hitRate = hits / (double)numRays;
+
+    for(int r = 0; r < repeats; ++r) {
+        double scalar = timeScalar(kernel, rays, &hits) / numRays;
+        double packet = timePackets(kernel, NULL, rays) / numRays;
+
+        if(r == 0 || scalar < result.scalar) {
+            result.scalar = scalar;
+        }
+        if(r == 0 || packet < result.packet) {
+            result.packet = packet;
+        }
+
+        if(pool != NULL) {
+            double pooled = timePackets(kernel, pool, rays) / numRays;
+
+            if(r == 0 || pooled < result.pool) {
+                result.pool = pooled;
+            }
+        }
+    }
+
+    delete pool;
+    deleteRays(rays);
+
+    return result;
+}
+
+static Matrix4x4 getTransform(const Vector3D& scale, const Vector3D& translate, Matrix4x4* inv) {
+    *inv = Matrix4x4::getScaleMat(Vector3D(1.0/scale[0], 1.0/scale[1], 1.0/scale[2])) *
+        Matrix4x4::getTransMat(-translate);
+
+    return Matrix4x4::getTransMat(translate) * Matrix4x4::getScaleMat(scale);
+}
+
+static vector<Kernel> makeKernels() {
+    vector<Kernel> kernels;
+    Matrix4x4 trans, inv;
+
+    Kernel kernel;
+    kernel.box = NULL;
+
+    kernel.name = "Sphere";
+    kernel.primitive = new Sphere();
+    trans = getTransform(Vector3D(2.0, 2.0, 2.0), Vector3D(1.0, -2.0, 3.0), &inv);
+    kernel.primitive->setTransform(trans, inv);
+    kernels.push_back(kernel);
+
+    kernel.name = "Sphere (scaled)";
+    kernel.primitive = new Sphere();
+    trans = getTransform(Vector3D(3.0, 1.0, 2.0), Vector3D(1.0, -2.0, 3.0), &inv);
+    kernel.primitive->setTransform(trans, inv);
+    kernels.push_back(kernel);
+
+    kernel.name = "Cube";
+    kernel.primitive = new Cube();
+    trans = getTransform(Vector3D(3.0, 1.0, 2.0), Vector3D(1.0, -2.0, 3.0), &inv);
+    kernel.primitive->setTransform(trans, inv);
+    kernels.push_back(kernel);
+
+    kernel.name = "NonhierSphere";
+    kernel.primitive = new NonhierSphere(Point3D(1.0, -2.0, 3.0), 2.0);
+    kernels.push_back(kernel);
+
+    kernel.name = "NonhierBox";
+    kernel.primitive = new NonhierBox(Point3D(1.0, -2.0, 3.0), 2.0);
+    kernels.push_back(kernel);
+
+    vector<Point3D> verts;
+    verts.push_back(Point3D(0.0, 0.0, 0.0));
+    verts.push_back(Point3D(2.0, 0.0, 0.0));
+    verts.push_back(Point3D(2.5, 0.0, 1.5));
+    verts.push_back(Point3D(1.0, 0.0, 2.5));
+    verts.push_back(Point3D(-0.5, 0.0, 1.5));
+
+    int pentagon[] = {0, 1, 2, 3, 4};
+    int triangle[] = {0, 1, 3};
+
+    vector<Point3D> square;
+    square.push_back(Point3D(0.0, 0.0, 0.0));
+    square.push_back(Point3D(0.0, 0.0, 2.0));
+    square.push_back(Point3D(2.0, 0.0, 2.0));
+    square.push_back(Point3D(2.0, 0.0, 0.0));
+
+    int quad[] = {0, 1, 2, 3};
+
+    // Tilted so the polygons aren't parallel to an axis
+    Matrix4x4 tilt = Matrix4x4::getRotMat('x', 30.0) * Matrix4x4::getRotMat('z', 20.0);
+
+    kernel.name = "Polygon";
+    kernel.primitive = new Polygon(verts, vector<int>(pentagon, pentagon + 5), tilt);
+    kernels.push_back(kernel);
+
+    kernel.name = "Triangle";
+    kernel.primitive = new Triangle(verts, vector<int>(triangle, triangle + 3), tilt);
+    kernels.push_back(kernel);
+
+    kernel.name = "Quad";
+    kernel.primitive = new Quad(square, vector<int>(quad, quad + 4), tilt);
+    kernels.push_back(kernel);
+
+    kernel.name = "AABB";
+    kernel.primitive = NULL;
+    kernel.box = new AABB(Point3D(-1.0, -3.0, 2.0), Point3D(3.0, -1.0, 5.0));
+    kernels.push_back(kernel);
+
+    return kernels;
+}
+
+int main(int argc, char** argv) {
+    int numRays = (argc >= 2) ? atoi(argv[1]) : 65536;
+    int repeats = (argc >= 3) ? atoi(argv[2]) : 5;
+
+    srand(488);
+
+    vector<Kernel> kernels = makeKernels();
+
+    cout << numRays << " rays per batch, " << PACKET_RAYS << " per packet, fastest of "
+        << repeats << " runs, ns/ray" << endl << endl;
+
+    cout << std::left << std::setw(18) << "kernel" << std::setw(7) << "rays"
+        << std::right << std::setw(8) << "hits" << std::setw(10) << "scalar"
+        << std::setw(10) << "packet" << std::setw(10) << "pool" << endl;
+
+    cout << std::fixed;
+
+    for(auto it = kernels.begin(); it != kernels.end(); ++it) {
+        for(int hitHeavy = 1; hitHeavy >= 0; --hitHeavy) {
+            Result result = bench(*it, hitHeavy, numRays, repeats);
+
+            cout << std::left << std::setw(18) << it->name << std::setw(7) << (hitHeavy ? "hit" : "miss")
+                << std::right << std::setprecision(0) << std::setw(7) << 100.0 * result.hitRate << "%"
+                << std::setprecision(1) << std::setw(10) << result.scalar
+                << std::setw(10) << result.packet;
+
+            // The box has no pool entry
+            if(it->primitive != NULL) {
+                cout << std::setw(10) << result.pool;
+            } else {
+                cout << std::setw(10) << "-";
+            }
+
+            cout << endl;
+        }
+
+        delete it->primitive;
+        delete it->box;
+    }
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+# Times each intersection kernel on synthetic rays, one ray at a time and
+# as packets
+#   qmake && make && ./kernel_bench
+
+QT += widgets
+CONFIG += c++11
+QMAKE_CXXFLAGS += -W -Wall -O2 -pthread
+TEMPLATE = app
+TARGET = kernel_bench
+INCLUDEPATH += . "/usr/include/lua5.1"
+LIBS += -llua5.1
+
+include(../src/core.pri)
+SOURCES += kernel_bench.cpp
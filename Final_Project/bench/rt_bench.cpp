@@ -0,0 +1,566 @@
+// Renders scenes headlessly at fixed frame sizes and sample widths and
+// reports frame times, primary rays per second, BIH build time and peak
+// RSS. Every scene and setting runs in its own process, so peak RSS and
+// Lua state belong to that run alone.
+//
+// Results go to stdout as tab separated values with a header line, one
+// line per run. Anything the scenes print goes to stderr instead. Saved
+// output can be given to --compare later to flag runs whose median frame
+// time got slower than the threshold allows. With --profile, each run
+// also renders one untimed frame with PROFILE on and prints its counters
+// per phase to stderr.
+//
+// Usage: rt-bench [options] [scene.lua ...]
+//     --sizes 256x256,512x512   frame sizes
+//     --samples 1,2             samples per pixel along each axis
+//     --warmup 1                untimed frames before each run
+//     --repeats 5               timed frames per run
+//     --threads n               worker threads, all cores by default
+//     --compare baseline.tsv    compare with an earlier run
+//     --threshold 0.1           allowed slowdown of the median
+//     --profile                 print hardware counters per render phase
+//
+// Without scenes, every .lua file in the current directory is run. Run
+// it from the data directory so the scene's require calls resolve. Files
+// that render nothing are skipped. The exit status is 1 if any scene
+// failed, or if --compare found a regression or a baseline run missing
+// from this one.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QStringList>
+
+#include "a4.hpp"
+#include "bih.hpp"
+#include "camera.hpp"
+#include "capture.hpp"
+#include "framebuffer.hpp"
+#include "packet.hpp"
+#include "perfcounters.hpp"
+#include "primitive.hpp"
+#include "tracejob.hpp"
+#include "tracer.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::map;
+using std::string;
+using std::vector;
+
+#define HEADER "scene\twidth\theight\tsamples\tpacket\tthreads\tframes\t" \
+    "median_ms\tp95_ms\trays_per_sec\tbih_ms\tpeak_rss_kb"
+
+// Columns that identify a run when comparing with a baseline
+#define KEY_COLUMNS 6
+
+struct Options {
+    Options() : warmup(1), repeats(5), threads(1), threshold(0.1), profile(false) {}
+
+    vector<string> scenes;
+    vector<int> widths;
+    vector<int> heights;
+    vector<int> samples;
+
+    int warmup;
+    int repeats;
+    int threads;
+
+    string baseline;
+    double threshold;
+
+    bool profile;
+};
+
+//*************************** Rendering *****************************
+
+// The scene the script passed to gr.render
+static CapturedScene s_scene;
+
+static double median(vector<double> values) {
+    std::sort(values.begin(), values.end());
+    int n = values.size();
+
+    return (n % 2 == 1) ? values[n/2] : 0.5 * (values[n/2 - 1] + values[n/2]);
+}
+
+// Nearest rank
+static double percentile(vector<double> values, double p) {
+    std::sort(values.begin(), values.end());
+    int rank = (int)ceil(p * values.size());
+
+    return values[std::max(0, rank - 1)];
+}
+
+/*  profileScene
+ *
+ *  Flattens the scene, builds the BIH and renders and resolves one frame
+ *  with PROFILE on, so every phase is counted once, and prints the
+ *  counters to stderr
+ */
+static void profileScene(const string& filename, int width, int height, int sampleWidth,
+        const Options& options)
+{
+    PerfCounters::reset();
+    PROFILE = true;
+
+    vector<Primitive*> primitives;
+    s_scene.root->getPrimitives(&primitives);
+
+    Tracer tracer(&primitives, s_scene.ambient, &s_scene.lights);
+    FrameBuffer frame(width, height);
+
+    vector<CameraPacket*>* packets = CameraPacket::genPackets(&frame, &tracer, *s_scene.camera, sampleWidth);
+    TraceJob::run(packets, options.threads);
+    CameraPacket::deletePackets(packets);
+
+    QImage img(width, height, QImage::Format_RGB32);
+    frame.resolve(&img);
+
+    PROFILE = false;
+
+    cerr << filename << " " << width << "x" << height << " s" << sampleWidth << endl;
+    PerfCounters::report(cerr);
+    cerr << endl;
+
+    for(auto it = primitives.begin(); it != primitives.end(); ++it) {
+        delete *it;
+    }
+}
+
+/*  benchScene
+ *
+ *  Times the scene captured from filename at one frame size and sample
+ *  width, returning the result line, or an empty string if the scene
+ *  doesn't render anything. Meant to run in a process of its own.
+ */
+static string benchScene(const string& filename, int width, int height, int sampleWidth,
+        const Options& options)
+{
+    if(s_scene.root == NULL) {
+        return "";
+    }
+
+    vector<Primitive*>* primitives = new vector<Primitive*>();
+    s_scene.root->getPrimitives(primitives);
+
+    if(primitives->empty()) {
+        return "";
+    }
+
+    BIH = true;
+    PACKETS = true;
+
+    // Every frame traces every ray
+    CACHE = false;
+
+    vector<double> buildTimes;
+
+    for(int r = 0; r < options.repeats; ++r) {
+        QElapsedTimer timer;
+        timer.start();
+
+        BIHTree bih(primitives);
+
+        buildTimes.push_back(timer.nsecsElapsed() / 1.0e6);
+    }
+
+    Tracer tracer(primitives, s_scene.ambient, &s_scene.lights);
+
+    s_scene.camera->updateDimensions(width, height);
+    FrameBuffer frame(width, height);
+
+    vector<CameraPacket*>* packets = CameraPacket::genPackets(&frame, &tracer, *s_scene.camera, sampleWidth);
+
+    for(int r = 0; r < options.warmup; ++r) {
+        TraceJob::run(packets, options.threads);
+    }
+
+    vector<double> frameTimes;
+    long rays = 0;
+
+    for(int r = 0; r < options.repeats; ++r) {
+        QElapsedTimer timer;
+        timer.start();
+
+        rays = TraceJob::run(packets, options.threads);
+
+        frameTimes.push_back(timer.nsecsElapsed() / 1.0e6);
+    }
+
+    CameraPacket::deletePackets(packets);
+
+    if(options.profile) {
+        profileScene(filename, width, height, sampleWidth, options);
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    double medianTime = median(frameTimes);
+
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(3);
+    line << filename << "\t" << width << "\t" << height << "\t" << sampleWidth << "\t"
+        << CameraPacket::getPacketWidth() << "x" << CameraPacket::getPacketHeight() << "\t"
+        << options.threads << "\t" << options.repeats << "\t"
+        << medianTime << "\t" << percentile(frameTimes, 0.95) << "\t"
+        << std::setprecision(0) << rays / (medianTime / 1000.0) << "\t"
+        << std::setprecision(3) << median(buildTimes) << "\t"
+        << usage.ru_maxrss;
+
+    return line.str();
+}
+
+enum RunStatus {
+    runOk,
+    runSkipped,
+    runFailed
+};
+
+// Runs the scene and benchScene in a child process. The run fails if the
+// script does, and is skipped if it renders nothing.
+static RunStatus runChild(const string& filename, int width, int height, int sampleWidth,
+        const Options& options, string* result)
+{
+    int fds[2];
+
+    if(pipe(fds) != 0) {
+        cerr << filename << ": could not make a pipe" << endl;
+        return runFailed;
+    }
+
+    pid_t pid = fork();
+
+    if(pid == 0) {
+        close(fds[0]);
+
+        // Keep what the scene prints out of the results
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+
+        if(!captureScene(filename, &s_scene)) {
+            _exit(1);
+        }
+
+        string line = benchScene(filename, width, height, sampleWidth, options);
+
+        if(!line.empty() && write(fds[1], line.c_str(), line.size()) != (ssize_t)line.size()) {
+            _exit(1);
+        }
+
+        close(fds[1]);
+        _exit(line.empty() ? 2 : 0);
+    }
+
+    close(fds[1]);
+
+    if(pid < 0) {
+        close(fds[0]);
+        cerr << filename << ": could not fork" << endl;
+        return runFailed;
+    }
+
+    result->clear();
+    char buffer[256];
+    ssize_t n;
+
+    while((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+        result->append(buffer, n);
+    }
+
+    close(fds[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+
+    if(WIFSIGNALED(status)) {
+        cerr << filename << ": killed by signal " << WTERMSIG(status) << endl;
+        return runFailed;
+    }
+
+    if(WEXITSTATUS(status) == 2) {
+        cerr << filename << ": no scene to render, skipped" << endl;
+        return runSkipped;
+    }
+
+    if(WEXITSTATUS(status) != 0) {
+        cerr << filename << ": failed with status " << WEXITSTATUS(status) << endl;
+        return runFailed;
+    }
+
+    return runOk;
+}
+
+//*************************** Comparison *****************************
+
+static vector<string> split(const string& text, char delimiter) {
+    vector<string> fields;
+    std::istringstream stream(text);
+    string field;
+
+    while(std::getline(stream, field, delimiter)) {
+        fields.push_back(field);
+    }
+
+    return fields;
+}
+
+static string getKey(const vector<string>& fields) {
+    string key;
+
+    for(int i = 0; i < KEY_COLUMNS && i < (int)fields.size(); ++i) {
+        key += fields[i] + "\t";
+    }
+
+    return key;
+}
+
+// The median frame times of a saved run, by key
+static bool readBaseline(const string& filename, map<string, double>* baseline) {
+    std::ifstream file(filename.c_str());
+
+    if(!file) {
+        return false;
+    }
+
+    string line;
+
+    while(std::getline(file, line)) {
+        vector<string> fields = split(line, '\t');
+
+        if(fields.size() < KEY_COLUMNS + 2 || fields[0] == "scene") {
+            continue;
+        }
+
+        (*baseline)[getKey(fields)] = atof(fields[KEY_COLUMNS + 1].c_str());
+    }
+
+    return true;
+}
+
+// Prints each result next to its baseline and returns the number of
+// regressions. A baseline run with no result here counts as one, since a
+// scene that stopped rendering is worse than a slow one.
+static int compare(const vector<string>& results, const map<string, double>& baseline,
+        double threshold)
+{
+    int regressions = 0;
+    std::set<string> seen;
+
+    cerr << std::fixed << std::setprecision(1);
+
+    for(auto it = results.begin(); it != results.end(); ++it) {
+        vector<string> fields = split(*it, '\t');
+        auto base = baseline.find(getKey(fields));
+
+        seen.insert(getKey(fields));
+
+        string name = fields[0] + " " + fields[1] + "x" + fields[2] + " s" + fields[3];
+
+        if(base == baseline.end() || base->second <= 0.0) {
+            cerr << name << ": no baseline" << endl;
+            continue;
+        }
+
+        double time = atof(fields[KEY_COLUMNS + 1].c_str());
+        double change = time / base->second - 1.0;
+
+        cerr << name << ": " << time << " ms vs " << base->second << " ms ("
+            << (change >= 0.0 ? "+" : "") << 100.0 * change << "%)";
+
+        if(change > threshold) {
+            cerr << " REGRESSION";
+            ++regressions;
+        }
+
+        cerr << endl;
+    }
+
+    for(auto it = baseline.begin(); it != baseline.end(); ++it) {
+        if(seen.count(it->first) == 0) {
+            vector<string> fields = split(it->first, '\t');
+
+            cerr << fields[0] << " " << fields[1] << "x" << fields[2] << " s" << fields[3]
+                << ": missing from this run REGRESSION" << endl;
+            ++regressions;
+        }
+    }
+
+    return regressions;
+}
+
+//*************************** Options *****************************
+
+static bool parseList(const string& text, vector<int>* values) {
+    vector<string> fields = split(text, ',');
+
+    for(auto it = fields.begin(); it != fields.end(); ++it) {
+        int value = atoi(it->c_str());
+
+        if(value <= 0) {
+            return false;
+        }
+
+        values->push_back(value);
+    }
+
+    return !values->empty();
+}
+
+static bool parseSizes(const string& text, vector<int>* widths, vector<int>* heights) {
+    vector<string> fields = split(text, ',');
+
+    for(auto it = fields.begin(); it != fields.end(); ++it) {
+        int width, height;
+
+        if(sscanf(it->c_str(), "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+            return false;
+        }
+
+        widths->push_back(width);
+        heights->push_back(height);
+    }
+
+    return !widths->empty();
+}
+
+static bool parseOptions(int argc, char** argv, Options* options) {
+    options->threads = std::max(1, (int)sysconf(_SC_NPROCESSORS_ONLN));
+
+    for(int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+
+        if(arg.compare(0, 2, "--") != 0) {
+            options->scenes.push_back(arg);
+            continue;
+        }
+
+        if(arg == "--profile") {
+            options->profile = true;
+            continue;
+        }
+
+        if(i + 1 >= argc) {
+            cerr << arg << " needs a value" << endl;
+            return false;
+        }
+
+        string value = argv[++i];
+        bool ok = true;
+
+        if(arg == "--sizes") {
+            ok = parseSizes(value, &options->widths, &options->heights);
+        } else if(arg == "--samples") {
+            ok = parseList(value, &options->samples);
+        } else if(arg == "--warmup") {
+            options->warmup = atoi(value.c_str());
+            ok = options->warmup >= 0;
+        } else if(arg == "--repeats") {
+            options->repeats = atoi(value.c_str());
+            ok = options->repeats > 0;
+        } else if(arg == "--threads") {
+            options->threads = atoi(value.c_str());
+            ok = options->threads > 0;
+        } else if(arg == "--compare") {
+            options->baseline = value;
+        } else if(arg == "--threshold") {
+            options->threshold = atof(value.c_str());
+        } else {
+            cerr << "Unknown option " << arg << endl;
+            return false;
+        }
+
+        if(!ok) {
+            cerr << "Bad value for " << arg << ": " << value << endl;
+            return false;
+        }
+    }
+
+    if(options->widths.empty()) {
+        parseSizes("256x256,512x512", &options->widths, &options->heights);
+    }
+    if(options->samples.empty()) {
+        parseList("1,2", &options->samples);
+    }
+
+    if(options->scenes.empty()) {
+        QStringList files = QDir(".").entryList(QStringList("*.lua"), QDir::Files, QDir::Name);
+
+        for(auto it = files.begin(); it != files.end(); ++it) {
+            options->scenes.push_back(it->toStdString());
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+
+    if(!parseOptions(argc, argv, &options)) {
+        return 2;
+    }
+
+    map<string, double> baseline;
+
+    if(!options.baseline.empty() && !readBaseline(options.baseline, &baseline)) {
+        cerr << "Could not read " << options.baseline << endl;
+        return 2;
+    }
+
+    vector<string> results;
+    cout << HEADER << endl;
+
+    int failures = 0;
+
+    for(auto scene = options.scenes.begin(); scene != options.scenes.end(); ++scene) {
+        RunStatus status = runOk;
+
+        for(unsigned int s = 0; s < options.widths.size() && status == runOk; ++s) {
+            for(auto samples = options.samples.begin(); samples != options.samples.end(); ++samples) {
+                string line;
+
+                // A scene that fails or is skipped once is at every setting
+                status = runChild(*scene, options.widths[s], options.heights[s], *samples, options, &line);
+
+                if(status != runOk) {
+                    break;
+                }
+
+                cout << line << endl;
+                results.push_back(line);
+            }
+        }
+
+        if(status == runFailed) {
+            ++failures;
+        }
+    }
+
+    bool ok = failures == 0;
+
+    if(!ok) {
+        cerr << failures << " of " << options.scenes.size() << " scenes failed" << endl;
+    }
+
+    if(!options.baseline.empty() && compare(results, baseline, options.threshold) > 0) {
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
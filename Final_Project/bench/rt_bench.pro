@@ -0,0 +1,14 @@
+# Headless render benchmark over the scenes in data
+#   qmake && make && cd ../data && ../bench/rt-bench > baseline.tsv
+#   ../bench/rt-bench --compare baseline.tsv
+
+QT += widgets
+CONFIG += c++11
+QMAKE_CXXFLAGS += -W -Wall -O2 -pthread
+TEMPLATE = app
+TARGET = rt-bench
+INCLUDEPATH += . "/usr/include/lua5.1"
+LIBS += -llua5.1 -pthread
+
+include(../src/core.pri)
+SOURCES += rt_bench.cpp
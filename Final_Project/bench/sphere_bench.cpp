@@ -0,0 +1,167 @@
+// Times the sphere intersection tests of a scene. Every sphere is tested
+// against every camera ray and against a shadow ray from each camera hit
+// to the first light, once through the model space transform and once
+// with the closed form world space test.
+//
+// Usage: sphere_bench [scene.lua] [repeats]
+// Run it from the data directory so the scene's require calls resolve.
+
+#include <iostream>
+#include <iomanip>
+#include <stdlib.h>
+#include <vector>
+#include <QElapsedTimer>
+
+#include "a4.hpp"
+#include "camera.hpp"
+#include "capture.hpp"
+#include "primitive.hpp"
+#include "pool.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+// The scene the script passed to gr.render
+static CapturedScene s_scene;
+
+struct Timing {
+    double nsPerTest;
+    int hits;
+};
+
+static Timing timeSpheres(const vector<Primitive*>& spheres, const vector<Ray*>& rays,
+        bool closedForm, int repeats)
+{
+    FAST_SPHERES = closedForm;
+
+    Intersection isect;
+    int hits = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(int r = 0; r < repeats; ++r) {
+        for(auto ray = rays.begin(); ray != rays.end(); ++ray) {
+            for(auto sphere = spheres.begin(); sphere != spheres.end(); ++sphere) {
+                if((*sphere)->getIntersection(**ray, &isect)) {
+                    ++hits;
+                }
+            }
+        }
+    }
+
+    Timing timing;
+    timing.nsPerTest = (double)timer.nsecsElapsed() / ((double)repeats * rays.size() * spheres.size());
+    timing.hits = hits / repeats;
+
+    return timing;
+}
+
+static void report(const string& name, const vector<Primitive*>& spheres, const vector<Ray*>& rays,
+        int repeats)
+{
+    // Once untimed so both runs start warm
+    timeSpheres(spheres, rays, false, 1);
+
+    Timing model = timeSpheres(spheres, rays, false, repeats);
+    Timing closed = timeSpheres(spheres, rays, true, repeats);
+
+    cout << std::fixed << std::setprecision(1);
+    cout << name << ": " << rays.size() << " rays x " << spheres.size() << " spheres" << endl;
+    cout << "    model space  " << model.nsPerTest << " ns/test, " << model.hits << " hits" << endl;
+    cout << "    closed form  " << closed.nsPerTest << " ns/test, " << closed.hits << " hits" << endl;
+    cout << std::setprecision(2) << "    speedup      " << model.nsPerTest / closed.nsPerTest << "x" << endl;
+
+    if(model.hits != closed.hits) {
+        cout << "    hit counts differ" << endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    string filename = (argc >= 2) ? argv[1] : "nonhier.lua";
+    int repeats = (argc >= 3) ? atoi(argv[2]) : 5;
+
+    if(!captureScene(filename, &s_scene) || s_scene.root == NULL) {
+        cerr << "Could not load a scene from " << filename << endl;
+        return 1;
+    }
+
+    vector<Primitive*> primitives;
+    s_scene.root->getPrimitives(&primitives);
+
+    vector<Primitive*> spheres;
+    int uniform = 0;
+
+    for(auto it = primitives.begin(); it != primitives.end(); ++it) {
+        if(dynamic_cast<Sphere*>(*it) != NULL || dynamic_cast<NonhierSphere*>(*it) != NULL) {
+            spheres.push_back(*it);
+        }
+    }
+
+    if(spheres.empty()) {
+        cerr << filename << " has no spheres" << endl;
+        return 1;
+    }
+
+    vector<Ray*> primary;
+    vector<Ray*> shadow;
+
+    FAST_SPHERES = true;
+
+    for(int j = 0; j < s_scene.camera->getHeight(); ++j) {
+        for(int i = 0; i < s_scene.camera->getWidth(); ++i) {
+            Ray* ray = s_scene.camera->getRay(i, j);
+            primary.push_back(ray);
+
+            Intersection best;
+            bool hit = false;
+
+            for(auto it = primitives.begin(); it != primitives.end(); ++it) {
+                Intersection isect;
+
+                if((*it)->getIntersection(*ray, &isect) &&
+                        (!hit || isect.getParam() < best.getParam()))
+                {
+                    best = isect;
+                    hit = true;
+                }
+            }
+
+            if(hit && !s_scene.lights.empty()) {
+                shadow.push_back(new Ray(best.getPoint(), s_scene.lights.front()->position, 1.0e-6));
+            }
+        }
+    }
+
+    // Spheres that aren't uniformly scaled take the model space path either way
+    PrimitivePool pool(&spheres);
+
+    for(int i = 0; i < pool.getNumRefs(); ++i) {
+        if(PrimitivePool::getType(pool.getRef(i)) == PrimitivePool::worldSphere) {
+            ++uniform;
+        }
+    }
+
+    cout << uniform << " of " << spheres.size() << " spheres are uniformly scaled" << endl;
+
+    report("primary", spheres, primary, repeats);
+
+    if(!shadow.empty()) {
+        report("shadow", spheres, shadow, repeats);
+    }
+
+    for(auto it = primary.begin(); it != primary.end(); ++it) {
+        delete *it;
+    }
+    for(auto it = shadow.begin(); it != shadow.end(); ++it) {
+        delete *it;
+    }
+    for(auto it = primitives.begin(); it != primitives.end(); ++it) {
+        delete *it;
+    }
+
+    return 0;
+}
@@ -0,0 +1,13 @@
+# Times the closed form sphere test against the model space one
+#   qmake && make && cd ../data && ../bench/sphere_bench nonhier.lua
+
+QT += widgets
+CONFIG += c++11
+QMAKE_CXXFLAGS += -W -Wall -O2 -pthread
+TEMPLATE = app
+TARGET = sphere_bench
+INCLUDEPATH += . "/usr/include/lua5.1"
+LIBS += -llua5.1
+
+include(../src/core.pri)
+SOURCES += sphere_bench.cpp
@@ -2,11 +2,6 @@
 -- spheres, they're cow-shaped polyhedral models.
 
 
--- We'll need an extra function that knows how to read Wavefront .OBJ
--- files.
-
-require('readobj')
-
 stone = gr.material({0.8, 0.7, 0.7}, {0.0, 0.0, 0.0}, 0)
 grass = gr.material({0.1, 0.7, 0.1}, {0.0, 0.0, 0.0}, 0)
 hide = gr.material({0.84, 0.6, 0.53}, {0.3, 0.3, 0.3}, 20)
@@ -44,7 +39,7 @@ s:scale(4, 0.6, 0.6)
 -- Read in the cow model from a separate file.
 -- #############################################
 
-cow_poly = gr.mesh('cow', readobj('cow.obj'))
+cow_poly = gr.obj_mesh('cow', 'cow.obj')
 factor = 2.0/(2.76+3.637)
 
 cow_poly:set_material(hide)
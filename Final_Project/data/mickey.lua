@@ -1,1450 +1,1450 @@
 -- A famous mouse, in the [0,1] cube
 -- M 483, 962, 0
-mickey = gr.mesh('mickey', {
-    { 0.23001, 0.53649, 0.39257},
-    { 0.228364, 0.545937, 0.344078},
-    { 0.224063, 0.503523, 0.355114},
-    { 0.239543, 0.583646, 0.373812},
-    { 0.245711, 0.559729, 0.432709},
-    { 0.231702, 0.479161, 0.411218},
-    { 0.240087, 0.585948, 0.328784},
-    { 0.228722, 0.458233, 0.374879},
-    { 0.226976, 0.500499, 0.309491},
-    { 0.239, 0.497945, 0.263851},
-    { 0.227272, 0.466416, 0.326612},
-    { 0.242678, 0.513619, 0.445231},
-    { 0.255115, 0.604955, 0.411406},
-    { 0.23531, 0.548961, 0.290836},
-    { 0.2542, 0.618871, 0.360825},
-    { 0.27814, 0.64859, 0.39673},
-    { 0.258576, 0.534928, 0.470984},
-    { 0.235237, 0.427482, 0.362091},
-    { 0.262267, 0.628469, 0.312989},
-    { 0.251733, 0.586418, 0.274479},
-    { 0.269783, 0.584568, 0.468755},
-    { 0.250162, 0.551021, 0.250844},
-    { 0.245135, 0.421155, 0.413761},
-    { 0.239269, 0.45183, 0.27589},
-    { 0.277103, 0.549795, 0.496315},
-    { 0.250111, 0.389705, 0.3706},
-    { 0.239153, 0.417143, 0.324276},
-    { 0.252583, 0.455754, 0.459728},
-    { 0.280092, 0.658314, 0.355453},
-    { 0.281448, 0.632409, 0.440179},
-    { 0.258016, 0.515803, 0.224628},
-    { 0.270247, 0.372874, 0.422825},
-    { 0.273166, 0.405859, 0.467473},
-    { 0.266666, 0.499645, 0.489943},
-    { 0.314087, 0.689486, 0.389711},
-    { 0.279174, 0.636565, 0.27245},
-    { 0.271032, 0.594754, 0.237877},
-    { 0.280136, 0.347806, 0.394706},
-    { 0.269864, 0.356229, 0.349729},
-    { 0.289957, 0.66675, 0.31901},
-    { 0.298661, 0.586556, 0.505789},
-    { 0.283073, 0.519035, 0.187308},
-    { 0.259367, 0.37474, 0.319505},
-    { 0.255361, 0.407084, 0.27043},
-    { 0.2856, 0.449662, 0.507728},
-    { 0.276867, 0.570956, 0.212556},
-    { 0.289788, 0.508511, 0.51988},
-    { 0.316316, 0.552429, 0.537617},
-    { 0.265073, 0.423176, 0.236295},
-    { 0.264235, 0.463874, 0.217343},
-    { 0.307858, 0.63352, 0.482876},
-    { 0.311985, 0.621036, 0.20055},
-    { 0.330806, 0.599822, 0.530022},
-    { 0.330408, 0.494858, 0.55631},
-    { 0.279714, 0.390873, 0.236996},
-    { 0.345657, 0.715351, 0.341458},
-    { 0.307543, 0.667842, 0.432455},
-    { 0.298344, 0.642523, 0.242993},
-    { 0.297186, 0.32297, 0.359797},
-    { 0.288071, 0.335619, 0.316192},
-    { 0.290387, 0.403538, 0.209543},
-    { 0.318625, 0.450241, 0.541053},
-    { 0.3151, 0.692859, 0.331698},
-    { 0.314954, 0.574336, 0.170678},
-    { 0.284997, 0.356719, 0.267572},
-    { 0.347284, 0.700453, 0.431697},
-    { 0.312664, 0.677433, 0.27664},
-    { 0.33894, 0.671938, 0.472093},
-    { 0.316321, 0.518112, 0.154923},
-    { 0.30643, 0.358797, 0.472124},
-    { 0.295863, 0.449613, 0.180225},
-    { 0.341006, 0.704095, 0.290433},
-    { 0.361304, 0.649662, 0.518385},
-    { 0.315331, 0.312605, 0.398484},
-    { 0.316364, 0.324859, 0.435889},
-    { 0.366222, 0.722998, 0.390681},
-    { 0.353285, 0.557226, 0.56259},
-    { 0.336592, 0.290876, 0.358159},
-    { 0.315114, 0.401789, 0.517294},
-    { 0.359993, 0.565873, 0.136211},
-    { 0.372226, 0.593426, 0.559606},
-    { 0.325483, 0.299969, 0.324087},
-    { 0.344017, 0.300373, 0.425298},
-    { 0.377924, 0.513549, 0.581726},
-    { 0.395583, 0.738445, 0.356263},
-    { 0.392217, 0.724175, 0.427361},
-    { 0.338026, 0.671466, 0.22729},
-    { 0.355477, 0.514996, 0.129336},
-    { 0.354155, 0.284042, 0.391433},
-    { 0.314884, 0.316941, 0.289049},
-    { 0.339174, 0.320638, 0.460939},
-    { 0.381952, 0.729927, 0.311472},
-    { 0.36046, 0.702675, 0.25635},
-    { 0.37469, 0.694313, 0.474478},
-    { 0.401818, 0.607717, 0.134639},
-    { 0.336186, 0.354039, 0.500121},
-    { 0.318125, 0.355894, 0.215593},
-    { 0.33124, 0.400741, 0.16861},
-    { 0.372667, 0.450036, 0.574756},
-    { 0.413981, 0.738679, 0.396298},
-    { 0.407929, 0.54662, 0.111415},
-    { 0.418565, 0.557947, 0.588799},
-    { 0.348822, 0.399717, 0.543077},
-    { 0.340932, 0.457831, 0.140869},
-    { 0.347318, 0.65027, 0.195172},
-    { 0.360752, 0.609701, 0.154177},
-    { 0.376861, 0.269049, 0.352653},
-    { 0.333543, 0.318173, 0.249676},
-    { 0.367966, 0.291209, 0.439815},
-    { 0.371486, 0.319295, 0.49047},
-    { 0.438347, 0.748594, 0.356094},
-    { 0.388253, 0.721011, 0.269017},
-    { 0.419344, 0.715811, 0.466004},
-    { 0.413984, 0.677571, 0.517988},
-    { 0.372789, 0.68271, 0.211161},
-    { 0.388799, 0.657325, 0.173743},
-    { 0.405639, 0.617871, 0.562263},
-    { 0.392296, 0.267109, 0.394036},
-    { 0.360152, 0.280061, 0.310637},
-    { 0.378291, 0.354134, 0.531263},
-    { 0.417944, 0.492618, 0.595116},
-    { 0.48601, 0.74981, 0.378428},
-    { 0.446593, 0.739992, 0.419608},
-    { 0.422524, 0.740849, 0.299144},
-    { 0.425632, 0.253465, 0.352597},
-    { 0.416081, 0.271513, 0.436264},
-    { 0.344566, 0.300526, 0.272447},
-    { 0.361661, 0.423737, 0.139885},
-    { 0.460214, 0.446437, 0.595725},
-    { 0.472086, 0.749606, 0.318822},
-    { 0.394299, 0.709123, 0.238321},
-    { 0.421064, 0.697464, 0.203553},
-    { 0.458453, 0.605725, 0.577206},
-    { 0.46953, 0.561224, 0.593419},
-    { 0.474437, 0.515703, 0.601642},
-    { 0.427363, 0.258064, 0.396183},
-    { 0.403157, 0.269372, 0.280742},
-    { 0.361672, 0.320513, 0.216365},
-    { 0.354494, 0.352659, 0.18579},
-    { 0.383922, 0.400936, 0.561806},
-    { 0.411819, 0.432206, 0.583892},
-    { 0.390699, 0.488925, 0.11331},
-    { 0.458398, 0.702192, 0.498624},
-    { 0.458439, 0.655846, 0.54726},
-    { 0.445861, 0.600065, 0.120861},
-    { 0.40185, 0.261627, 0.323221},
-    { 0.377578, 0.289644, 0.253052},
-    { 0.440574, 0.508803, 0.101451},
-    { 0.458498, 0.724323, 0.461314},
-    { 0.427745, 0.724893, 0.248227},
-    { 0.43719, 0.654342, 0.154453},
-    { 0.463984, 0.556062, 0.105249},
-    { 0.407727, 0.2951, 0.479176},
-    { 0.41729, 0.328146, 0.524416},
-    { 0.532385, 0.738047, 0.406953},
-    { 0.519882, 0.747277, 0.346324},
-    { 0.490798, 0.740229, 0.420969},
-    { 0.478503, 0.720913, 0.469192},
-    { 0.491767, 0.600768, 0.598182},
-    { 0.525508, 0.555266, 0.590078},
-    { 0.474386, 0.250369, 0.380141},
-    { 0.449552, 0.254395, 0.302407},
-    { 0.394194, 0.37888, 0.144144},
-    { 0.422031, 0.376502, 0.562491},
-    { 0.40379, 0.442221, 0.11536},
-    { 0.442961, 0.457549, 0.104274},
-    { 0.489922, 0.595214, 0.58163},
-    { 0.474975, 0.249416, 0.340804},
-    { 0.471239, 0.259649, 0.423285},
-    { 0.458216, 0.279579, 0.469541},
-    { 0.401406, 0.327684, 0.182012},
-    { 0.495301, 0.467464, 0.598261},
-    { 0.484426, 0.504188, 0.098611},
-    { 0.563172, 0.734575, 0.367908},
-    { 0.480132, 0.736435, 0.263274},
-    { 0.458441, 0.747731, 0.466775},
-    { 0.491774, 0.600006, 0.628279},
-    { 0.50135, 0.579632, 0.112674},
-    { 0.562454, 0.532691, 0.582747},
-    { 0.521371, 0.253702, 0.371534},
-    { 0.440684, 0.274448, 0.243495},
-    { 0.458444, 0.348394, 0.549805},
-    { 0.458416, 0.396562, 0.578123},
-    { 0.486886, 0.436987, 0.105596},
-    { 0.528262, 0.504055, 0.595471},
-    { 0.574712, 0.724278, 0.402111},
-    { 0.52267, 0.740087, 0.293026},
-    { 0.516342, 0.724059, 0.455139},
-    { 0.491767, 0.722492, 0.46302},
-    { 0.45844, 0.870114, 0.523996},
-    { 0.479167, 0.686437, 0.180199},
-    { 0.486223, 0.633489, 0.136989},
-    { 0.458365, 0.598482, 0.629532},
-    { 0.528172, 0.608885, 0.570431},
-    { 0.518533, 0.53994, 0.105535},
-    { 0.504737, 0.260916, 0.41992},
-    { 0.395957, 0.300647, 0.218997},
-    { 0.458444, 0.307698, 0.511152},
-    { 0.438455, 0.392415, 0.124796},
-    { 0.609069, 0.71141, 0.371275},
-    { 0.553482, 0.736749, 0.323118},
-    { 0.54578, 0.72233, 0.255569},
-    { 0.561129, 0.716664, 0.443825},
-    { 0.491779, 0.704982, 0.494865},
-    { 0.491764, 0.752969, 0.465184},
-    { 0.458324, 0.785729, 0.469819},
-    { 0.469815, 0.715009, 0.22086},
-    { 0.492204, 0.624126, 0.566972},
-    { 0.502843, 0.251609, 0.324234},
-    { 0.44428, 0.301038, 0.199287},
-    { 0.572749, 0.49758, 0.581397},
-    { 0.536746, 0.70197, 0.486071},
-    { 0.491776, 0.856862, 0.509502},
-    { 0.458442, 0.612076, 0.678516},
-    { 0.564621, 0.5788, 0.127445},
-    { 0.568587, 0.504325, 0.115198},
-    { 0.556374, 0.262447, 0.341904},
-    { 0.54169, 0.267852, 0.419876},
-    { 0.505174, 0.274776, 0.456732},
-    { 0.458438, 0.273982, 0.766291},
-    { 0.442379, 0.341179, 0.157603},
-    { 0.532209, 0.422581, 0.583118},
-    { 0.542596, 0.462563, 0.588811},
-    { 0.610265, 0.70035, 0.418464},
-    { 0.512667, 0.715921, 0.227117},
-    { 0.491758, 0.667668, 0.536382},
-    { 0.531744, 0.610663, 0.13206},
-    { 0.527979, 0.64756, 0.546212},
-    { 0.564877, 0.576628, 0.571495},
-    { 0.575663, 0.271178, 0.379161},
-    { 0.491584, 0.280185, 0.468702},
-    { 0.49178, 0.24851, 0.465657},
-    { 0.458494, 0.253937, 0.466278},
-    { 0.491067, 0.399347, 0.579861},
-    { 0.530802, 0.489991, 0.105518},
-    { 0.590901, 0.722155, 0.334588},
-    { 0.583499, 0.691663, 0.471269},
-    { 0.533665, 0.68018, 0.18478},
-    { 0.518771, 0.647006, 0.151158},
-    { 0.581673, 0.624831, 0.54086},
-    { 0.602169, 0.544202, 0.562812},
-    { 0.53689, 0.261273, 0.301221},
-    { 0.486449, 0.261564, 0.270435},
-    { 0.489492, 0.288301, 0.214484},
-    { 0.49188, 0.400253, 0.608043},
-    { 0.458439, 0.400249, 0.633862},
-    { 0.57676, 0.723764, 0.298833},
-    { 0.491773, 0.812476, 0.479008},
-    { 0.458411, 0.826743, 0.48682},
-    { 0.572404, 0.637599, 0.162819},
-    { 0.458405, 0.635157, 0.713988},
-    { 0.491772, 0.611085, 0.675079},
-    { 0.617054, 0.491189, 0.558091},
-    { 0.610776, 0.288712, 0.337738},
-    { 0.588868, 0.280466, 0.303421},
-    { 0.585872, 0.289924, 0.43295},
-    { 0.519823, 0.270535, 0.258605},
-    { 0.491842, 0.295571, 0.496998},
-    { 0.458439, 0.217646, 0.469351},
-    { 0.491303, 0.330567, 0.164265},
-    { 0.458515, 0.364761, 0.715001},
-    { 0.491752, 0.378289, 0.569611},
-    { 0.554947, 0.44109, 0.118356},
-    { 0.611475, 0.449035, 0.143927},
-    { 0.633469, 0.694477, 0.348131},
-    { 0.616404, 0.704214, 0.312727},
-    { 0.544103, 0.674433, 0.518554},
-    { 0.491794, 0.887909, 0.555411},
-    { 0.458441, 0.900476, 0.609523},
-    { 0.567001, 0.689173, 0.211087},
-    { 0.493159, 0.633595, 0.71356},
-    { 0.555515, 0.29705, 0.475167},
-    { 0.493538, 0.376916, 0.131592},
-    { 0.491773, 0.310725, 0.754939},
-    { 0.491776, 0.396982, 0.65031},
-    { 0.457946, 0.388673, 0.675637},
-    { 0.581835, 0.452817, 0.572094},
-    { 0.644182, 0.681498, 0.389266},
-    { 0.594848, 0.704269, 0.266292},
-    { 0.458471, 0.893708, 0.571293},
-    { 0.60653, 0.588627, 0.544934},
-    { 0.602085, 0.548089, 0.139239},
-    { 0.62092, 0.299594, 0.391805},
-    { 0.491772, 0.346217, 0.548329},
-    { 0.491821, 0.198368, 0.474703},
-    { 0.458304, 0.165751, 0.491354},
-    { 0.524007, 0.289481, 0.222398},
-    { 0.537246, 0.35738, 0.15246},
-    { 0.54097, 0.402679, 0.127606},
-    { 0.65681, 0.673378, 0.33865},
-    { 0.614082, 0.67712, 0.462203},
-    { 0.459152, 0.663471, 0.740782},
-    { 0.652728, 0.525086, 0.526541},
-    { 0.458444, 0.0992124, 0.618159},
-    { 0.538778, 0.315767, 0.191381},
-    { 0.552305, 0.36602, 0.549416},
-    { 0.615302, 0.437869, 0.549143},
-    { 0.612023, 0.508561, 0.139627},
-    { 0.649616, 0.664862, 0.42515},
-    { 0.618676, 0.672651, 0.237489},
-    { 0.615081, 0.624388, 0.182267},
-    { 0.491772, 0.669934, 0.744922},
-    { 0.612257, 0.584985, 0.157599},
-    { 0.638251, 0.499103, 0.158927},
-    { 0.633395, 0.557689, 0.163877},
-    { 0.562639, 0.284406, 0.254939},
-    { 0.533109, 0.322022, 0.518255},
-    { 0.491738, 0.155643, 0.497692},
-    { 0.491819, 0.379345, 0.694875},
-    { 0.676292, 0.64789, 0.377793},
-    { 0.662783, 0.619365, 0.470539},
-    { 0.608538, 0.653539, 0.497938},
-    { 0.616608, 0.657398, 0.215009},
-    { 0.595942, 0.65865, 0.198701},
-    { 0.638933, 0.569748, 0.526729},
-    { 0.593602, 0.331062, 0.49542},
-    { 0.581378, 0.313573, 0.218476},
-    { 0.575047, 0.34756, 0.177265},
-    { 0.587595, 0.389419, 0.154062},
-    { 0.581849, 0.415777, 0.561169},
-    { 0.670101, 0.456857, 0.507164},
-    { 0.585061, 0.65436, 0.212058},
-    { 0.630606, 0.612138, 0.512133},
-    { 0.658364, 0.565153, 0.507729},
-    { 0.677475, 0.53304, 0.495303},
-    { 0.644842, 0.315096, 0.347224},
-    { 0.618264, 0.313118, 0.437081},
-    { 0.615508, 0.384681, 0.52472},
-    { 0.687808, 0.632638, 0.327751},
-    { 0.491587, 0.898884, 0.641181},
-    { 0.458435, 0.857408, 0.722473},
-    { 0.607055, 0.611903, 0.190207},
-    { 0.626855, 0.500549, 0.169962},
-    { 0.62074, 0.560394, 0.176084},
-    { 0.652338, 0.328575, 0.397205},
-    { 0.605103, 0.302126, 0.265973},
-    { 0.458442, 0.122655, 0.696725},
-    { 0.458305, 0.326187, 0.747578},
-    { 0.682262, 0.628565, 0.409391},
-    { 0.655151, 0.64093, 0.246161},
-    { 0.491784, 0.767265, 0.767509},
-    { 0.458431, 0.748423, 0.767434},
-    { 0.616684, 0.647663, 0.234907},
-    { 0.45844, 0.700608, 0.759029},
-    { 0.49178, 0.717264, 0.76439},
-    { 0.655002, 0.599357, 0.493521},
-    { 0.653252, 0.527862, 0.19966},
-    { 0.648248, 0.549271, 0.482832},
-    { 0.627343, 0.347146, 0.478431},
-    { 0.458441, 0.129939, 0.525232},
-    { 0.49168, 0.34887, 0.731054},
-    { 0.491774, 0.101491, 0.591289},
-    { 0.654285, 0.417584, 0.504966},
-    { 0.699509, 0.61168, 0.364598},
-    { 0.670973, 0.646188, 0.292824},
-    { 0.640892, 0.677122, 0.282906},
-    { 0.675229, 0.619991, 0.442274},
-    { 0.642052, 0.56552, 0.46762},
-    { 0.643896, 0.580952, 0.485447},
-    { 0.648932, 0.549497, 0.450997},
-    { 0.670007, 0.344582, 0.377887},
-    { 0.640454, 0.317137, 0.30079},
-    { 0.650809, 0.345054, 0.440618},
-    { 0.599708, 0.343492, 0.199544},
-    { 0.62501, 0.408478, 0.171218},
-    { 0.621365, 0.438361, 0.175672},
-    { 0.652572, 0.466246, 0.200251},
-    { 0.644202, 0.583625, 0.209481},
-    { 0.642583, 0.593781, 0.463344},
-    { 0.66105, 0.558699, 0.191816},
-    { 0.665197, 0.530473, 0.466501},
-    { 0.678457, 0.533422, 0.436642},
-    { 0.673594, 0.346889, 0.334085},
-    { 0.491782, 0.120697, 0.537871},
-    { 0.458217, 0.106784, 0.566009},
-    { 0.623748, 0.339516, 0.227312},
-    { 0.612994, 0.372677, 0.183799},
-    { 0.689234, 0.477199, 0.47899},
-    { 0.666356, 0.489028, 0.186831},
-    { 0.705748, 0.578425, 0.416259},
-    { 0.691763, 0.60227, 0.421365},
-    { 0.686107, 0.607634, 0.264285},
-    { 0.664017, 0.594173, 0.426225},
-    { 0.652872, 0.602372, 0.448819},
-    { 0.646995, 0.615578, 0.205775},
-    { 0.664389, 0.583371, 0.466244},
-    { 0.673246, 0.560844, 0.455565},
-    { 0.683549, 0.521141, 0.210802},
-    { 0.695439, 0.385266, 0.386349},
-    { 0.663819, 0.346355, 0.28888},
-    { 0.643047, 0.33794, 0.256304},
-    { 0.458346, 0.105846, 0.65929},
-    { 0.598758, 0.347744, 0.22333},
-    { 0.693883, 0.522098, 0.470422},
-    { 0.713906, 0.576148, 0.36099},
-    { 0.491685, 0.821005, 0.750352},
-    { 0.492059, 0.899945, 0.600279},
-    { 0.458288, 0.896677, 0.652644},
-    { 0.68052, 0.572445, 0.224676},
-    { 0.662, 0.552137, 0.42997},
-    { 0.691281, 0.373132, 0.353911},
-    { 0.672906, 0.360069, 0.415266},
-    { 0.656301, 0.384856, 0.481122},
-    { 0.620986, 0.359512, 0.232491},
-    { 0.599787, 0.372878, 0.197167},
-    { 0.64837, 0.448944, 0.485236},
-    { 0.704525, 0.528343, 0.447709},
-    { 0.675305, 0.588078, 0.440559},
-    { 0.491774, 0.863061, 0.717109},
-    { 0.458462, 0.881646, 0.68974},
-    { 0.458444, 0.79363, 0.760604},
-    { 0.671097, 0.569188, 0.425025},
-    { 0.683158, 0.563574, 0.41539},
-    { 0.675964, 0.381469, 0.441716},
-    { 0.491761, 0.238455, 0.766934},
-    { 0.638777, 0.399011, 0.214306},
-    { 0.662376, 0.468052, 0.468039},
-    { 0.648486, 0.451132, 0.45513},
-    { 0.72154, 0.499887, 0.401392},
-    { 0.720142, 0.538512, 0.387674},
-    { 0.708636, 0.586581, 0.314227},
-    { 0.458442, 0.821598, 0.748557},
-    { 0.709283, 0.550774, 0.423338},
-    { 0.642044, 0.374281, 0.210782},
-    { 0.638523, 0.421663, 0.471661},
-    { 0.658512, 0.425515, 0.195384},
-    { 0.662306, 0.425147, 0.466819},
-    { 0.676612, 0.469903, 0.441977},
-    { 0.708213, 0.511904, 0.255606},
-    { 0.721068, 0.541793, 0.317241},
-    { 0.491778, 0.886404, 0.680697},
-    { 0.704755, 0.554901, 0.263506},
-    { 0.710127, 0.411504, 0.347971},
-    { 0.690751, 0.396075, 0.423813},
-    { 0.652263, 0.394729, 0.451724},
-    { 0.667559, 0.393391, 0.227882},
-    { 0.491776, 0.27384, 0.765048},
-    { 0.663051, 0.446106, 0.428671},
-    { 0.677917, 0.435617, 0.450924},
-    { 0.703524, 0.473639, 0.452259},
-    { 0.713861, 0.434124, 0.393094},
-    { 0.691695, 0.380691, 0.303831},
-    { 0.677934, 0.380513, 0.263875},
-    { 0.670914, 0.409087, 0.447312},
-    { 0.670211, 0.411754, 0.418041},
-    { 0.458352, 0.223757, 0.765453},
-    { 0.687589, 0.454132, 0.222475},
-    { 0.683344, 0.443795, 0.418519},
-    { 0.741704, 0.545679, 0.368093},
-    { 0.748258, 0.517408, 0.397906},
-    { 0.720101, 0.551916, 0.350545},
-    { 0.694593, 0.423615, 0.254704},
-    { 0.748649, 0.545458, 0.339746},
-    { 0.719913, 0.451382, 0.36702},
-    { 0.703447, 0.420662, 0.416188},
-    { 0.491927, 0.100616, 0.637116},
-    { 0.45856, 0.146192, 0.726165},
-    { 0.458448, 0.180829, 0.750919},
-    { 0.709882, 0.455525, 0.425052},
-    { 0.711804, 0.463635, 0.274587},
-    { 0.720351, 0.50092, 0.297373},
-    { 0.760675, 0.533926, 0.365004},
-    { 0.720939, 0.449636, 0.344773},
-    { 0.491703, 0.113294, 0.682464},
-    { 0.491842, 0.191941, 0.756066},
-    { 0.719363, 0.471415, 0.397278},
-    { 0.772313, 0.511741, 0.367551},
-    { 0.770748, 0.524917, 0.343102},
-    { 0.743304, 0.535635, 0.318985},
-    { 0.709518, 0.425652, 0.299093},
-    { 0.491776, 0.146286, 0.727477},
-    { 0.759485, 0.485256, 0.387345},
-    { 0.776239, 0.494151, 0.341646},
-    { 0.737775, 0.518004, 0.301776},
-    { 0.743256, 0.450985, 0.353375},
-    { 0.749532, 0.461039, 0.375031},
-    { 0.773252, 0.483614, 0.363289},
-    { 0.76561, 0.512484, 0.317968},
-    { 0.720119, 0.464462, 0.311182},
-    { 0.741127, 0.456439, 0.326752},
-    { 0.747126, 0.484853, 0.304586},
-    { 0.763873, 0.466142, 0.342098},
-    { 0.764983, 0.480091, 0.323423},
+mickey = gr.flat_mesh('mickey', {
+    0.23001, 0.53649, 0.39257,
+    0.228364, 0.545937, 0.344078,
+    0.224063, 0.503523, 0.355114,
+    0.239543, 0.583646, 0.373812,
+    0.245711, 0.559729, 0.432709,
+    0.231702, 0.479161, 0.411218,
+    0.240087, 0.585948, 0.328784,
+    0.228722, 0.458233, 0.374879,
+    0.226976, 0.500499, 0.309491,
+    0.239, 0.497945, 0.263851,
+    0.227272, 0.466416, 0.326612,
+    0.242678, 0.513619, 0.445231,
+    0.255115, 0.604955, 0.411406,
+    0.23531, 0.548961, 0.290836,
+    0.2542, 0.618871, 0.360825,
+    0.27814, 0.64859, 0.39673,
+    0.258576, 0.534928, 0.470984,
+    0.235237, 0.427482, 0.362091,
+    0.262267, 0.628469, 0.312989,
+    0.251733, 0.586418, 0.274479,
+    0.269783, 0.584568, 0.468755,
+    0.250162, 0.551021, 0.250844,
+    0.245135, 0.421155, 0.413761,
+    0.239269, 0.45183, 0.27589,
+    0.277103, 0.549795, 0.496315,
+    0.250111, 0.389705, 0.3706,
+    0.239153, 0.417143, 0.324276,
+    0.252583, 0.455754, 0.459728,
+    0.280092, 0.658314, 0.355453,
+    0.281448, 0.632409, 0.440179,
+    0.258016, 0.515803, 0.224628,
+    0.270247, 0.372874, 0.422825,
+    0.273166, 0.405859, 0.467473,
+    0.266666, 0.499645, 0.489943,
+    0.314087, 0.689486, 0.389711,
+    0.279174, 0.636565, 0.27245,
+    0.271032, 0.594754, 0.237877,
+    0.280136, 0.347806, 0.394706,
+    0.269864, 0.356229, 0.349729,
+    0.289957, 0.66675, 0.31901,
+    0.298661, 0.586556, 0.505789,
+    0.283073, 0.519035, 0.187308,
+    0.259367, 0.37474, 0.319505,
+    0.255361, 0.407084, 0.27043,
+    0.2856, 0.449662, 0.507728,
+    0.276867, 0.570956, 0.212556,
+    0.289788, 0.508511, 0.51988,
+    0.316316, 0.552429, 0.537617,
+    0.265073, 0.423176, 0.236295,
+    0.264235, 0.463874, 0.217343,
+    0.307858, 0.63352, 0.482876,
+    0.311985, 0.621036, 0.20055,
+    0.330806, 0.599822, 0.530022,
+    0.330408, 0.494858, 0.55631,
+    0.279714, 0.390873, 0.236996,
+    0.345657, 0.715351, 0.341458,
+    0.307543, 0.667842, 0.432455,
+    0.298344, 0.642523, 0.242993,
+    0.297186, 0.32297, 0.359797,
+    0.288071, 0.335619, 0.316192,
+    0.290387, 0.403538, 0.209543,
+    0.318625, 0.450241, 0.541053,
+    0.3151, 0.692859, 0.331698,
+    0.314954, 0.574336, 0.170678,
+    0.284997, 0.356719, 0.267572,
+    0.347284, 0.700453, 0.431697,
+    0.312664, 0.677433, 0.27664,
+    0.33894, 0.671938, 0.472093,
+    0.316321, 0.518112, 0.154923,
+    0.30643, 0.358797, 0.472124,
+    0.295863, 0.449613, 0.180225,
+    0.341006, 0.704095, 0.290433,
+    0.361304, 0.649662, 0.518385,
+    0.315331, 0.312605, 0.398484,
+    0.316364, 0.324859, 0.435889,
+    0.366222, 0.722998, 0.390681,
+    0.353285, 0.557226, 0.56259,
+    0.336592, 0.290876, 0.358159,
+    0.315114, 0.401789, 0.517294,
+    0.359993, 0.565873, 0.136211,
+    0.372226, 0.593426, 0.559606,
+    0.325483, 0.299969, 0.324087,
+    0.344017, 0.300373, 0.425298,
+    0.377924, 0.513549, 0.581726,
+    0.395583, 0.738445, 0.356263,
+    0.392217, 0.724175, 0.427361,
+    0.338026, 0.671466, 0.22729,
+    0.355477, 0.514996, 0.129336,
+    0.354155, 0.284042, 0.391433,
+    0.314884, 0.316941, 0.289049,
+    0.339174, 0.320638, 0.460939,
+    0.381952, 0.729927, 0.311472,
+    0.36046, 0.702675, 0.25635,
+    0.37469, 0.694313, 0.474478,
+    0.401818, 0.607717, 0.134639,
+    0.336186, 0.354039, 0.500121,
+    0.318125, 0.355894, 0.215593,
+    0.33124, 0.400741, 0.16861,
+    0.372667, 0.450036, 0.574756,
+    0.413981, 0.738679, 0.396298,
+    0.407929, 0.54662, 0.111415,
+    0.418565, 0.557947, 0.588799,
+    0.348822, 0.399717, 0.543077,
+    0.340932, 0.457831, 0.140869,
+    0.347318, 0.65027, 0.195172,
+    0.360752, 0.609701, 0.154177,
+    0.376861, 0.269049, 0.352653,
+    0.333543, 0.318173, 0.249676,
+    0.367966, 0.291209, 0.439815,
+    0.371486, 0.319295, 0.49047,
+    0.438347, 0.748594, 0.356094,
+    0.388253, 0.721011, 0.269017,
+    0.419344, 0.715811, 0.466004,
+    0.413984, 0.677571, 0.517988,
+    0.372789, 0.68271, 0.211161,
+    0.388799, 0.657325, 0.173743,
+    0.405639, 0.617871, 0.562263,
+    0.392296, 0.267109, 0.394036,
+    0.360152, 0.280061, 0.310637,
+    0.378291, 0.354134, 0.531263,
+    0.417944, 0.492618, 0.595116,
+    0.48601, 0.74981, 0.378428,
+    0.446593, 0.739992, 0.419608,
+    0.422524, 0.740849, 0.299144,
+    0.425632, 0.253465, 0.352597,
+    0.416081, 0.271513, 0.436264,
+    0.344566, 0.300526, 0.272447,
+    0.361661, 0.423737, 0.139885,
+    0.460214, 0.446437, 0.595725,
+    0.472086, 0.749606, 0.318822,
+    0.394299, 0.709123, 0.238321,
+    0.421064, 0.697464, 0.203553,
+    0.458453, 0.605725, 0.577206,
+    0.46953, 0.561224, 0.593419,
+    0.474437, 0.515703, 0.601642,
+    0.427363, 0.258064, 0.396183,
+    0.403157, 0.269372, 0.280742,
+    0.361672, 0.320513, 0.216365,
+    0.354494, 0.352659, 0.18579,
+    0.383922, 0.400936, 0.561806,
+    0.411819, 0.432206, 0.583892,
+    0.390699, 0.488925, 0.11331,
+    0.458398, 0.702192, 0.498624,
+    0.458439, 0.655846, 0.54726,
+    0.445861, 0.600065, 0.120861,
+    0.40185, 0.261627, 0.323221,
+    0.377578, 0.289644, 0.253052,
+    0.440574, 0.508803, 0.101451,
+    0.458498, 0.724323, 0.461314,
+    0.427745, 0.724893, 0.248227,
+    0.43719, 0.654342, 0.154453,
+    0.463984, 0.556062, 0.105249,
+    0.407727, 0.2951, 0.479176,
+    0.41729, 0.328146, 0.524416,
+    0.532385, 0.738047, 0.406953,
+    0.519882, 0.747277, 0.346324,
+    0.490798, 0.740229, 0.420969,
+    0.478503, 0.720913, 0.469192,
+    0.491767, 0.600768, 0.598182,
+    0.525508, 0.555266, 0.590078,
+    0.474386, 0.250369, 0.380141,
+    0.449552, 0.254395, 0.302407,
+    0.394194, 0.37888, 0.144144,
+    0.422031, 0.376502, 0.562491,
+    0.40379, 0.442221, 0.11536,
+    0.442961, 0.457549, 0.104274,
+    0.489922, 0.595214, 0.58163,
+    0.474975, 0.249416, 0.340804,
+    0.471239, 0.259649, 0.423285,
+    0.458216, 0.279579, 0.469541,
+    0.401406, 0.327684, 0.182012,
+    0.495301, 0.467464, 0.598261,
+    0.484426, 0.504188, 0.098611,
+    0.563172, 0.734575, 0.367908,
+    0.480132, 0.736435, 0.263274,
+    0.458441, 0.747731, 0.466775,
+    0.491774, 0.600006, 0.628279,
+    0.50135, 0.579632, 0.112674,
+    0.562454, 0.532691, 0.582747,
+    0.521371, 0.253702, 0.371534,
+    0.440684, 0.274448, 0.243495,
+    0.458444, 0.348394, 0.549805,
+    0.458416, 0.396562, 0.578123,
+    0.486886, 0.436987, 0.105596,
+    0.528262, 0.504055, 0.595471,
+    0.574712, 0.724278, 0.402111,
+    0.52267, 0.740087, 0.293026,
+    0.516342, 0.724059, 0.455139,
+    0.491767, 0.722492, 0.46302,
+    0.45844, 0.870114, 0.523996,
+    0.479167, 0.686437, 0.180199,
+    0.486223, 0.633489, 0.136989,
+    0.458365, 0.598482, 0.629532,
+    0.528172, 0.608885, 0.570431,
+    0.518533, 0.53994, 0.105535,
+    0.504737, 0.260916, 0.41992,
+    0.395957, 0.300647, 0.218997,
+    0.458444, 0.307698, 0.511152,
+    0.438455, 0.392415, 0.124796,
+    0.609069, 0.71141, 0.371275,
+    0.553482, 0.736749, 0.323118,
+    0.54578, 0.72233, 0.255569,
+    0.561129, 0.716664, 0.443825,
+    0.491779, 0.704982, 0.494865,
+    0.491764, 0.752969, 0.465184,
+    0.458324, 0.785729, 0.469819,
+    0.469815, 0.715009, 0.22086,
+    0.492204, 0.624126, 0.566972,
+    0.502843, 0.251609, 0.324234,
+    0.44428, 0.301038, 0.199287,
+    0.572749, 0.49758, 0.581397,
+    0.536746, 0.70197, 0.486071,
+    0.491776, 0.856862, 0.509502,
+    0.458442, 0.612076, 0.678516,
+    0.564621, 0.5788, 0.127445,
+    0.568587, 0.504325, 0.115198,
+    0.556374, 0.262447, 0.341904,
+    0.54169, 0.267852, 0.419876,
+    0.505174, 0.274776, 0.456732,
+    0.458438, 0.273982, 0.766291,
+    0.442379, 0.341179, 0.157603,
+    0.532209, 0.422581, 0.583118,
+    0.542596, 0.462563, 0.588811,
+    0.610265, 0.70035, 0.418464,
+    0.512667, 0.715921, 0.227117,
+    0.491758, 0.667668, 0.536382,
+    0.531744, 0.610663, 0.13206,
+    0.527979, 0.64756, 0.546212,
+    0.564877, 0.576628, 0.571495,
+    0.575663, 0.271178, 0.379161,
+    0.491584, 0.280185, 0.468702,
+    0.49178, 0.24851, 0.465657,
+    0.458494, 0.253937, 0.466278,
+    0.491067, 0.399347, 0.579861,
+    0.530802, 0.489991, 0.105518,
+    0.590901, 0.722155, 0.334588,
+    0.583499, 0.691663, 0.471269,
+    0.533665, 0.68018, 0.18478,
+    0.518771, 0.647006, 0.151158,
+    0.581673, 0.624831, 0.54086,
+    0.602169, 0.544202, 0.562812,
+    0.53689, 0.261273, 0.301221,
+    0.486449, 0.261564, 0.270435,
+    0.489492, 0.288301, 0.214484,
+    0.49188, 0.400253, 0.608043,
+    0.458439, 0.400249, 0.633862,
+    0.57676, 0.723764, 0.298833,
+    0.491773, 0.812476, 0.479008,
+    0.458411, 0.826743, 0.48682,
+    0.572404, 0.637599, 0.162819,
+    0.458405, 0.635157, 0.713988,
+    0.491772, 0.611085, 0.675079,
+    0.617054, 0.491189, 0.558091,
+    0.610776, 0.288712, 0.337738,
+    0.588868, 0.280466, 0.303421,
+    0.585872, 0.289924, 0.43295,
+    0.519823, 0.270535, 0.258605,
+    0.491842, 0.295571, 0.496998,
+    0.458439, 0.217646, 0.469351,
+    0.491303, 0.330567, 0.164265,
+    0.458515, 0.364761, 0.715001,
+    0.491752, 0.378289, 0.569611,
+    0.554947, 0.44109, 0.118356,
+    0.611475, 0.449035, 0.143927,
+    0.633469, 0.694477, 0.348131,
+    0.616404, 0.704214, 0.312727,
+    0.544103, 0.674433, 0.518554,
+    0.491794, 0.887909, 0.555411,
+    0.458441, 0.900476, 0.609523,
+    0.567001, 0.689173, 0.211087,
+    0.493159, 0.633595, 0.71356,
+    0.555515, 0.29705, 0.475167,
+    0.493538, 0.376916, 0.131592,
+    0.491773, 0.310725, 0.754939,
+    0.491776, 0.396982, 0.65031,
+    0.457946, 0.388673, 0.675637,
+    0.581835, 0.452817, 0.572094,
+    0.644182, 0.681498, 0.389266,
+    0.594848, 0.704269, 0.266292,
+    0.458471, 0.893708, 0.571293,
+    0.60653, 0.588627, 0.544934,
+    0.602085, 0.548089, 0.139239,
+    0.62092, 0.299594, 0.391805,
+    0.491772, 0.346217, 0.548329,
+    0.491821, 0.198368, 0.474703,
+    0.458304, 0.165751, 0.491354,
+    0.524007, 0.289481, 0.222398,
+    0.537246, 0.35738, 0.15246,
+    0.54097, 0.402679, 0.127606,
+    0.65681, 0.673378, 0.33865,
+    0.614082, 0.67712, 0.462203,
+    0.459152, 0.663471, 0.740782,
+    0.652728, 0.525086, 0.526541,
+    0.458444, 0.0992124, 0.618159,
+    0.538778, 0.315767, 0.191381,
+    0.552305, 0.36602, 0.549416,
+    0.615302, 0.437869, 0.549143,
+    0.612023, 0.508561, 0.139627,
+    0.649616, 0.664862, 0.42515,
+    0.618676, 0.672651, 0.237489,
+    0.615081, 0.624388, 0.182267,
+    0.491772, 0.669934, 0.744922,
+    0.612257, 0.584985, 0.157599,
+    0.638251, 0.499103, 0.158927,
+    0.633395, 0.557689, 0.163877,
+    0.562639, 0.284406, 0.254939,
+    0.533109, 0.322022, 0.518255,
+    0.491738, 0.155643, 0.497692,
+    0.491819, 0.379345, 0.694875,
+    0.676292, 0.64789, 0.377793,
+    0.662783, 0.619365, 0.470539,
+    0.608538, 0.653539, 0.497938,
+    0.616608, 0.657398, 0.215009,
+    0.595942, 0.65865, 0.198701,
+    0.638933, 0.569748, 0.526729,
+    0.593602, 0.331062, 0.49542,
+    0.581378, 0.313573, 0.218476,
+    0.575047, 0.34756, 0.177265,
+    0.587595, 0.389419, 0.154062,
+    0.581849, 0.415777, 0.561169,
+    0.670101, 0.456857, 0.507164,
+    0.585061, 0.65436, 0.212058,
+    0.630606, 0.612138, 0.512133,
+    0.658364, 0.565153, 0.507729,
+    0.677475, 0.53304, 0.495303,
+    0.644842, 0.315096, 0.347224,
+    0.618264, 0.313118, 0.437081,
+    0.615508, 0.384681, 0.52472,
+    0.687808, 0.632638, 0.327751,
+    0.491587, 0.898884, 0.641181,
+    0.458435, 0.857408, 0.722473,
+    0.607055, 0.611903, 0.190207,
+    0.626855, 0.500549, 0.169962,
+    0.62074, 0.560394, 0.176084,
+    0.652338, 0.328575, 0.397205,
+    0.605103, 0.302126, 0.265973,
+    0.458442, 0.122655, 0.696725,
+    0.458305, 0.326187, 0.747578,
+    0.682262, 0.628565, 0.409391,
+    0.655151, 0.64093, 0.246161,
+    0.491784, 0.767265, 0.767509,
+    0.458431, 0.748423, 0.767434,
+    0.616684, 0.647663, 0.234907,
+    0.45844, 0.700608, 0.759029,
+    0.49178, 0.717264, 0.76439,
+    0.655002, 0.599357, 0.493521,
+    0.653252, 0.527862, 0.19966,
+    0.648248, 0.549271, 0.482832,
+    0.627343, 0.347146, 0.478431,
+    0.458441, 0.129939, 0.525232,
+    0.49168, 0.34887, 0.731054,
+    0.491774, 0.101491, 0.591289,
+    0.654285, 0.417584, 0.504966,
+    0.699509, 0.61168, 0.364598,
+    0.670973, 0.646188, 0.292824,
+    0.640892, 0.677122, 0.282906,
+    0.675229, 0.619991, 0.442274,
+    0.642052, 0.56552, 0.46762,
+    0.643896, 0.580952, 0.485447,
+    0.648932, 0.549497, 0.450997,
+    0.670007, 0.344582, 0.377887,
+    0.640454, 0.317137, 0.30079,
+    0.650809, 0.345054, 0.440618,
+    0.599708, 0.343492, 0.199544,
+    0.62501, 0.408478, 0.171218,
+    0.621365, 0.438361, 0.175672,
+    0.652572, 0.466246, 0.200251,
+    0.644202, 0.583625, 0.209481,
+    0.642583, 0.593781, 0.463344,
+    0.66105, 0.558699, 0.191816,
+    0.665197, 0.530473, 0.466501,
+    0.678457, 0.533422, 0.436642,
+    0.673594, 0.346889, 0.334085,
+    0.491782, 0.120697, 0.537871,
+    0.458217, 0.106784, 0.566009,
+    0.623748, 0.339516, 0.227312,
+    0.612994, 0.372677, 0.183799,
+    0.689234, 0.477199, 0.47899,
+    0.666356, 0.489028, 0.186831,
+    0.705748, 0.578425, 0.416259,
+    0.691763, 0.60227, 0.421365,
+    0.686107, 0.607634, 0.264285,
+    0.664017, 0.594173, 0.426225,
+    0.652872, 0.602372, 0.448819,
+    0.646995, 0.615578, 0.205775,
+    0.664389, 0.583371, 0.466244,
+    0.673246, 0.560844, 0.455565,
+    0.683549, 0.521141, 0.210802,
+    0.695439, 0.385266, 0.386349,
+    0.663819, 0.346355, 0.28888,
+    0.643047, 0.33794, 0.256304,
+    0.458346, 0.105846, 0.65929,
+    0.598758, 0.347744, 0.22333,
+    0.693883, 0.522098, 0.470422,
+    0.713906, 0.576148, 0.36099,
+    0.491685, 0.821005, 0.750352,
+    0.492059, 0.899945, 0.600279,
+    0.458288, 0.896677, 0.652644,
+    0.68052, 0.572445, 0.224676,
+    0.662, 0.552137, 0.42997,
+    0.691281, 0.373132, 0.353911,
+    0.672906, 0.360069, 0.415266,
+    0.656301, 0.384856, 0.481122,
+    0.620986, 0.359512, 0.232491,
+    0.599787, 0.372878, 0.197167,
+    0.64837, 0.448944, 0.485236,
+    0.704525, 0.528343, 0.447709,
+    0.675305, 0.588078, 0.440559,
+    0.491774, 0.863061, 0.717109,
+    0.458462, 0.881646, 0.68974,
+    0.458444, 0.79363, 0.760604,
+    0.671097, 0.569188, 0.425025,
+    0.683158, 0.563574, 0.41539,
+    0.675964, 0.381469, 0.441716,
+    0.491761, 0.238455, 0.766934,
+    0.638777, 0.399011, 0.214306,
+    0.662376, 0.468052, 0.468039,
+    0.648486, 0.451132, 0.45513,
+    0.72154, 0.499887, 0.401392,
+    0.720142, 0.538512, 0.387674,
+    0.708636, 0.586581, 0.314227,
+    0.458442, 0.821598, 0.748557,
+    0.709283, 0.550774, 0.423338,
+    0.642044, 0.374281, 0.210782,
+    0.638523, 0.421663, 0.471661,
+    0.658512, 0.425515, 0.195384,
+    0.662306, 0.425147, 0.466819,
+    0.676612, 0.469903, 0.441977,
+    0.708213, 0.511904, 0.255606,
+    0.721068, 0.541793, 0.317241,
+    0.491778, 0.886404, 0.680697,
+    0.704755, 0.554901, 0.263506,
+    0.710127, 0.411504, 0.347971,
+    0.690751, 0.396075, 0.423813,
+    0.652263, 0.394729, 0.451724,
+    0.667559, 0.393391, 0.227882,
+    0.491776, 0.27384, 0.765048,
+    0.663051, 0.446106, 0.428671,
+    0.677917, 0.435617, 0.450924,
+    0.703524, 0.473639, 0.452259,
+    0.713861, 0.434124, 0.393094,
+    0.691695, 0.380691, 0.303831,
+    0.677934, 0.380513, 0.263875,
+    0.670914, 0.409087, 0.447312,
+    0.670211, 0.411754, 0.418041,
+    0.458352, 0.223757, 0.765453,
+    0.687589, 0.454132, 0.222475,
+    0.683344, 0.443795, 0.418519,
+    0.741704, 0.545679, 0.368093,
+    0.748258, 0.517408, 0.397906,
+    0.720101, 0.551916, 0.350545,
+    0.694593, 0.423615, 0.254704,
+    0.748649, 0.545458, 0.339746,
+    0.719913, 0.451382, 0.36702,
+    0.703447, 0.420662, 0.416188,
+    0.491927, 0.100616, 0.637116,
+    0.45856, 0.146192, 0.726165,
+    0.458448, 0.180829, 0.750919,
+    0.709882, 0.455525, 0.425052,
+    0.711804, 0.463635, 0.274587,
+    0.720351, 0.50092, 0.297373,
+    0.760675, 0.533926, 0.365004,
+    0.720939, 0.449636, 0.344773,
+    0.491703, 0.113294, 0.682464,
+    0.491842, 0.191941, 0.756066,
+    0.719363, 0.471415, 0.397278,
+    0.772313, 0.511741, 0.367551,
+    0.770748, 0.524917, 0.343102,
+    0.743304, 0.535635, 0.318985,
+    0.709518, 0.425652, 0.299093,
+    0.491776, 0.146286, 0.727477,
+    0.759485, 0.485256, 0.387345,
+    0.776239, 0.494151, 0.341646,
+    0.737775, 0.518004, 0.301776,
+    0.743256, 0.450985, 0.353375,
+    0.749532, 0.461039, 0.375031,
+    0.773252, 0.483614, 0.363289,
+    0.76561, 0.512484, 0.317968,
+    0.720119, 0.464462, 0.311182,
+    0.741127, 0.456439, 0.326752,
+    0.747126, 0.484853, 0.304586,
+    0.763873, 0.466142, 0.342098,
+    0.764983, 0.480091, 0.323423,
  }, {
-    { 1, 2, 0},
-    { 3, 0, 4},
-    { 2, 7, 5},
-    { 2, 1, 8},
-    { 10, 7, 2},
-    { 0, 5, 11},
-    { 0, 11, 4},
-    { 4, 12, 3},
-    { 6, 13, 1},
-    { 18, 6, 14},
-    { 4, 11, 16},
-    { 19, 13, 6},
-    { 21, 9, 13},
-    { 7, 10, 17},
-    { 10, 8, 23},
-    { 4, 20, 12},
-    { 13, 19, 21},
-    { 20, 4, 16},
-    { 7, 17, 22},
-    { 10, 26, 17},
-    { 5, 27, 11},
-    { 28, 14, 15},
-    { 19, 6, 18},
-    { 9, 21, 30},
-    { 27, 5, 22},
-    { 11, 27, 33},
-    { 15, 34, 28},
-    { 29, 12, 20},
-    { 19, 18, 35},
-    { 19, 36, 21},
-    { 37, 25, 38},
-    { 17, 26, 25},
-    { 24, 20, 16},
-    { 26, 10, 23},
-    { 26, 23, 43},
-    { 18, 28, 39},
-    { 47, 24, 46},
-    { 26, 43, 42},
-    { 24, 33, 46},
-    { 47, 52, 40},
-    { 24, 47, 40},
-    { 47, 46, 53},
-    { 42, 25, 26},
-    { 23, 9, 49},
-    { 19, 35, 36},
-    { 50, 29, 20},
-    { 40, 50, 20},
-    { 58, 37, 38},
-    { 48, 23, 49},
-    { 44, 61, 46},
-    { 55, 62, 34},
-    { 15, 56, 34},
-    { 41, 45, 63},
-    { 30, 41, 49},
-    { 29, 50, 56},
-    { 50, 67, 56},
-    { 35, 66, 57},
-    { 49, 41, 70},
-    { 62, 66, 39},
-    { 39, 66, 35},
-    { 38, 59, 58},
-    { 31, 69, 32},
-    { 46, 61, 53},
-    { 70, 41, 68},
-    { 34, 75, 55},
-    { 71, 62, 55},
-    { 56, 67, 65},
-    { 68, 41, 63},
-    { 76, 52, 47},
-    { 47, 53, 76},
-    { 58, 73, 37},
-    { 64, 43, 54},
-    { 63, 45, 51},
-    { 53, 83, 76},
-    { 75, 84, 55},
-    { 68, 79, 87},
-    { 90, 69, 74},
-    { 69, 31, 74},
-    { 31, 37, 74},
-    { 44, 32, 78},
-    { 84, 91, 55},
-    { 68, 63, 79},
-    { 61, 44, 78},
-    { 85, 65, 93},
-    { 72, 93, 67},
-    { 80, 52, 76},
-    { 102, 61, 78},
-    { 98, 83, 53},
-    { 91, 71, 55},
-    { 63, 51, 105},
-    { 73, 88, 82},
-    { 96, 54, 60},
-    { 70, 103, 97},
-    { 110, 84, 99},
-    { 111, 92, 71},
-    { 85, 93, 112},
-    { 114, 104, 86},
-    { 104, 51, 86},
-    { 77, 106, 88},
-    { 77, 81, 118},
-    { 54, 96, 64},
-    { 95, 90, 109},
-    { 102, 98, 61},
-    { 87, 103, 68},
-    { 101, 83, 120},
-    { 122, 121, 110},
-    { 122, 110, 99},
-    { 111, 91, 123},
-    { 111, 71, 91},
-    { 106, 124, 117},
-    { 64, 107, 89},
-    { 108, 109, 90},
-    { 103, 70, 68},
-    { 129, 110, 121},
-    { 130, 92, 111},
-    { 72, 113, 93},
-    { 114, 115, 104},
-    { 101, 120, 134},
-    { 118, 106, 77},
-    { 89, 107, 126},
-    { 120, 83, 98},
-    { 84, 123, 91},
-    { 85, 112, 122},
-    { 142, 112, 113},
-    { 115, 94, 105},
-    { 72, 116, 113},
-    { 106, 145, 124},
-    { 137, 146, 107},
-    { 120, 128, 134},
-    { 112, 148, 122},
-    { 111, 149, 130},
-    { 133, 132, 101},
-    { 117, 124, 135},
-    { 106, 118, 145},
-    { 118, 126, 146},
-    { 126, 107, 146},
-    { 139, 102, 119},
-    { 139, 140, 98},
-    { 98, 140, 120},
-    { 100, 147, 141},
-    { 156, 121, 122},
-    { 123, 149, 111},
-    { 149, 131, 130},
-    { 114, 92, 130},
-    { 150, 115, 131},
-    { 150, 94, 115},
-    { 143, 116, 132},
-    { 100, 144, 151},
-    { 135, 124, 160},
-    { 118, 136, 145},
-    { 146, 136, 118},
-    { 127, 162, 97},
-    { 141, 147, 165},
-    { 142, 148, 112},
-    { 131, 114, 130},
-    { 166, 132, 133},
-    { 134, 159, 133},
-    { 152, 109, 108},
-    { 109, 152, 153},
-    { 163, 139, 119},
-    { 103, 141, 164},
-    { 165, 164, 141},
-    { 134, 128, 171},
-    { 151, 172, 147},
-    { 151, 147, 100},
-    { 154, 173, 155},
-    { 174, 123, 129},
-    { 142, 175, 148},
-    { 159, 166, 133},
-    { 167, 160, 124},
-    { 135, 160, 168},
-    { 124, 145, 161},
-    { 125, 169, 152},
-    { 170, 137, 138},
-    { 127, 164, 162},
-    { 134, 184, 159},
-    { 178, 159, 184},
-    { 186, 129, 155},
-    { 142, 113, 143},
-    { 144, 94, 150},
-    { 159, 193, 166},
-    { 177, 194, 151},
-    { 195, 160, 179},
-    { 135, 168, 125},
-    { 169, 125, 168},
-    { 180, 136, 146},
-    { 162, 170, 138},
-    { 139, 163, 140},
-    { 172, 151, 194},
-    { 173, 200, 155},
-    { 129, 186, 174},
-    { 154, 187, 202},
-    { 188, 203, 187},
-    { 156, 188, 187},
-    { 191, 150, 190},
-    { 170, 196, 137},
-    { 178, 184, 210},
-    { 185, 199, 173},
-    { 154, 185, 173},
-    { 186, 155, 200},
-    { 187, 203, 211},
-    { 205, 204, 175},
-    { 131, 206, 190},
-    { 191, 144, 150},
-    { 144, 177, 151},
-    { 177, 214, 194},
-    { 217, 195, 179},
-    { 160, 195, 168},
-    { 196, 170, 209},
-    { 197, 181, 153},
-    { 220, 170, 162},
-    { 128, 221, 171},
-    { 222, 184, 171},
-    { 185, 154, 202},
-    { 213, 189, 143},
-    { 228, 159, 178},
-    { 229, 179, 216},
-    { 195, 218, 168},
-    { 233, 221, 128},
-    { 222, 171, 221},
-    { 210, 184, 222},
-    { 234, 172, 194},
-    { 234, 194, 215},
-    { 199, 235, 173},
-    { 224, 174, 201},
-    { 206, 174, 224},
-    { 211, 236, 202},
-    { 190, 238, 191},
-    { 226, 214, 177},
-    { 227, 207, 193},
-    { 227, 225, 207},
-    { 240, 228, 178},
-    { 217, 179, 229},
-    { 208, 216, 179},
-    { 231, 232, 169},
-    { 232, 197, 169},
-    { 162, 198, 220},
-    { 234, 183, 172},
-    { 240, 178, 210},
-    { 246, 186, 200},
-    { 246, 200, 235},
-    { 224, 237, 190},
-    { 190, 237, 238},
-    { 238, 249, 226},
-    { 238, 226, 191},
-    { 208, 241, 216},
-    { 242, 161, 180},
-    { 218, 195, 217},
-    { 218, 257, 230},
-    { 244, 261, 233},
-    { 182, 244, 233},
-    { 245, 244, 182},
-    { 165, 183, 198},
-    { 262, 183, 234},
-    { 240, 210, 252},
-    { 201, 186, 246},
-    { 223, 202, 236},
-    { 269, 237, 224},
-    { 191, 226, 177},
-    { 270, 213, 251},
-    { 229, 216, 253},
-    { 231, 258, 232},
-    { 222, 276, 210},
-    { 262, 234, 215},
-    { 199, 277, 264},
-    { 224, 201, 269},
-    { 266, 211, 203},
-    { 248, 189, 212},
-    { 214, 281, 215},
-    { 283, 231, 257},
-    { 258, 231, 284},
-    { 220, 259, 209},
-    { 222, 221, 276},
-    { 276, 252, 210},
-    { 277, 199, 223},
-    { 278, 269, 201},
-    { 290, 223, 236},
-    { 250, 213, 270},
-    { 227, 193, 239},
-    { 266, 225, 227},
-    { 229, 253, 282},
-    { 254, 253, 216},
-    { 256, 243, 286},
-    { 275, 274, 245},
-    { 183, 262, 288},
-    { 298, 277, 223},
-    { 229, 282, 255},
-    { 305, 241, 256},
-    { 306, 257, 271},
-    { 258, 284, 285},
-    { 307, 285, 284},
-    { 286, 243, 294},
-    { 294, 243, 259},
-    { 277, 309, 289},
-    { 246, 265, 278},
-    { 311, 290, 236},
-    { 312, 313, 269},
-    { 302, 304, 281},
-    { 286, 305, 256},
-    { 286, 294, 316},
-    { 261, 295, 221},
-    { 318, 288, 262},
-    { 221, 319, 276},
-    { 299, 269, 278},
-    { 310, 290, 311},
-    { 321, 313, 312},
-    { 321, 300, 313},
-    { 301, 270, 251},
-    { 214, 249, 302},
-    { 300, 302, 249},
-    { 323, 314, 292},
-    { 325, 282, 253},
-    { 275, 260, 308},
-    { 274, 308, 273},
-    { 319, 221, 295},
-    { 319, 295, 327},
-    { 319, 327, 296},
-    { 319, 296, 276},
-    { 263, 262, 215},
-    { 303, 263, 297},
-    { 252, 292, 240},
-    { 249, 269, 313},
-    { 331, 300, 321},
-    { 324, 323, 292},
-    { 255, 282, 326},
-    { 305, 254, 241},
-    { 306, 283, 257},
-    { 306, 295, 283},
-    { 318, 262, 263},
-    { 296, 320, 252},
-    { 252, 320, 292},
-    { 298, 338, 309},
-    { 277, 298, 309},
-    { 265, 264, 289},
-    { 266, 239, 311},
-    { 321, 312, 342},
-    { 299, 342, 312},
-    { 300, 304, 302},
-    { 314, 323, 345},
-    { 333, 346, 332},
-    { 294, 317, 316},
-    { 260, 350, 308},
-    { 356, 298, 310},
-    { 344, 343, 301},
-    { 314, 345, 322},
-    { 345, 323, 358},
-    { 347, 323, 324},
-    { 334, 325, 360},
-    { 315, 306, 271},
-    { 273, 308, 350},
-    { 352, 296, 327},
-    { 353, 328, 309},
-    { 368, 358, 357},
-    { 347, 324, 370},
-    { 347, 370, 359},
-    { 360, 325, 372},
-    { 253, 361, 325},
-    { 285, 307, 349},
-    { 375, 316, 363},
-    { 364, 318, 263},
-    { 320, 296, 352},
-    { 377, 324, 320},
-    { 378, 366, 346},
-    { 378, 346, 369},
-    { 309, 338, 353},
-    { 356, 338, 298},
-    { 328, 354, 289},
-    { 354, 355, 289},
-    { 356, 310, 383},
-    { 356, 383, 382},
-    { 331, 342, 367},
-    { 367, 346, 333},
-    { 367, 333, 331},
-    { 345, 358, 368},
-    { 357, 385, 368},
-    { 386, 357, 359},
-    { 359, 370, 371},
-    { 326, 362, 348},
-    { 315, 326, 348},
-    { 315, 295, 306},
-    { 307, 373, 349},
-    { 374, 349, 373},
-    { 375, 363, 392},
-    { 318, 376, 317},
-    { 387, 378, 369},
-    { 353, 379, 394},
-    { 380, 338, 356},
-    { 311, 322, 310},
-    { 322, 345, 310},
-    { 396, 279, 268},
-    { 343, 344, 341},
-    { 340, 341, 344},
-    { 384, 342, 299},
-    { 357, 386, 385},
-    { 399, 359, 371},
-    { 388, 360, 400},
-    { 348, 362, 402},
-    { 219, 337, 260},
-    { 363, 404, 392},
-    { 350, 337, 273},
-    { 318, 364, 376},
-    { 402, 352, 327},
-    { 324, 377, 393},
-    { 393, 406, 371},
-    { 356, 382, 380},
-    { 339, 355, 354},
-    { 339, 354, 381},
-    { 385, 383, 368},
-    { 398, 369, 384},
-    { 407, 385, 386},
-    { 399, 386, 359},
-    { 399, 371, 412},
-    { 400, 360, 372},
-    { 334, 401, 362},
-    { 413, 402, 362},
-    { 392, 404, 403},
-    { 415, 403, 404},
-    { 363, 376, 404},
-    { 405, 320, 352},
-    { 405, 417, 416},
-    { 377, 320, 416},
-    { 379, 338, 380},
-    { 380, 382, 412},
-    { 396, 268, 329},
-    { 397, 329, 268},
-    { 399, 412, 411},
-    { 406, 422, 371},
-    { 412, 371, 422},
-    { 360, 388, 401},
-    { 327, 315, 348},
-    { 351, 374, 373},
-    { 375, 403, 423},
-    { 424, 405, 352},
-    { 417, 405, 424},
-    { 417, 424, 426},
-    { 405, 416, 320},
-    { 416, 417, 427},
-    { 377, 416, 427},
-    { 418, 422, 406},
-    { 419, 394, 379},
-    { 353, 394, 420},
-    { 381, 354, 328},
-    { 411, 412, 382},
-    { 410, 395, 421},
-    { 362, 401, 413},
-    { 374, 351, 293},
-    { 273, 219, 436},
-    { 417, 426, 438},
-    { 437, 417, 438},
-    { 417, 437, 427},
-    { 439, 418, 406},
-    { 442, 389, 390},
-    { 413, 434, 402},
-    { 425, 435, 423},
-    { 439, 377, 427},
-    { 448, 419, 449},
-    { 394, 419, 450},
-    { 419, 379, 422},
-    { 379, 412, 422},
-    { 409, 430, 397},
-    { 410, 340, 395},
-    { 431, 387, 398},
-    { 428, 387, 431},
-    { 432, 440, 388},
-    { 400, 372, 441},
-    { 444, 434, 413},
-    { 426, 434, 443},
-    { 426, 424, 434},
-    { 425, 378, 446},
-    { 419, 448, 450},
-    { 452, 450, 448},
-    { 431, 398, 381},
-    { 430, 329, 397},
-    { 409, 330, 408},
-    { 428, 431, 429},
-    { 441, 389, 442},
-    { 442, 390, 435},
-    { 437, 438, 444},
-    { 426, 443, 438},
-    { 455, 391, 293},
-    { 414, 219, 445},
-    { 425, 446, 435},
-    { 378, 387, 446},
-    { 448, 449, 461},
-    { 429, 450, 452},
-    { 431, 420, 429},
-    { 328, 420, 381},
-    { 454, 444, 433},
-    { 437, 444, 447},
-    { 293, 351, 455},
-    { 445, 457, 464},
-    { 219, 414, 436},
-    { 459, 451, 446},
-    { 459, 446, 428},
-    { 428, 460, 459},
-    { 449, 419, 418},
-    { 466, 461, 449},
-    { 448, 461, 452},
-    { 467, 452, 461},
-    { 452, 468, 429},
-    { 431, 381, 420},
-    { 440, 458, 454},
-    { 454, 447, 444},
-    { 336, 456, 457},
-    { 470, 464, 457},
-    { 414, 445, 464},
-    { 467, 461, 466},
-    { 468, 473, 429},
-    { 454, 458, 447},
-    { 435, 451, 442},
-    { 441, 442, 451},
-    { 391, 455, 463},
-    { 456, 470, 457},
-    { 465, 475, 471},
-    { 429, 473, 460},
-    { 466, 472, 467},
-    { 474, 453, 462},
-    { 453, 475, 465},
-    { 458, 440, 465},
-    { 440, 453, 465},
-    { 462, 432, 469},
-    { 478, 459, 460},
-    { 477, 473, 468},
-    { 466, 476, 472},
-    { 475, 476, 471},
-    { 474, 462, 479},
-    { 462, 469, 478},
-    { 478, 460, 480},
-    { 473, 480, 460},
-    { 467, 472, 477},
-    { 481, 476, 475},
-    { 475, 474, 481},
-    { 479, 462, 478},
-    { 482, 477, 472},
-    { 476, 481, 472},
-    { 477, 482, 480},
-    { 479, 481, 474},
-    { 478, 480, 479},
-    { 473, 477, 480},
-    { 472, 481, 482},
-    { 481, 479, 482},
-    { 345, 368, 310},
-    { 305, 286, 316},
-    { 144, 191, 177},
-    { 255, 315, 271},
-    { 382, 407, 411},
-    { 386, 411, 407},
-    { 257, 231, 230},
-    { 174, 186, 201},
-    { 173, 235, 200},
-    { 337, 219, 273},
-    { 264, 277, 289},
-    { 239, 228, 280},
-    { 78, 32, 69},
-    { 24, 40, 20},
-    { 5, 0, 2},
-    { 57, 86, 51},
-    { 134, 171, 184},
-    { 73, 58, 77},
-    { 401, 433, 413},
-    { 23, 8, 9},
-    { 182, 163, 181},
-    { 209, 170, 220},
-    { 69, 90, 95},
-    { 289, 309, 328},
-    { 5, 7, 22},
-    { 198, 164, 165},
-    { 424, 402, 434},
-    { 466, 471, 476},
-    { 49, 9, 30},
-    { 353, 338, 379},
-    { 49, 60, 48},
-    { 21, 36, 45},
-    { 276, 296, 252},
-    { 327, 295, 315},
-    { 441, 451, 469},
-    { 459, 469, 451},
-    { 304, 300, 333},
-    { 331, 333, 300},
-    { 260, 337, 350},
-    { 369, 398, 387},
-    { 193, 159, 228},
-    { 265, 289, 355},
-    { 320, 324, 292},
-    { 291, 343, 250},
-    { 131, 190, 150},
-    { 137, 196, 146},
-    { 180, 146, 196},
-    { 103, 164, 127},
-    { 22, 17, 25},
-    { 148, 175, 157},
-    { 204, 157, 175},
-    { 33, 44, 46},
-    { 444, 443, 434},
-    { 145, 136, 161},
-    { 444, 413, 433},
-    { 101, 132, 116},
-    { 204, 205, 247},
-    { 372, 389, 441},
-    { 312, 269, 299},
-    { 422, 418, 419},
-    { 25, 31, 22},
-    { 187, 211, 202},
-    { 446, 451, 435},
-    { 180, 243, 242},
-    { 3, 12, 14},
-    { 137, 96, 138},
-    { 42, 59, 38},
-    { 107, 96, 137},
-    { 206, 224, 190},
-    { 411, 386, 399},
-    { 113, 116, 143},
-    { 322, 311, 239},
-    { 99, 75, 85},
-    { 244, 245, 274},
-    { 31, 32, 22},
-    { 347, 359, 357},
-    { 132, 158, 192},
-    { 176, 192, 158},
-    { 233, 261, 221},
-    { 322, 239, 280},
-    { 415, 404, 365},
-    { 365, 366, 415},
-    { 380, 412, 379},
-    { 218, 217, 271},
-    { 255, 271, 217},
-    { 108, 125, 152},
-    { 2, 8, 10},
-    { 440, 454, 388},
-    { 433, 388, 454},
-    { 29, 56, 15},
-    { 97, 103, 127},
-    { 388, 433, 401},
-    { 375, 335, 316},
-    { 424, 352, 402},
-    { 101, 134, 133},
-    { 84, 75, 99},
-    { 387, 428, 446},
-    { 479, 480, 482},
-    { 323, 347, 358},
-    { 357, 358, 347},
-    { 121, 154, 155},
-    { 295, 261, 283},
-    { 72, 80, 116},
-    { 121, 155, 129},
-    { 3, 1, 0},
-    { 207, 166, 193},
-    { 166, 158, 132},
-    { 212, 189, 267},
-    { 131, 149, 206},
-    { 174, 206, 149},
-    { 139, 98, 102},
-    { 249, 313, 300},
-    { 335, 254, 305},
-    { 335, 305, 316},
-    { 346, 367, 369},
-    { 384, 369, 367},
-    { 279, 267, 189},
-    { 256, 242, 243},
-    { 315, 255, 326},
-    { 119, 153, 163},
-    { 181, 163, 153},
-    { 69, 95, 78},
-    { 366, 332, 346},
-    { 444, 438, 443},
-    { 74, 37, 73},
-    { 334, 282, 325},
-    { 103, 87, 141},
-    { 114, 131, 115},
-    { 466, 449, 471},
-    { 88, 108, 82},
-    { 74, 82, 90},
-    { 108, 90, 82},
-    { 87, 100, 141},
-    { 3, 14, 6},
-    { 153, 152, 197},
-    { 169, 197, 152},
-    { 11, 33, 16},
-    { 99, 85, 122},
-    { 85, 75, 65},
-    { 28, 62, 39},
-    { 254, 361, 253},
-    { 231, 169, 230},
-    { 53, 61, 98},
-    { 217, 229, 255},
-    { 365, 332, 366},
-    { 78, 95, 102},
-    { 14, 28, 18},
-    { 64, 96, 107},
-    { 75, 34, 65},
-    { 235, 265, 246},
-    { 228, 240, 280},
-    { 167, 161, 208},
-    { 88, 73, 77},
-    { 204, 188, 157},
-    { 280, 240, 314},
-    { 242, 208, 161},
-    { 93, 113, 112},
-    { 117, 135, 125},
-    { 116, 80, 101},
-    { 335, 375, 390},
-    { 183, 272, 198},
-    { 239, 193, 228},
-    { 349, 374, 293},
-    { 87, 79, 100},
-    { 94, 100, 79},
-    { 375, 423, 390},
-    { 435, 390, 423},
-    { 223, 199, 185},
-    { 138, 96, 97},
-    { 48, 43, 23},
-    { 401, 334, 360},
-    { 119, 95, 109},
-    { 215, 281, 297},
-    { 287, 288, 318},
-    { 429, 460, 428},
-    { 43, 48, 54},
-    { 400, 441, 432},
-    { 40, 52, 50},
-    { 439, 427, 458},
-    { 447, 458, 427},
-    { 223, 290, 298},
-    { 72, 67, 50},
-    { 382, 383, 407},
-    { 385, 407, 383},
-    { 84, 110, 123},
-    { 129, 123, 110},
-    { 341, 340, 410},
-    { 71, 92, 66},
-    { 27, 32, 44},
-    { 72, 50, 52},
-    { 58, 59, 81},
-    { 89, 81, 59},
-    { 324, 393, 370},
-    { 371, 370, 393},
-    { 469, 459, 478},
-    { 226, 249, 214},
-    { 310, 368, 383},
-    { 279, 396, 267},
-    { 57, 66, 86},
-    { 66, 92, 86},
-    { 114, 86, 92},
-    { 24, 16, 33},
-    { 287, 259, 272},
-    { 205, 248, 247},
-    { 212, 247, 248},
-    { 389, 361, 390},
-    { 95, 119, 102},
-    { 93, 65, 67},
-    { 6, 1, 3},
-    { 73, 82, 74},
-    { 167, 124, 161},
-    { 290, 310, 298},
-    { 318, 317, 287},
-    { 209, 180, 196},
-    { 340, 408, 395},
-    { 183, 288, 272},
-    { 287, 272, 288},
-    { 474, 475, 453},
-    { 29, 15, 12},
-    { 63, 105, 79},
-    { 59, 64, 89},
-    { 21, 45, 30},
-    { 41, 30, 45},
-    { 106, 117, 88},
-    { 223, 185, 202},
-    { 120, 140, 128},
-    { 18, 39, 35},
-    { 36, 51, 45},
-    { 144, 100, 94},
-    { 105, 94, 79},
-    { 33, 27, 44},
-    { 123, 174, 149},
-    { 58, 81, 77},
-    { 203, 225, 266},
-    { 362, 326, 334},
-    { 28, 34, 62},
-    { 316, 317, 363},
-    { 376, 363, 317},
-    { 259, 243, 209},
-    { 71, 66, 62},
-    { 209, 243, 180},
-    { 348, 402, 327},
-    { 109, 153, 119},
-    { 325, 361, 372},
-    { 389, 372, 361},
-    { 201, 246, 278},
-    { 218, 271, 257},
-    { 353, 420, 328},
-    { 339, 299, 355},
-    { 265, 355, 278},
-    { 299, 278, 355},
-    { 249, 237, 269},
-    { 250, 270, 291},
-    { 70, 60, 49},
-    { 292, 314, 240},
-    { 180, 161, 136},
-    { 89, 126, 81},
-    { 118, 81, 126},
-    { 308, 274, 275},
-    { 311, 236, 266},
-    { 452, 467, 468},
-    { 477, 468, 467},
-    { 211, 266, 236},
-    { 321, 342, 331},
-    { 43, 64, 42},
-    { 59, 42, 64},
-    { 121, 156, 154},
-    { 343, 291, 301},
-    { 280, 314, 322},
-    { 334, 326, 282},
-    { 301, 291, 270},
-    { 447, 427, 437},
-    { 302, 281, 214},
-    { 227, 239, 266},
-    { 164, 198, 162},
-    { 259, 287, 294},
-    { 317, 294, 287},
-    { 70, 97, 60},
-    { 469, 432, 441},
-    { 162, 138, 97},
-    { 187, 154, 156},
-    { 392, 403, 375},
-    { 194, 214, 215},
-    { 391, 463, 336},
-    { 88, 117, 108},
-    { 125, 108, 117},
-    { 432, 388, 400},
-    { 37, 31, 25},
-    { 456, 336, 470},
-    { 463, 470, 336},
-    { 263, 215, 297},
-    { 1, 13, 8},
-    { 9, 8, 13},
-    { 96, 60, 97},
-    { 163, 182, 140},
-    { 128, 140, 182},
-    { 48, 60, 54},
-    { 51, 104, 105},
-    { 115, 105, 104},
-    { 403, 415, 423},
-    { 166, 207, 158},
-    { 430, 409, 408},
-    { 22, 32, 27},
-    { 199, 264, 235},
-    { 265, 235, 264},
-    { 65, 34, 56},
-    { 15, 14, 12},
-    { 52, 80, 72},
-    { 42, 38, 25},
-    { 204, 247, 212},
-    { 299, 339, 384},
-    { 279, 189, 268},
-    { 391, 336, 293},
-    { 198, 272, 220},
-    { 259, 220, 272},
-    { 396, 329, 267},
-    { 342, 384, 367},
-    { 377, 439, 393},
-    { 406, 393, 439},
-    { 233, 128, 182},
-    { 189, 343, 410},
-    { 341, 410, 343},
-    { 254, 335, 361},
-    { 390, 361, 335},
-    { 237, 249, 238},
-    { 254, 216, 241},
-    { 394, 450, 420},
-    { 429, 420, 450},
-    { 176, 251, 192},
-    { 213, 192, 251},
-    { 219, 260, 245},
-    { 275, 245, 260},
-    { 35, 57, 36},
-    { 51, 36, 57},
-    { 439, 458, 418},
-    { 465, 418, 458},
-    { 147, 172, 165},
-    { 183, 165, 172},
-    { 455, 351, 463},
-    { 408, 330, 395},
-    { 421, 395, 330},
-    { 339, 381, 384},
-    { 398, 384, 381},
-    { 122, 148, 156},
-    { 205, 175, 248},
-    { 80, 76, 101},
-    { 83, 101, 76},
-    { 208, 242, 241},
-    { 256, 241, 242},
-    { 281, 304, 297},
-    { 303, 297, 304},
-    { 284, 231, 307},
-    { 263, 303, 364},
-    { 182, 181, 245},
-    { 283, 351, 231},
-    { 445, 219, 457},
-    { 463, 351, 470},
-    { 160, 167, 179},
-    { 208, 179, 167},
-    { 143, 132, 213},
-    { 192, 213, 132},
-    { 397, 268, 409},
-    { 148, 157, 156},
-    { 188, 156, 157},
-    { 404, 376, 365},
-    { 432, 462, 440},
-    { 453, 440, 462},
-    { 307, 231, 373},
-    { 351, 373, 231},
-    { 225, 203, 212},
-    { 410, 421, 189},
-    { 418, 465, 449},
-    { 471, 449, 465},
-    { 248, 175, 189},
-    { 409, 268, 330},
-    { 366, 378, 415},
-    { 415, 378, 423},
-    { 425, 423, 378},
-    { 212, 267, 430},
-    { 329, 430, 267},
-    { 430, 408, 212},
-    { 344, 301, 340},
-    { 176, 158, 212},
-    { 212, 301, 176},
-    { 251, 176, 301},
-    { 203, 188, 212},
-    { 204, 212, 188},
-    { 212, 408, 301},
-    { 340, 301, 408},
-    { 207, 225, 158},
-    { 212, 158, 225},
-    { 245, 336, 219},
-    { 457, 219, 336},
-    { 168, 218, 169},
-    { 230, 169, 218},
-    { 189, 213, 343},
-    { 250, 343, 213},
-    { 364, 303, 376},
-    { 365, 376, 303},
-    { 142, 143, 175},
-    { 189, 175, 143},
-    { 189, 421, 268},
-    { 330, 268, 421},
-    { 245, 349, 336},
-    { 293, 336, 349},
-    { 274, 470, 283},
-    { 351, 283, 470},
-    { 274, 273, 470},
-    { 273, 436, 470},
-    { 436, 414, 470},
-    { 464, 470, 414},
-    { 244, 274, 261},
-    { 283, 261, 274},
-    { 232, 258, 197},
-    { 197, 258, 349},
-    { 285, 349, 258},
-    { 181, 197, 245},
-    { 349, 245, 197},
-    { 333, 332, 304},
-    { 303, 304, 365},
-    { 332, 365, 304}
+    1, 2, 0,
+    3, 0, 4,
+    2, 7, 5,
+    2, 1, 8,
+    10, 7, 2,
+    0, 5, 11,
+    0, 11, 4,
+    4, 12, 3,
+    6, 13, 1,
+    18, 6, 14,
+    4, 11, 16,
+    19, 13, 6,
+    21, 9, 13,
+    7, 10, 17,
+    10, 8, 23,
+    4, 20, 12,
+    13, 19, 21,
+    20, 4, 16,
+    7, 17, 22,
+    10, 26, 17,
+    5, 27, 11,
+    28, 14, 15,
+    19, 6, 18,
+    9, 21, 30,
+    27, 5, 22,
+    11, 27, 33,
+    15, 34, 28,
+    29, 12, 20,
+    19, 18, 35,
+    19, 36, 21,
+    37, 25, 38,
+    17, 26, 25,
+    24, 20, 16,
+    26, 10, 23,
+    26, 23, 43,
+    18, 28, 39,
+    47, 24, 46,
+    26, 43, 42,
+    24, 33, 46,
+    47, 52, 40,
+    24, 47, 40,
+    47, 46, 53,
+    42, 25, 26,
+    23, 9, 49,
+    19, 35, 36,
+    50, 29, 20,
+    40, 50, 20,
+    58, 37, 38,
+    48, 23, 49,
+    44, 61, 46,
+    55, 62, 34,
+    15, 56, 34,
+    41, 45, 63,
+    30, 41, 49,
+    29, 50, 56,
+    50, 67, 56,
+    35, 66, 57,
+    49, 41, 70,
+    62, 66, 39,
+    39, 66, 35,
+    38, 59, 58,
+    31, 69, 32,
+    46, 61, 53,
+    70, 41, 68,
+    34, 75, 55,
+    71, 62, 55,
+    56, 67, 65,
+    68, 41, 63,
+    76, 52, 47,
+    47, 53, 76,
+    58, 73, 37,
+    64, 43, 54,
+    63, 45, 51,
+    53, 83, 76,
+    75, 84, 55,
+    68, 79, 87,
+    90, 69, 74,
+    69, 31, 74,
+    31, 37, 74,
+    44, 32, 78,
+    84, 91, 55,
+    68, 63, 79,
+    61, 44, 78,
+    85, 65, 93,
+    72, 93, 67,
+    80, 52, 76,
+    102, 61, 78,
+    98, 83, 53,
+    91, 71, 55,
+    63, 51, 105,
+    73, 88, 82,
+    96, 54, 60,
+    70, 103, 97,
+    110, 84, 99,
+    111, 92, 71,
+    85, 93, 112,
+    114, 104, 86,
+    104, 51, 86,
+    77, 106, 88,
+    77, 81, 118,
+    54, 96, 64,
+    95, 90, 109,
+    102, 98, 61,
+    87, 103, 68,
+    101, 83, 120,
+    122, 121, 110,
+    122, 110, 99,
+    111, 91, 123,
+    111, 71, 91,
+    106, 124, 117,
+    64, 107, 89,
+    108, 109, 90,
+    103, 70, 68,
+    129, 110, 121,
+    130, 92, 111,
+    72, 113, 93,
+    114, 115, 104,
+    101, 120, 134,
+    118, 106, 77,
+    89, 107, 126,
+    120, 83, 98,
+    84, 123, 91,
+    85, 112, 122,
+    142, 112, 113,
+    115, 94, 105,
+    72, 116, 113,
+    106, 145, 124,
+    137, 146, 107,
+    120, 128, 134,
+    112, 148, 122,
+    111, 149, 130,
+    133, 132, 101,
+    117, 124, 135,
+    106, 118, 145,
+    118, 126, 146,
+    126, 107, 146,
+    139, 102, 119,
+    139, 140, 98,
+    98, 140, 120,
+    100, 147, 141,
+    156, 121, 122,
+    123, 149, 111,
+    149, 131, 130,
+    114, 92, 130,
+    150, 115, 131,
+    150, 94, 115,
+    143, 116, 132,
+    100, 144, 151,
+    135, 124, 160,
+    118, 136, 145,
+    146, 136, 118,
+    127, 162, 97,
+    141, 147, 165,
+    142, 148, 112,
+    131, 114, 130,
+    166, 132, 133,
+    134, 159, 133,
+    152, 109, 108,
+    109, 152, 153,
+    163, 139, 119,
+    103, 141, 164,
+    165, 164, 141,
+    134, 128, 171,
+    151, 172, 147,
+    151, 147, 100,
+    154, 173, 155,
+    174, 123, 129,
+    142, 175, 148,
+    159, 166, 133,
+    167, 160, 124,
+    135, 160, 168,
+    124, 145, 161,
+    125, 169, 152,
+    170, 137, 138,
+    127, 164, 162,
+    134, 184, 159,
+    178, 159, 184,
+    186, 129, 155,
+    142, 113, 143,
+    144, 94, 150,
+    159, 193, 166,
+    177, 194, 151,
+    195, 160, 179,
+    135, 168, 125,
+    169, 125, 168,
+    180, 136, 146,
+    162, 170, 138,
+    139, 163, 140,
+    172, 151, 194,
+    173, 200, 155,
+    129, 186, 174,
+    154, 187, 202,
+    188, 203, 187,
+    156, 188, 187,
+    191, 150, 190,
+    170, 196, 137,
+    178, 184, 210,
+    185, 199, 173,
+    154, 185, 173,
+    186, 155, 200,
+    187, 203, 211,
+    205, 204, 175,
+    131, 206, 190,
+    191, 144, 150,
+    144, 177, 151,
+    177, 214, 194,
+    217, 195, 179,
+    160, 195, 168,
+    196, 170, 209,
+    197, 181, 153,
+    220, 170, 162,
+    128, 221, 171,
+    222, 184, 171,
+    185, 154, 202,
+    213, 189, 143,
+    228, 159, 178,
+    229, 179, 216,
+    195, 218, 168,
+    233, 221, 128,
+    222, 171, 221,
+    210, 184, 222,
+    234, 172, 194,
+    234, 194, 215,
+    199, 235, 173,
+    224, 174, 201,
+    206, 174, 224,
+    211, 236, 202,
+    190, 238, 191,
+    226, 214, 177,
+    227, 207, 193,
+    227, 225, 207,
+    240, 228, 178,
+    217, 179, 229,
+    208, 216, 179,
+    231, 232, 169,
+    232, 197, 169,
+    162, 198, 220,
+    234, 183, 172,
+    240, 178, 210,
+    246, 186, 200,
+    246, 200, 235,
+    224, 237, 190,
+    190, 237, 238,
+    238, 249, 226,
+    238, 226, 191,
+    208, 241, 216,
+    242, 161, 180,
+    218, 195, 217,
+    218, 257, 230,
+    244, 261, 233,
+    182, 244, 233,
+    245, 244, 182,
+    165, 183, 198,
+    262, 183, 234,
+    240, 210, 252,
+    201, 186, 246,
+    223, 202, 236,
+    269, 237, 224,
+    191, 226, 177,
+    270, 213, 251,
+    229, 216, 253,
+    231, 258, 232,
+    222, 276, 210,
+    262, 234, 215,
+    199, 277, 264,
+    224, 201, 269,
+    266, 211, 203,
+    248, 189, 212,
+    214, 281, 215,
+    283, 231, 257,
+    258, 231, 284,
+    220, 259, 209,
+    222, 221, 276,
+    276, 252, 210,
+    277, 199, 223,
+    278, 269, 201,
+    290, 223, 236,
+    250, 213, 270,
+    227, 193, 239,
+    266, 225, 227,
+    229, 253, 282,
+    254, 253, 216,
+    256, 243, 286,
+    275, 274, 245,
+    183, 262, 288,
+    298, 277, 223,
+    229, 282, 255,
+    305, 241, 256,
+    306, 257, 271,
+    258, 284, 285,
+    307, 285, 284,
+    286, 243, 294,
+    294, 243, 259,
+    277, 309, 289,
+    246, 265, 278,
+    311, 290, 236,
+    312, 313, 269,
+    302, 304, 281,
+    286, 305, 256,
+    286, 294, 316,
+    261, 295, 221,
+    318, 288, 262,
+    221, 319, 276,
+    299, 269, 278,
+    310, 290, 311,
+    321, 313, 312,
+    321, 300, 313,
+    301, 270, 251,
+    214, 249, 302,
+    300, 302, 249,
+    323, 314, 292,
+    325, 282, 253,
+    275, 260, 308,
+    274, 308, 273,
+    319, 221, 295,
+    319, 295, 327,
+    319, 327, 296,
+    319, 296, 276,
+    263, 262, 215,
+    303, 263, 297,
+    252, 292, 240,
+    249, 269, 313,
+    331, 300, 321,
+    324, 323, 292,
+    255, 282, 326,
+    305, 254, 241,
+    306, 283, 257,
+    306, 295, 283,
+    318, 262, 263,
+    296, 320, 252,
+    252, 320, 292,
+    298, 338, 309,
+    277, 298, 309,
+    265, 264, 289,
+    266, 239, 311,
+    321, 312, 342,
+    299, 342, 312,
+    300, 304, 302,
+    314, 323, 345,
+    333, 346, 332,
+    294, 317, 316,
+    260, 350, 308,
+    356, 298, 310,
+    344, 343, 301,
+    314, 345, 322,
+    345, 323, 358,
+    347, 323, 324,
+    334, 325, 360,
+    315, 306, 271,
+    273, 308, 350,
+    352, 296, 327,
+    353, 328, 309,
+    368, 358, 357,
+    347, 324, 370,
+    347, 370, 359,
+    360, 325, 372,
+    253, 361, 325,
+    285, 307, 349,
+    375, 316, 363,
+    364, 318, 263,
+    320, 296, 352,
+    377, 324, 320,
+    378, 366, 346,
+    378, 346, 369,
+    309, 338, 353,
+    356, 338, 298,
+    328, 354, 289,
+    354, 355, 289,
+    356, 310, 383,
+    356, 383, 382,
+    331, 342, 367,
+    367, 346, 333,
+    367, 333, 331,
+    345, 358, 368,
+    357, 385, 368,
+    386, 357, 359,
+    359, 370, 371,
+    326, 362, 348,
+    315, 326, 348,
+    315, 295, 306,
+    307, 373, 349,
+    374, 349, 373,
+    375, 363, 392,
+    318, 376, 317,
+    387, 378, 369,
+    353, 379, 394,
+    380, 338, 356,
+    311, 322, 310,
+    322, 345, 310,
+    396, 279, 268,
+    343, 344, 341,
+    340, 341, 344,
+    384, 342, 299,
+    357, 386, 385,
+    399, 359, 371,
+    388, 360, 400,
+    348, 362, 402,
+    219, 337, 260,
+    363, 404, 392,
+    350, 337, 273,
+    318, 364, 376,
+    402, 352, 327,
+    324, 377, 393,
+    393, 406, 371,
+    356, 382, 380,
+    339, 355, 354,
+    339, 354, 381,
+    385, 383, 368,
+    398, 369, 384,
+    407, 385, 386,
+    399, 386, 359,
+    399, 371, 412,
+    400, 360, 372,
+    334, 401, 362,
+    413, 402, 362,
+    392, 404, 403,
+    415, 403, 404,
+    363, 376, 404,
+    405, 320, 352,
+    405, 417, 416,
+    377, 320, 416,
+    379, 338, 380,
+    380, 382, 412,
+    396, 268, 329,
+    397, 329, 268,
+    399, 412, 411,
+    406, 422, 371,
+    412, 371, 422,
+    360, 388, 401,
+    327, 315, 348,
+    351, 374, 373,
+    375, 403, 423,
+    424, 405, 352,
+    417, 405, 424,
+    417, 424, 426,
+    405, 416, 320,
+    416, 417, 427,
+    377, 416, 427,
+    418, 422, 406,
+    419, 394, 379,
+    353, 394, 420,
+    381, 354, 328,
+    411, 412, 382,
+    410, 395, 421,
+    362, 401, 413,
+    374, 351, 293,
+    273, 219, 436,
+    417, 426, 438,
+    437, 417, 438,
+    417, 437, 427,
+    439, 418, 406,
+    442, 389, 390,
+    413, 434, 402,
+    425, 435, 423,
+    439, 377, 427,
+    448, 419, 449,
+    394, 419, 450,
+    419, 379, 422,
+    379, 412, 422,
+    409, 430, 397,
+    410, 340, 395,
+    431, 387, 398,
+    428, 387, 431,
+    432, 440, 388,
+    400, 372, 441,
+    444, 434, 413,
+    426, 434, 443,
+    426, 424, 434,
+    425, 378, 446,
+    419, 448, 450,
+    452, 450, 448,
+    431, 398, 381,
+    430, 329, 397,
+    409, 330, 408,
+    428, 431, 429,
+    441, 389, 442,
+    442, 390, 435,
+    437, 438, 444,
+    426, 443, 438,
+    455, 391, 293,
+    414, 219, 445,
+    425, 446, 435,
+    378, 387, 446,
+    448, 449, 461,
+    429, 450, 452,
+    431, 420, 429,
+    328, 420, 381,
+    454, 444, 433,
+    437, 444, 447,
+    293, 351, 455,
+    445, 457, 464,
+    219, 414, 436,
+    459, 451, 446,
+    459, 446, 428,
+    428, 460, 459,
+    449, 419, 418,
+    466, 461, 449,
+    448, 461, 452,
+    467, 452, 461,
+    452, 468, 429,
+    431, 381, 420,
+    440, 458, 454,
+    454, 447, 444,
+    336, 456, 457,
+    470, 464, 457,
+    414, 445, 464,
+    467, 461, 466,
+    468, 473, 429,
+    454, 458, 447,
+    435, 451, 442,
+    441, 442, 451,
+    391, 455, 463,
+    456, 470, 457,
+    465, 475, 471,
+    429, 473, 460,
+    466, 472, 467,
+    474, 453, 462,
+    453, 475, 465,
+    458, 440, 465,
+    440, 453, 465,
+    462, 432, 469,
+    478, 459, 460,
+    477, 473, 468,
+    466, 476, 472,
+    475, 476, 471,
+    474, 462, 479,
+    462, 469, 478,
+    478, 460, 480,
+    473, 480, 460,
+    467, 472, 477,
+    481, 476, 475,
+    475, 474, 481,
+    479, 462, 478,
+    482, 477, 472,
+    476, 481, 472,
+    477, 482, 480,
+    479, 481, 474,
+    478, 480, 479,
+    473, 477, 480,
+    472, 481, 482,
+    481, 479, 482,
+    345, 368, 310,
+    305, 286, 316,
+    144, 191, 177,
+    255, 315, 271,
+    382, 407, 411,
+    386, 411, 407,
+    257, 231, 230,
+    174, 186, 201,
+    173, 235, 200,
+    337, 219, 273,
+    264, 277, 289,
+    239, 228, 280,
+    78, 32, 69,
+    24, 40, 20,
+    5, 0, 2,
+    57, 86, 51,
+    134, 171, 184,
+    73, 58, 77,
+    401, 433, 413,
+    23, 8, 9,
+    182, 163, 181,
+    209, 170, 220,
+    69, 90, 95,
+    289, 309, 328,
+    5, 7, 22,
+    198, 164, 165,
+    424, 402, 434,
+    466, 471, 476,
+    49, 9, 30,
+    353, 338, 379,
+    49, 60, 48,
+    21, 36, 45,
+    276, 296, 252,
+    327, 295, 315,
+    441, 451, 469,
+    459, 469, 451,
+    304, 300, 333,
+    331, 333, 300,
+    260, 337, 350,
+    369, 398, 387,
+    193, 159, 228,
+    265, 289, 355,
+    320, 324, 292,
+    291, 343, 250,
+    131, 190, 150,
+    137, 196, 146,
+    180, 146, 196,
+    103, 164, 127,
+    22, 17, 25,
+    148, 175, 157,
+    204, 157, 175,
+    33, 44, 46,
+    444, 443, 434,
+    145, 136, 161,
+    444, 413, 433,
+    101, 132, 116,
+    204, 205, 247,
+    372, 389, 441,
+    312, 269, 299,
+    422, 418, 419,
+    25, 31, 22,
+    187, 211, 202,
+    446, 451, 435,
+    180, 243, 242,
+    3, 12, 14,
+    137, 96, 138,
+    42, 59, 38,
+    107, 96, 137,
+    206, 224, 190,
+    411, 386, 399,
+    113, 116, 143,
+    322, 311, 239,
+    99, 75, 85,
+    244, 245, 274,
+    31, 32, 22,
+    347, 359, 357,
+    132, 158, 192,
+    176, 192, 158,
+    233, 261, 221,
+    322, 239, 280,
+    415, 404, 365,
+    365, 366, 415,
+    380, 412, 379,
+    218, 217, 271,
+    255, 271, 217,
+    108, 125, 152,
+    2, 8, 10,
+    440, 454, 388,
+    433, 388, 454,
+    29, 56, 15,
+    97, 103, 127,
+    388, 433, 401,
+    375, 335, 316,
+    424, 352, 402,
+    101, 134, 133,
+    84, 75, 99,
+    387, 428, 446,
+    479, 480, 482,
+    323, 347, 358,
+    357, 358, 347,
+    121, 154, 155,
+    295, 261, 283,
+    72, 80, 116,
+    121, 155, 129,
+    3, 1, 0,
+    207, 166, 193,
+    166, 158, 132,
+    212, 189, 267,
+    131, 149, 206,
+    174, 206, 149,
+    139, 98, 102,
+    249, 313, 300,
+    335, 254, 305,
+    335, 305, 316,
+    346, 367, 369,
+    384, 369, 367,
+    279, 267, 189,
+    256, 242, 243,
+    315, 255, 326,
+    119, 153, 163,
+    181, 163, 153,
+    69, 95, 78,
+    366, 332, 346,
+    444, 438, 443,
+    74, 37, 73,
+    334, 282, 325,
+    103, 87, 141,
+    114, 131, 115,
+    466, 449, 471,
+    88, 108, 82,
+    74, 82, 90,
+    108, 90, 82,
+    87, 100, 141,
+    3, 14, 6,
+    153, 152, 197,
+    169, 197, 152,
+    11, 33, 16,
+    99, 85, 122,
+    85, 75, 65,
+    28, 62, 39,
+    254, 361, 253,
+    231, 169, 230,
+    53, 61, 98,
+    217, 229, 255,
+    365, 332, 366,
+    78, 95, 102,
+    14, 28, 18,
+    64, 96, 107,
+    75, 34, 65,
+    235, 265, 246,
+    228, 240, 280,
+    167, 161, 208,
+    88, 73, 77,
+    204, 188, 157,
+    280, 240, 314,
+    242, 208, 161,
+    93, 113, 112,
+    117, 135, 125,
+    116, 80, 101,
+    335, 375, 390,
+    183, 272, 198,
+    239, 193, 228,
+    349, 374, 293,
+    87, 79, 100,
+    94, 100, 79,
+    375, 423, 390,
+    435, 390, 423,
+    223, 199, 185,
+    138, 96, 97,
+    48, 43, 23,
+    401, 334, 360,
+    119, 95, 109,
+    215, 281, 297,
+    287, 288, 318,
+    429, 460, 428,
+    43, 48, 54,
+    400, 441, 432,
+    40, 52, 50,
+    439, 427, 458,
+    447, 458, 427,
+    223, 290, 298,
+    72, 67, 50,
+    382, 383, 407,
+    385, 407, 383,
+    84, 110, 123,
+    129, 123, 110,
+    341, 340, 410,
+    71, 92, 66,
+    27, 32, 44,
+    72, 50, 52,
+    58, 59, 81,
+    89, 81, 59,
+    324, 393, 370,
+    371, 370, 393,
+    469, 459, 478,
+    226, 249, 214,
+    310, 368, 383,
+    279, 396, 267,
+    57, 66, 86,
+    66, 92, 86,
+    114, 86, 92,
+    24, 16, 33,
+    287, 259, 272,
+    205, 248, 247,
+    212, 247, 248,
+    389, 361, 390,
+    95, 119, 102,
+    93, 65, 67,
+    6, 1, 3,
+    73, 82, 74,
+    167, 124, 161,
+    290, 310, 298,
+    318, 317, 287,
+    209, 180, 196,
+    340, 408, 395,
+    183, 288, 272,
+    287, 272, 288,
+    474, 475, 453,
+    29, 15, 12,
+    63, 105, 79,
+    59, 64, 89,
+    21, 45, 30,
+    41, 30, 45,
+    106, 117, 88,
+    223, 185, 202,
+    120, 140, 128,
+    18, 39, 35,
+    36, 51, 45,
+    144, 100, 94,
+    105, 94, 79,
+    33, 27, 44,
+    123, 174, 149,
+    58, 81, 77,
+    203, 225, 266,
+    362, 326, 334,
+    28, 34, 62,
+    316, 317, 363,
+    376, 363, 317,
+    259, 243, 209,
+    71, 66, 62,
+    209, 243, 180,
+    348, 402, 327,
+    109, 153, 119,
+    325, 361, 372,
+    389, 372, 361,
+    201, 246, 278,
+    218, 271, 257,
+    353, 420, 328,
+    339, 299, 355,
+    265, 355, 278,
+    299, 278, 355,
+    249, 237, 269,
+    250, 270, 291,
+    70, 60, 49,
+    292, 314, 240,
+    180, 161, 136,
+    89, 126, 81,
+    118, 81, 126,
+    308, 274, 275,
+    311, 236, 266,
+    452, 467, 468,
+    477, 468, 467,
+    211, 266, 236,
+    321, 342, 331,
+    43, 64, 42,
+    59, 42, 64,
+    121, 156, 154,
+    343, 291, 301,
+    280, 314, 322,
+    334, 326, 282,
+    301, 291, 270,
+    447, 427, 437,
+    302, 281, 214,
+    227, 239, 266,
+    164, 198, 162,
+    259, 287, 294,
+    317, 294, 287,
+    70, 97, 60,
+    469, 432, 441,
+    162, 138, 97,
+    187, 154, 156,
+    392, 403, 375,
+    194, 214, 215,
+    391, 463, 336,
+    88, 117, 108,
+    125, 108, 117,
+    432, 388, 400,
+    37, 31, 25,
+    456, 336, 470,
+    463, 470, 336,
+    263, 215, 297,
+    1, 13, 8,
+    9, 8, 13,
+    96, 60, 97,
+    163, 182, 140,
+    128, 140, 182,
+    48, 60, 54,
+    51, 104, 105,
+    115, 105, 104,
+    403, 415, 423,
+    166, 207, 158,
+    430, 409, 408,
+    22, 32, 27,
+    199, 264, 235,
+    265, 235, 264,
+    65, 34, 56,
+    15, 14, 12,
+    52, 80, 72,
+    42, 38, 25,
+    204, 247, 212,
+    299, 339, 384,
+    279, 189, 268,
+    391, 336, 293,
+    198, 272, 220,
+    259, 220, 272,
+    396, 329, 267,
+    342, 384, 367,
+    377, 439, 393,
+    406, 393, 439,
+    233, 128, 182,
+    189, 343, 410,
+    341, 410, 343,
+    254, 335, 361,
+    390, 361, 335,
+    237, 249, 238,
+    254, 216, 241,
+    394, 450, 420,
+    429, 420, 450,
+    176, 251, 192,
+    213, 192, 251,
+    219, 260, 245,
+    275, 245, 260,
+    35, 57, 36,
+    51, 36, 57,
+    439, 458, 418,
+    465, 418, 458,
+    147, 172, 165,
+    183, 165, 172,
+    455, 351, 463,
+    408, 330, 395,
+    421, 395, 330,
+    339, 381, 384,
+    398, 384, 381,
+    122, 148, 156,
+    205, 175, 248,
+    80, 76, 101,
+    83, 101, 76,
+    208, 242, 241,
+    256, 241, 242,
+    281, 304, 297,
+    303, 297, 304,
+    284, 231, 307,
+    263, 303, 364,
+    182, 181, 245,
+    283, 351, 231,
+    445, 219, 457,
+    463, 351, 470,
+    160, 167, 179,
+    208, 179, 167,
+    143, 132, 213,
+    192, 213, 132,
+    397, 268, 409,
+    148, 157, 156,
+    188, 156, 157,
+    404, 376, 365,
+    432, 462, 440,
+    453, 440, 462,
+    307, 231, 373,
+    351, 373, 231,
+    225, 203, 212,
+    410, 421, 189,
+    418, 465, 449,
+    471, 449, 465,
+    248, 175, 189,
+    409, 268, 330,
+    366, 378, 415,
+    415, 378, 423,
+    425, 423, 378,
+    212, 267, 430,
+    329, 430, 267,
+    430, 408, 212,
+    344, 301, 340,
+    176, 158, 212,
+    212, 301, 176,
+    251, 176, 301,
+    203, 188, 212,
+    204, 212, 188,
+    212, 408, 301,
+    340, 301, 408,
+    207, 225, 158,
+    212, 158, 225,
+    245, 336, 219,
+    457, 219, 336,
+    168, 218, 169,
+    230, 169, 218,
+    189, 213, 343,
+    250, 343, 213,
+    364, 303, 376,
+    365, 376, 303,
+    142, 143, 175,
+    189, 175, 143,
+    189, 421, 268,
+    330, 268, 421,
+    245, 349, 336,
+    293, 336, 349,
+    274, 470, 283,
+    351, 283, 470,
+    274, 273, 470,
+    273, 436, 470,
+    436, 414, 470,
+    464, 470, 414,
+    244, 274, 261,
+    283, 261, 274,
+    232, 258, 197,
+    197, 258, 349,
+    285, 349, 258,
+    181, 197, 245,
+    349, 245, 197,
+    333, 332, 304,
+    303, 304, 365,
+    332, 365, 304,
  })
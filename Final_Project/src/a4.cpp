@@ -17,6 +17,18 @@ using std::vector;
 bool BIH = true;
 bool PACKETS = true;
 bool INTERP = false;
+bool CACHE = true;
+bool FAST_SPHERES = true;
+bool FRUSTA = true;
+bool HYBRID = true;
+bool AUTOTUNE = false;
+bool PROFILE = false;
+bool HEATMAP = false;
+
+double HYBRID_COHERENCE = 0.5;
+int HYBRID_DEPTH = 4;
+
+RenderFunction RENDER = launch_qt;
 
 bool launch_qt(// What to render
                SceneNode* root,
@@ -9,6 +9,26 @@
 extern bool BIH;
 extern bool PACKETS;
 extern bool INTERP;
+extern bool CACHE;
+extern bool FAST_SPHERES;
+extern bool FRUSTA;
+extern bool HYBRID;
+
+// With HYBRID on, a packet without a frustum that reaches a node at least
+// HYBRID_DEPTH deep with fewer than HYBRID_COHERENCE of its live lanes
+// hitting it traces the rest of that subtree one ray at a time
+extern double HYBRID_COHERENCE;
+extern int HYBRID_DEPTH;
+
+// Pick the camera packet size by timing a few when rendering starts
+extern bool AUTOTUNE;
+
+// Keep hardware counters per render phase, see perfcounters.hpp
+extern bool PROFILE;
+
+// Time every camera packet, print how evenly the workers were loaded
+// after each frame and save a heatmap of tile costs with each image
+extern bool HEATMAP;
 
 bool launch_qt(// What to render
                SceneNode* root,
@@ -24,4 +44,13 @@ bool launch_qt(// What to render
                const std::list<Light*>& lights
                );
 
+// What gr.render calls. Headless drivers such as the benchmarks replace
+// launch_qt with their own function before running the scene script.
+typedef bool (*RenderFunction)(SceneNode* root, const std::string& filename,
+        int width, int height, const Point3D& eye, const Vector3D& view,
+        const Vector3D& up, double fov, const Colour& ambient,
+        const std::list<Light*>& lights);
+
+extern RenderFunction RENDER;
+
 #endif
@@ -0,0 +1,237 @@
+#include "animation.hpp"
+
+#include <ctype.h>
+#include <iostream>
+#include <stdio.h>
+#include <QElapsedTimer>
+
+#include "imagewriter.hpp"
+#include "tracejob.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::list;
+using std::string;
+using std::vector;
+
+Animation::Animation(SceneNode* root, const Camera& cam, const Colour& ambient,
+        const list<Light*>* lights, const string& pattern, int sampleWidth) :
+    m_root(root), m_cam(cam), m_ambient(ambient), m_lights(lights), m_pattern(pattern),
+    m_sampleWidth(sampleWidth),
+    m_pending(NULL), m_finished(false), m_failed(false),
+    m_updateNsecs(0), m_traceNsecs(0), m_encodeNsecs(0)
+{}
+
+bool Animation::checkPattern(const string& pattern) {
+    int conversions = 0;
+
+    for(size_t i = 0; i < pattern.size(); ++i) {
+        if(pattern[i] != '%') {
+            continue;
+        }
+
+        if(++i < pattern.size() && pattern[i] == '%') {
+            continue;
+        }
+
+        while(i < pattern.size() && isdigit(pattern[i])) {
+            ++i;
+        }
+
+        if(i >= pattern.size() || pattern[i] != 'd') {
+            return false;
+        }
+
+        ++conversions;
+    }
+
+    return conversions == 1;
+}
+
+// Updates and flattens the scene for a frame and builds everything
+// needed to trace it
+Animation::Frame* Animation::prepare(int number, UpdateFunction update, void* data) {
+    if(update != NULL && !update(number, data)) {
+        return NULL;
+    }
+
+    Frame* frame = new Frame();
+    frame->number = number;
+
+    frame->primitives = new vector<Primitive*>();
+    m_root->getPrimitives(frame->primitives);
+
+    frame->tracer = new Tracer(frame->primitives, m_ambient, m_lights);
+    frame->buffer = new FrameBuffer(m_cam.getWidth(), m_cam.getHeight());
+    frame->packets = CameraPacket::genPackets(frame->buffer, frame->tracer, m_cam, m_sampleWidth);
+
+    return frame;
+}
+
+// Frees everything but the traced colours, which the encoder still needs
+void Animation::releaseScene(Frame* frame) {
+    CameraPacket::deletePackets(frame->packets);
+    delete frame->tracer;
+
+    for(auto it = frame->primitives->begin(); it != frame->primitives->end(); ++it) {
+        delete *it;
+    }
+
+    delete frame->primitives;
+}
+
+/*  render
+ *
+ *  The workers for a frame are started before the next frame is
+ *  prepared on this thread, so the update, flattening and BIH build of
+ *  frame k + 1 overlap the tracing of frame k. The update runs here
+ *  because it may call back into the scene script. A traced frame waits
+ *  for the encoder only if the frame before it is still being saved.
+ */
+bool Animation::render(int numFrames, UpdateFunction update, void* data) {
+    m_pending = NULL;
+    m_finished = false;
+    m_failed = false;
+    m_updateNsecs = m_traceNsecs = m_encodeNsecs = 0;
+
+    pthread_mutex_init(&m_encodeMutex, NULL);
+    pthread_cond_init(&m_encodeCond, NULL);
+    pthread_create(&m_encoder, NULL, encoder_bootstrap, this);
+
+    QElapsedTimer total;
+    total.start();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    Frame* next = (numFrames > 0) ? prepare(1, update, data) : NULL;
+    long long updateNsecs = timer.nsecsElapsed();
+    m_updateNsecs += updateNsecs;
+
+    bool stopped = numFrames > 0 && next == NULL;
+
+    while(next != NULL) {
+        Frame* frame = next;
+        next = NULL;
+
+        timer.start();
+
+        TraceJob job(frame->packets, NUMTHREADS);
+        job.start();
+
+        long long nextUpdateNsecs = 0;
+
+        if(frame->number < numFrames) {
+            QElapsedTimer updateTimer;
+            updateTimer.start();
+
+            next = prepare(frame->number + 1, update, data);
+            stopped = next == NULL;
+
+            nextUpdateNsecs = updateTimer.nsecsElapsed();
+            m_updateNsecs += nextUpdateNsecs;
+        }
+
+        job.finish();
+
+        long long traceNsecs = timer.nsecsElapsed();
+        m_traceNsecs += traceNsecs;
+
+        cout << "Frame " << frame->number << ": update " << updateNsecs / 1000000
+            << " ms, trace " << traceNsecs / 1000000 << " ms" << endl;
+
+        releaseScene(frame);
+        queue(frame);
+
+        updateNsecs = nextUpdateNsecs;
+    }
+
+    pthread_mutex_lock(&m_encodeMutex);
+    m_finished = true;
+    pthread_cond_broadcast(&m_encodeCond);
+    pthread_mutex_unlock(&m_encodeMutex);
+
+    pthread_join(m_encoder, NULL);
+
+    pthread_cond_destroy(&m_encodeCond);
+    pthread_mutex_destroy(&m_encodeMutex);
+
+    long long totalNsecs = total.nsecsElapsed();
+    long long stageNsecs = m_updateNsecs + m_traceNsecs + m_encodeNsecs;
+
+    cout << "Animation: " << totalNsecs / 1000000 << " ms, update and build "
+        << m_updateNsecs / 1000000 << " ms, trace " << m_traceNsecs / 1000000 << " ms, encode "
+        << m_encodeNsecs / 1000000 << " ms, " << (stageNsecs - totalNsecs) / 1000000
+        << " ms overlapped" << endl;
+
+    return !stopped && !m_failed;
+}
+
+void Animation::queue(Frame* frame) {
+    pthread_mutex_lock(&m_encodeMutex);
+
+    while(m_pending != NULL) {
+        pthread_cond_wait(&m_encodeCond, &m_encodeMutex);
+    }
+
+    m_pending = frame;
+    pthread_cond_broadcast(&m_encodeCond);
+    pthread_mutex_unlock(&m_encodeMutex);
+}
+
+void* Animation::encoder_bootstrap(void* animation) {
+    ((Animation*)animation)->encodeFrames();
+    return NULL;
+}
+
+void Animation::encodeFrames() {
+    while(true) {
+        pthread_mutex_lock(&m_encodeMutex);
+
+        while(m_pending == NULL && !m_finished) {
+            pthread_cond_wait(&m_encodeCond, &m_encodeMutex);
+        }
+
+        Frame* frame = m_pending;
+        m_pending = NULL;
+
+        pthread_cond_broadcast(&m_encodeCond);
+        pthread_mutex_unlock(&m_encodeMutex);
+
+        if(frame == NULL) {
+            return;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        bool ok = save(frame);
+
+        pthread_mutex_lock(&m_encodeMutex);
+        m_encodeNsecs += timer.nsecsElapsed();
+        m_failed = m_failed || !ok;
+        pthread_mutex_unlock(&m_encodeMutex);
+
+        delete frame->buffer;
+        delete frame;
+    }
+}
+
+bool Animation::save(Frame* frame) {
+    vector<char> name(m_pattern.size() + 32);
+    snprintf(&name[0], name.size(), m_pattern.c_str(), frame->number);
+
+    string filename(&name[0]);
+    const FrameBuffer& buffer = *frame->buffer;
+
+    ImageWriter writer;
+    bool ok = writer.open(filename, buffer.width(), buffer.height()) &&
+        writer.writeRows(buffer) && writer.close();
+
+    if(!ok) {
+        cerr << "Could not save " << filename << endl;
+    }
+
+    return ok;
+}
@@ -0,0 +1,86 @@
+#ifndef CS488_ANIMATION_HPP
+#define CS488_ANIMATION_HPP
+
+#include <list>
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+#include "algebra.hpp"
+#include "camera.hpp"
+#include "framebuffer.hpp"
+#include "light.hpp"
+#include "packet.hpp"
+#include "primitive.hpp"
+#include "scene.hpp"
+#include "tracer.hpp"
+
+// Renders a sequence of frames of a scene headlessly, one file per
+// frame. Frames go through three stages that run at the same time on
+// different frames: while frame k is traced, the scene is updated and
+// flattened and its BIH built for frame k + 1, and frame k - 1 is saved
+// on the encoder thread.
+class Animation {
+public:
+    // Called with each frame's number, from 1, before the scene is
+    // flattened for it. It may change the scene but not the primitives
+    // of earlier frames. Returning false stops the animation.
+    typedef bool (*UpdateFunction)(int frame, void* data);
+
+    // pattern is the file name of each frame, with one %d for the frame
+    // number. Its extension picks the format as in saved images.
+    // sampleWidth is the samples per pixel along each axis.
+    Animation(SceneNode* root, const Camera& cam, const Colour& ambient,
+            const std::list<Light*>* lights, const std::string& pattern, int sampleWidth);
+
+    // Renders frames 1 to numFrames. Returns false if an update or a
+    // save failed.
+    bool render(int numFrames, UpdateFunction update, void* data);
+
+    // Whether pattern has exactly one %d, which may have a width as in
+    // %04d. %% is a literal %.
+    static bool checkPattern(const std::string& pattern);
+
+private:
+    struct Frame {
+        int number;
+
+        std::vector<Primitive*>* primitives;
+        Tracer* tracer;
+        FrameBuffer* buffer;
+        std::vector<CameraPacket*>* packets;
+    };
+
+    Frame* prepare(int number, UpdateFunction update, void* data);
+    void releaseScene(Frame* frame);
+
+    static void* encoder_bootstrap(void* animation);
+    void encodeFrames();
+    void queue(Frame* frame);
+    bool save(Frame* frame);
+
+    SceneNode* m_root;
+    Camera m_cam;
+    Colour m_ambient;
+    const std::list<Light*>* m_lights;
+    std::string m_pattern;
+    int m_sampleWidth;
+
+    // The frame waiting for the encoder, which takes one at a time
+    Frame* m_pending;
+    bool m_finished;
+    bool m_failed;
+
+    pthread_t m_encoder;
+    pthread_mutex_t m_encodeMutex;
+    pthread_cond_t m_encodeCond;
+
+    // Time spent in each stage over every frame
+    long long m_updateNsecs;
+    long long m_traceNsecs;
+    long long m_encodeNsecs;
+
+    static const int NUMTHREADS = 8;
+};
+
+#endif
@@ -2,11 +2,70 @@
 #include <iostream>
 
 #include "bbox.hpp"
+#include "a4.hpp"
+#include "simd.hpp"
 
 using std::cout;
 using std::endl;
 using std::vector;
 
+// Reciprocals of direction components nearer zero than this are clamped,
+// so a lane parallel to a slab gets huge distances rather than NaN
+#define MIN_DIRECTION 1.0e-15
+
+// ********************** LaneRays *****************************
+
+LaneRays::LaneRays(Packet& packet) {
+    vector<Ray*>* rays = packet.getRays();
+    m_numLanes = rays->size();
+
+    // Lanes past the last group of four, and those with no ray, never hit
+    int padded = (m_numLanes + 3) & ~3;
+
+    for(int i = 0; i < padded; ++i) {
+        Ray* ray = i < m_numLanes ? rays->at(i) : NULL;
+
+        if(ray == NULL) {
+            for(int axis = 0; axis < 3; ++axis) {
+                m_origin[axis][i] = 0.0;
+                m_dirReciproc[axis][i] = 0.0;
+            }
+
+            m_far[i] = -1.0;
+            continue;
+        }
+
+        const Point3D& origin = ray->getOrigin();
+        const Vector3D& dir = ray->getDirection();
+
+        for(int axis = 0; axis < 3; ++axis) {
+            m_origin[axis][i] = origin[axis];
+            m_dirReciproc[axis][i] = 1.0 / (fabs(dir[axis]) > MIN_DIRECTION ? dir[axis] :
+                    copysign(MIN_DIRECTION, dir[axis]));
+        }
+
+        m_far[i] = ray->hasEndpoint() ? ray->getLength() : std::numeric_limits<double>::infinity();
+    }
+}
+
+void LaneRays::updateFar(const LaneMask& active, const vector<bool>& v_hit,
+        const vector<Intersection>* v_isect)
+{
+    if(v_isect == NULL) {
+        return;
+    }
+
+    LaneIterator it(active);
+
+    for(int i = it.next(); i >= 0; i = it.next()) {
+        if(v_hit.at(i)) {
+            m_far[i] = fmin(m_far[i], v_isect->at(i).getParam());
+        }
+    }
+}
+
+// ********************** AABB *****************************
+
 AABB::AABB(Point3D min, Point3D max) {
     m_min = min;
     m_max = max;
@@ -90,31 +149,54 @@ bool AABB::allMiss(const Packet& packet) {
     }
 }
 
-int AABB::packetTest(Packet& packet, int firstActive) {
-    vector<Ray*>* rays = packet.getRays();
-    int n = rays->size();
-    
-    while(rays->at(firstActive) == NULL) {
-        if(++firstActive == n) {
-            return n;
-        }
+/*  packetTest
+ *
+ *  Clears the lanes of active that don't reach the box before their far
+ *  distance, and sets enter to where each lane that is kept enters it.
+ *  Packets with a frustum are rejected against it before any ray is
+ *  tested. The slab test then runs on four lanes at a time, skipping
+ *  groups with no active lane.
+ */
+void AABB::packetTest(Packet& packet, const LaneRays& lanes, LaneMask* active, double* enter) const {
+    const Frustum& frustum = packet.getFrustum();
+
+    if(FRUSTA && frustum.isValid() && frustum.cullsBox(m_min, m_max)) {
+        *active = LaneMask(lanes.m_numLanes);
+        return;
     }
 
-    if(intersect(*rays->at(firstActive)) || contains(*rays->at(firstActive))) {
-        return firstActive;
-    }
+    SimdDouble zero(0.0);
 
-    if(allMiss(packet)) {
-        return n;
-    }
+    for(int base = 0; base < lanes.m_numLanes; base += 4) {
+        unsigned int bits = active->getFour(base);
 
-    for(int i = firstActive + 1; i < n; i++) {
-        if(rays->at(i) != NULL && (intersect(*rays->at(i)) || contains(*rays->at(i)))) {
-            return i;
+        if(bits == 0) {
+            continue;
         }
-    }
 
-    return n;
+        unsigned int hits = 0;
+
+        for(int k = base; k < base + 4; k += SimdDouble::WIDTH) {
+            SimdDouble t_near = zero;
+            SimdDouble t_far = SimdDouble::load(&lanes.m_far[k]);
+
+            for(int axis = 0; axis < 3; ++axis) {
+                SimdDouble o = SimdDouble::load(&lanes.m_origin[axis][k]);
+                SimdDouble r = SimdDouble::load(&lanes.m_dirReciproc[axis][k]);
+
+                SimdDouble t1 = (SimdDouble(m_min[axis]) - o) * r;
+                SimdDouble t2 = (SimdDouble(m_max[axis]) - o) * r;
+
+                t_near = simdMax(t_near, simdMin(t1, t2));
+                t_far = simdMin(t_far, simdMax(t1, t2));
+            }
+
+            t_near.store(&enter[k]);
+            hits |= (t_near <= t_far).bits() << (k - base);
+        }
+
+        active->clearFour(base, bits & ~hits);
+    }
 }
 
 bool AABB::intersect(const Ray& ray) const{
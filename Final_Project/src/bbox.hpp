@@ -5,6 +5,28 @@
 #include "algebra.hpp"
 #include "packet.hpp"
 #include "interval.hpp"
+#include "lanemask.hpp"
+#include "intersection.hpp"
+
+#include <vector>
+
+// The rays of a packet laid out a lane per element, so a box can be
+// tested against several lanes at once. A lane's far distance is where
+// its ray ends, or its closest hit so far.
+struct LaneRays {
+    LaneRays(Packet& packet);
+
+    // Moves the far distance of each closest hit lane of active in to
+    // its hit
+    void updateFar(const LaneMask& active, const std::vector<bool>& v_hit,
+            const std::vector<Intersection>* v_isect);
+
+    int m_numLanes;
+
+    double m_origin[3][MAX_LANES];
+    double m_dirReciproc[3][MAX_LANES];
+    double m_far[MAX_LANES];
+};
 
 class AABB{
 public:
@@ -16,7 +38,7 @@ public:
     AABB& operator=(const AABB& other);
 
     bool allMiss(const Packet& packet);
-    int packetTest(Packet& packet, int firstActive);
+    void packetTest(Packet& packet, const LaneRays& lanes, LaneMask* active, double* enter) const;
 
     bool intersect(const Ray& ray) const;
     bool contains(const Ray& ray) const;
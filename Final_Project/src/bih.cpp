@@ -1,7 +1,9 @@
 #include "bih.hpp"
 #include "algebra.hpp"
+#include "a4.hpp"
 
 #include <iostream>
+#include <math.h>
 #include <stdlib.h>
 #include <stack>
 
@@ -15,16 +17,16 @@ using std::stack;
 
 // ********************** BIHTree *****************************
 
-BIHTree::BIHTree(Primitive** primitives, int size) :
-    m_primitives(primitives), m_numPrimitives(size)
-{
+BIHTree::BIHTree(vector<Primitive*>* primitives) {
+    m_pool = new PrimitivePool(primitives);
+
     initGlobalBBox();
-    m_root = new BIHNode(m_primitives, size, m_globalBBox);
+    m_root = new BIHNode(0, m_pool->getNumRefs(), m_globalBBox);
 
     stack<BIHNode*>* nodes = new stack<BIHNode*>();
     stack<AABB>* bboxes = new stack<AABB>();
     
-    m_root->buildHierarchy(nodes, bboxes, m_globalBBox);
+    m_root->buildHierarchy(m_pool, nodes, bboxes, m_globalBBox);
 
     while(nodes->size() > 0) {
         BIHNode* node = nodes->top();
@@ -32,104 +34,196 @@ BIHTree::BIHTree(Primitive** primitives, int size) :
         AABB bbox = bboxes->top();
         bboxes->pop();
 
-        node->buildHierarchy(nodes, bboxes, bbox);
+        node->buildHierarchy(m_pool, nodes, bboxes, bbox);
     }
 
     delete nodes;
     delete bboxes;
+
+    m_pool->releaseBounds();
 }
 
 BIHTree::~BIHTree() {
     delete m_root;
-    delete m_primitives;
+    delete m_pool;
 }
 
 bool BIHTree::getIntersection(const Ray& ray, Intersection* isect) {
-    bool hit = m_root->getIntersection(ray, isect);
+    bool hit = m_root->getIntersection(*m_pool, ray, isect);
     return hit;
 }
 
 namespace {
     struct Node{
-        Node(BIHNode* node, int firstActive) :
-            m_node(node), m_firstActive(firstActive) {}
-
         BIHNode* m_node;
-        int m_firstActive;
+        LaneMask m_active;
+
+        // Where each active lane entered the parent, so none reaches the
+        // node before it. Rounded down to keep the cull conservative.
+        float m_enter[MAX_LANES];
     };
 }
 
+static float roundDown(double d) {
+    float f = (float)d;
+    return f > d ? nextafterf(f, -HUGE_VALF) : f;
+}
+
+/*  getIntersection
+ *
+ *  Each node is visited with the mask of lanes that may reach it, and
+ *  only those lanes are tested against its primitives. Every active lane
+ *  is tested against the node's box, out to its closest hit so far, and
+ *  the ones that miss are cleared. Shadow rays leave the mask as soon as
+ *  they hit anything, and traversal ends once every one has. Nearer
+ *  children go first, so when a far child comes off the stack, lanes
+ *  whose closest hit is nearer than where they entered the parent are
+ *  dropped without a box test.
+ *
+ *  Packets without a frustum, such as reflections, spread out as they go
+ *  down the tree. If fewer than HYBRID_COHERENCE of the live lanes reach
+ *  a node, the packet has stopped being coherent and its lanes trace the
+ *  subtree one at a time. Packets with a frustum stay whole, since it
+ *  rejects a subtree in one test however few lanes are left.
+ */
 void BIHTree::getIntersection(Packet& packet, vector<bool>& v_hit, vector<Intersection>* v_isect) {
-    BIHNode* node = m_root;
-    int firstActive = 0;
-   
     vector<Ray*>* rays = packet.getRays();
     int n = rays->size();
 
-    stack<Node> hitNodes;
+    LaneMask alive(n);
 
     for(int i = 0; i < n; i++) {
         v_hit.at(i) = false;
+
+        if(rays->at(i) != NULL) {
+            alive.set(i);
+        }
     }
 
+    LaneRays lanes(packet);
+    double enter[MAX_LANES];
+
+    BIHNode* node = m_root;
+    LaneMask active = alive;
+
+    bool hybrid = HYBRID && !(FRUSTA && packet.getFrustum().isValid());
+
+    // At most one far child per level is waiting
+    Node hitNodes[MAX_DEPTH + 1];
+    int numHitNodes = 0;
+
     while(true) {
-        firstActive = node->m_bbox.packetTest(packet, firstActive);
+        node->m_bbox.packetTest(packet, lanes, &active, enter);
+        int firstActive = active.first();
+
+        if(firstActive >= 0) {
+            if(hybrid && node->getDepth() >= HYBRID_DEPTH &&
+                    active.count() < HYBRID_COHERENCE * alive.count())
+            {
+                traceLanes(node, packet, active, &alive, v_hit, v_isect);
+                lanes.updateFar(active, v_hit, v_isect);
 
-        if(firstActive < n) {
-            if(node->m_type != BIHNode::Type::leaf) {
+            } else if(node->m_type != BIHNode::Type::leaf) {
                 Ray* nextRay = rays->at(firstActive);
-                
                 int first = node->traversalOrder(*nextRay);
-                hitNodes.push(Node(node->m_children + (1 - first), firstActive));
+
+                Node& far = hitNodes[numHitNodes++];
+                far.m_node = node->m_children + (1 - first);
+                far.m_active = active;
+
+                LaneIterator it(active);
+
+                for(int i = it.next(); i >= 0; i = it.next()) {
+                    far.m_enter[i] = roundDown(enter[i]);
+                }
 
                 node = node->m_children + first;
                 continue;
 
             } else {
-                for(int i = 0; i < node->m_numPrimitives; i++) {
-                    node->m_primitives[i]->getIntersection(packet, firstActive, v_hit, v_isect);
+                LaneMask done = active;
+                int end = node->m_first + node->m_numPrimitives;
+
+                for(int i = node->m_first; i < end && active.any(); i++) {
+                    m_pool->getIntersection(m_pool->getRef(i), packet, active, v_hit, v_isect);
                 }
+
+                lanes.updateFar(done, v_hit, v_isect);
+
+                // Only shadow rays are cleared from the mask by a hit
+                done.remove(active);
+                alive.remove(done);
             }
         }
 
-        if(hitNodes.empty()) {
-            return;
-        }
+        while(true) {
+            if(numHitNodes == 0 || !alive.any()) {
+                return;
+            }
+
+            const Node& next = hitNodes[--numHitNodes];
+
+            node = next.m_node;
+            active = next.m_active;
+            active &= alive;
 
-        if(v_isect == NULL) {
-            bool allHit = true;
+            if(v_isect != NULL) {
+                LaneIterator it(active);
 
-            for(int i = 0; i < n; i++) {
-                if(!v_hit.at(i)) {
-                    allHit = false;
-                    break;
+                for(int i = it.next(); i >= 0; i = it.next()) {
+                    if(lanes.m_far[i] < next.m_enter[i]) {
+                        active.clear(i);
+                    }
                 }
             }
 
-            if(allHit) {
-                return;
+            if(active.any()) {
+                break;
             }
         }
+    }
+}
 
-        Node next = hitNodes.top();
-        hitNodes.pop();
+/*  traceLanes
+ *
+ *  Traces each active lane through the subtree under node on its own.
+ *  Hits are recorded as in the packet path: closest hit rays are
+ *  shortened, and shadow rays leave alive.
+ */
+void BIHTree::traceLanes(BIHNode* node, Packet& packet, const LaneMask& active, LaneMask* alive,
+        vector<bool>& v_hit, vector<Intersection>* v_isect)
+{
+    vector<Ray*>* rays = packet.getRays();
+    LaneIterator it(active);
 
-        node = next.m_node;
-        firstActive = next.m_firstActive;
+    for(int i = it.next(); i >= 0; i = it.next()) {
+        Ray* ray = rays->at(i);
+        Intersection* isect = v_isect == NULL ? NULL : &v_isect->at(i);
+
+        if(!node->getIntersection(*m_pool, *ray, isect)) {
+            continue;
+        }
+
+        v_hit.at(i) = true;
+
+        if(isect != NULL) {
+            rays->at(i) = new Ray(ray->shorten(isect->getPoint()));
+            delete ray;
+        } else {
+            alive->clear(i);
+        }
     }
 }
 
 void BIHTree::initGlobalBBox() {
-    AABB* bbox = m_primitives[0]->getWorldBBox();
+    Point3D min = m_pool->getBounds(0).getMin();
+    Point3D max = m_pool->getBounds(0).getMax();
 
-    Point3D min = bbox->m_min;
-    Point3D max = bbox->m_max; 
-    
-    for(int i = 0; i < m_numPrimitives; ++i) {
-        bbox = m_primitives[i]->getWorldBBox();
+    for(int i = 0; i < m_pool->getNumRefs(); ++i) {
+        const Bounds& bounds = m_pool->getBounds(i);
 
-        min = Point3D::min(min, bbox->m_min);
-        max = Point3D::max(max, bbox->m_max);
+        min = Point3D::min(min, bounds.getMin());
+        max = Point3D::max(max, bounds.getMax());
     }
 
     m_globalBBox = AABB(min, max);
@@ -137,8 +231,8 @@ void BIHTree::initGlobalBBox() {
 
 // ********************** BIHNode *****************************
 
-BIHNode::BIHNode(Primitive** primitives, int size, const AABB& bbox, int depth) :
-    m_primitives(primitives), m_numPrimitives(size), m_bbox(bbox), m_depth(depth)
+BIHNode::BIHNode(int first, int size, const AABB& bbox, int depth) :
+    m_first(first), m_numPrimitives(size), m_bbox(bbox), m_depth(depth)
 {
     m_type = Type::leaf;
 }
@@ -150,7 +244,9 @@ BIHNode::~BIHNode() {
     }
 }
 
-void BIHNode::buildHierarchy(stack<BIHNode*>* nodes, stack<AABB>* bboxes, const AABB& uniformBBox) {
+void BIHNode::buildHierarchy(PrimitivePool* pool, stack<BIHNode*>* nodes, stack<AABB>* bboxes,
+        const AABB& uniformBBox)
+{
     if(m_type != Type::leaf) {
         cerr << "Trying to expand an inner node" << endl;
         exit(1);
@@ -161,46 +257,46 @@ void BIHNode::buildHierarchy(stack<BIHNode*>* nodes, stack<AABB>* bboxes, const
 
     double median = uniformBBox.getMedian(axis);
 
-    int i = 0;
-    int j = m_numPrimitives - 1;
+    int i = m_first;
+    int j = m_first + m_numPrimitives - 1;
 
     double leftMax = m_bbox.m_min[axis];
     double rightMin = m_bbox.m_max[axis];
 
     while(i <= j) {
-        AABB* i_bbox = m_primitives[i]->getWorldBBox();
-        double i_mid = i_bbox->getMedian(axis);
+        const Bounds& i_bounds = pool->getBounds(i);
+        double i_mid = i_bounds.getMedian(axis);
 
         if(i_mid <= median) {
             ++i;
-            leftMax = fmax(i_bbox->m_max[axis], leftMax);
+            leftMax = fmax(i_bounds.m_max[axis], leftMax);
             continue;
         }
 
         while(i <= j) {
-            AABB* j_bbox = m_primitives[j]->getWorldBBox();
-            double j_mid = j_bbox->getMedian(axis);
+            const Bounds& j_bounds = pool->getBounds(j);
+            double j_mid = j_bounds.getMedian(axis);
 
             if(j_mid > median) {
                 --j;
-                rightMin = fmin(j_bbox->m_min[axis], rightMin);
+                rightMin = fmin(j_bounds.m_min[axis], rightMin);
             
             } else {
-                Primitive* temp = m_primitives[i];
-                m_primitives[i] = m_primitives[j];
-                m_primitives[j] = temp;
-
+                pool->swapRefs(i, j);
                 break;
             }
         }
     }
    
-    Primitive** primitives = m_primitives;
+    int first = m_first;
     int numPrimitives = m_numPrimitives;
+
+    // Number of refs on the left
+    i -= first;
     
     m_children = new BIHNode[2] 
-        { BIHNode(primitives, i, getLeftBBox(m_bbox, leftMax), m_depth + 1), 
-            BIHNode(primitives + i, numPrimitives - i, getRightBBox(m_bbox, rightMin), m_depth + 1) };
+        { BIHNode(first, i, getLeftBBox(m_bbox, leftMax), m_depth + 1), 
+            BIHNode(first + i, numPrimitives - i, getRightBBox(m_bbox, rightMin), m_depth + 1) };
     
     m_planes = new double[2] { leftMax, rightMin };    
 
@@ -222,12 +318,12 @@ int BIHNode::traversalOrder(const Ray& ray) {
     return (direction[(int)m_type] > 0) ? 0 : 1;
 }
 
-bool BIHNode::getIntersection(const Ray& ray, Intersection* isect) {
+bool BIHNode::getIntersection(const PrimitivePool& pool, const Ray& ray, Intersection* isect) {
     if( !(m_bbox.intersect(ray) || m_bbox.contains(ray)) ) {
         return false;
 
     } else if(m_type == Type::leaf) {
-        return getLeafIntersection(ray, isect);
+        return getLeafIntersection(pool, ray, isect);
     }   
     
     Vector3D direction = ray.getDirection();
@@ -235,12 +331,12 @@ bool BIHNode::getIntersection(const Ray& ray, Intersection* isect) {
     int first = (direction[(int)m_type] > 0) ? 0 : 1;
 
     Intersection* t_isect = (isect == NULL) ? NULL : new Intersection();
-    bool hit = m_children[first].getIntersection(ray, t_isect);
+    bool hit = m_children[first].getIntersection(pool, ray, t_isect);
 
     bool hitAny = hit;
-    Ray newRay = (hit && isect != NULL) ? Ray(ray.getOrigin(), t_isect->getPoint()) : ray;
+    Ray newRay = (hit && isect != NULL) ? ray.shorten(t_isect->getPoint()) : ray;
     
-    hit = m_children[(first+1)%2].getIntersection(newRay, t_isect);
+    hit = m_children[(first+1)%2].getIntersection(pool, newRay, t_isect);
 
     hitAny = hitAny || hit;
 
@@ -254,18 +350,20 @@ bool BIHNode::getIntersection(const Ray& ray, Intersection* isect) {
     return hitAny;
 }
 
-bool BIHNode::getLeafIntersection(const Ray& ray, Intersection* isect) {
+bool BIHNode::getLeafIntersection(const PrimitivePool& pool, const Ray& ray, Intersection* isect) {
     Ray testRay = ray;
 
     Intersection* best = (isect == NULL) ? NULL : new Intersection();
     bool hitAny = false;
 
-    for(int i = 0; i < m_numPrimitives; i++) {
-        bool hit = m_primitives[i]->getIntersection(testRay, best);
+    int end = m_first + m_numPrimitives;
+
+    for(int i = m_first; i < end; i++) {
+        bool hit = pool.getIntersection(pool.getRef(i), testRay, best);
 
         if(isect != NULL && hit) {
             hitAny = true;
-            testRay = Ray(testRay.getOrigin(), best->getPoint());
+            testRay = testRay.shorten(best->getPoint());
 
         } else if(hit) {
             return true;
@@ -4,6 +4,7 @@
 #include "primitive.hpp"
 #include "ray.hpp"
 #include "intersection.hpp"
+#include "pool.hpp"
 
 #include <vector>
 #include <stack>
@@ -12,32 +13,36 @@ class BIHNode;
 
 class BIHTree {
 public:
-    BIHTree(Primitive** primitives, int size);
+    BIHTree(std::vector<Primitive*>* primitives);
     virtual ~BIHTree();
 
     bool getIntersection(const Ray& ray, Intersection* isect);
     void getIntersection(Packet& packet, std::vector<bool>& v_hit, std::vector<Intersection>* v_isect); 
 
 private:
+    void traceLanes(BIHNode* node, Packet& packet, const LaneMask& active, LaneMask* alive,
+            std::vector<bool>& v_hit, std::vector<Intersection>* v_isect);
     void initGlobalBBox();
 
     BIHNode* m_root;
     AABB m_globalBBox;
-   
-    Primitive** m_primitives;
-    int m_numPrimitives;
+
+    PrimitivePool* m_pool;
 };
 
 class BIHNode {
 public:
-    BIHNode(Primitive** primitives, int size, const AABB& bbox, int depth = 0);
+    BIHNode(int first, int size, const AABB& bbox, int depth = 0);
     virtual ~BIHNode();
 
-    void buildHierarchy(std::stack<BIHNode*>* nodes, std::stack<AABB>* bboxes, const AABB& uniformBBox);
+    void buildHierarchy(PrimitivePool* pool, std::stack<BIHNode*>* nodes, std::stack<AABB>* bboxes,
+            const AABB& uniformBBox);
 
-    bool getIntersection(const Ray& ray, Intersection* isect);
+    bool getIntersection(const PrimitivePool& pool, const Ray& ray, Intersection* isect);
     int traversalOrder(const Ray& ray);
 
+    int getDepth() const { return m_depth; }
+
     enum Type {
         x_axis,
         y_axis,
@@ -47,9 +52,10 @@ public:
 
     Type m_type;
 
+    // Leaves hold the pool refs from m_first to m_first + m_numPrimitives
     union {
         BIHNode* m_children;
-        Primitive** m_primitives;
+        int m_first;
     };
    
     union { 
@@ -60,7 +66,7 @@ public:
     AABB m_bbox;
 
 private:
-    bool getLeafIntersection(const Ray& ray, Intersection* isect);
+    bool getLeafIntersection(const PrimitivePool& pool, const Ray& ray, Intersection* isect);
 
     Type chooseAxis(const AABB& bbox);
     AABB getLeftBBox(const AABB& bbox, double plane);
@@ -0,0 +1,106 @@
+#include "budget.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+using std::cout;
+using std::endl;
+using std::min;
+
+// Weight given to the newest frame when smoothing the cost estimate
+#define SMOOTHING 0.3
+
+// Only step up when the prediction leaves this much of the deadline free
+#define HEADROOM 0.8
+
+//************************** FrameSettings ******************************
+
+FrameSettings::FrameSettings() :
+    sampleWidth(1), scale(1.0), maxDepth(5)
+{}
+
+FrameSettings::FrameSettings(int sampleWidth, double scale, int maxDepth) :
+    sampleWidth(sampleWidth), scale(scale), maxDepth(maxDepth)
+{}
+
+bool FrameSettings::operator==(const FrameSettings& other) const {
+    return sampleWidth == other.sampleWidth && scale == other.scale &&
+        maxDepth == other.maxDepth;
+}
+
+double FrameSettings::getCost() const {
+    return sampleWidth * sampleWidth * scale * scale * (1.0 + 0.25 * maxDepth);
+}
+
+//*************************** FrameBudget *******************************
+
+FrameBudget::FrameBudget(int deadline, int sampleWidth, int maxDepth) :
+    m_level(0), m_deadline(deadline), m_unitCost(-1.0)
+{
+    setLimits(sampleWidth, maxDepth);
+}
+
+void FrameBudget::setLimits(int sampleWidth, int maxDepth) {
+    m_levels.clear();
+
+    for(int width = sampleWidth; width >= 1; --width) {
+        m_levels.push_back(FrameSettings(width, 1.0, maxDepth));
+    }
+
+    int lowDepth = min(maxDepth, 2);
+
+    m_levels.push_back(FrameSettings(1, 1.0, lowDepth));
+    m_levels.push_back(FrameSettings(1, 0.75, lowDepth));
+    m_levels.push_back(FrameSettings(1, 0.5, lowDepth));
+    m_levels.push_back(FrameSettings(1, 0.5, min(maxDepth, 1)));
+    m_levels.push_back(FrameSettings(1, 0.35, min(maxDepth, 1)));
+    m_levels.push_back(FrameSettings(1, 0.25, 0));
+
+    m_level = 0;
+}
+
+double FrameBudget::predict(int level) const {
+    return m_unitCost * m_levels.at(level).getCost();
+}
+
+void FrameBudget::update(int elapsed, double tracedFraction) {
+    if(tracedFraction > 0.0) {
+        double unitCost = elapsed / (tracedFraction * getSettings().getCost());
+
+        if(m_unitCost < 0.0) {
+            m_unitCost = unitCost;
+        } else {
+            m_unitCost = SMOOTHING * unitCost + (1.0 - SMOOTHING) * m_unitCost;
+        }
+    }
+
+    if(m_unitCost < 0.0) {
+        return;
+    }
+
+    int last = m_levels.size() - 1;
+    int level = m_level;
+
+    if(elapsed > m_deadline) {
+        while(level < last && predict(level) > m_deadline) {
+            ++level;
+        }
+
+        if(level == m_level && level < last) {
+            ++level;
+        }
+
+    } else {
+        while(level > 0 && predict(level - 1) < HEADROOM * m_deadline) {
+            --level;
+        }
+    }
+
+    if(level != m_level) {
+        m_level = level;
+
+        const FrameSettings& settings = getSettings();
+        cout << "Frame budget: " << settings.sampleWidth << "x" << settings.sampleWidth 
+            << " samples, scale " << settings.scale << ", depth " << settings.maxDepth << endl;
+    }
+}
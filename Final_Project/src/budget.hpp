@@ -0,0 +1,52 @@
+#ifndef CS488_BUDGET_HPP
+#define CS488_BUDGET_HPP
+
+#include <vector>
+
+// Settings that trade image quality for render time
+struct FrameSettings {
+    FrameSettings();
+    FrameSettings(int sampleWidth, double scale, int maxDepth);
+
+    bool operator==(const FrameSettings& other) const;
+    bool operator!=(const FrameSettings& other) const { return !(*this == other); }
+
+    // Cost of a full frame relative to one sample per pixel at full size
+    double getCost() const;
+
+    int sampleWidth;
+    double scale;
+    int maxDepth;
+};
+
+// Chooses frame settings so that frames finish before a deadline.
+// Levels run from full quality down to the cheapest. The budget steps
+// down as soon as a frame runs over, and only steps back up once a full
+// frame at a higher level is predicted to fit.
+class FrameBudget {
+public:
+    FrameBudget(int deadline, int sampleWidth, int maxDepth);
+
+    void setDeadline(int deadline) { m_deadline = deadline; }
+    void setLimits(int sampleWidth, int maxDepth);
+
+    const FrameSettings& getSettings() const { return m_levels.at(m_level); }
+    const FrameSettings& getFullSettings() const { return m_levels.at(0); }
+
+    // elapsed is the frame time in ms and tracedFraction the fraction of
+    // the frame's rays that actually had to be traced
+    void update(int elapsed, double tracedFraction);
+
+private:
+    double predict(int level) const;
+
+    std::vector<FrameSettings> m_levels;
+    int m_level;
+
+    int m_deadline;
+
+    // Smoothed ms per unit of FrameSettings::getCost()
+    double m_unitCost;
+};
+
+#endif
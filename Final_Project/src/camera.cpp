@@ -39,7 +39,14 @@ Ray* Camera::getRay(double xPos, double yPos) const{
     Point3D pk(xPos, yPos, 0.0);
     Point3D pWorld = m_screenToWorld * pk;
 
-    return new Ray(m_eye, pWorld - m_eye);
+    Ray* ray = new Ray(m_eye, pWorld - m_eye);
+    ray->setCone(0.0, getPixelSpread());
+
+    return ray;
+}
+
+double Camera::getPixelSpread() const {
+    return 2.0 * tan(m_fov * M_PI / 360.0) / m_height;
 }
 
 void Camera::updateDimensions(int width, int height) {
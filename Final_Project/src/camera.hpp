@@ -16,6 +16,9 @@ public:
 
     Point3D getEye() const { return m_eye; }
 
+    // Angle between neighbouring pixel centres, in radians
+    double getPixelSpread() const;
+
     void updateDimensions(int width, int height);
 
     int getWidth() const { return m_width; }
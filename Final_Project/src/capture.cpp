@@ -0,0 +1,48 @@
+#include "capture.hpp"
+
+#include "a4.hpp"
+#include "scene_lua.hpp"
+
+using std::list;
+using std::string;
+
+// The scene being captured. RENDER takes no context, so it has to be
+// reached through here.
+static CapturedScene* s_scene = NULL;
+
+CapturedScene::CapturedScene() :
+    root(NULL), camera(NULL), ambient(0.0, 0.0, 0.0)
+{}
+
+CapturedScene::~CapturedScene() {
+    delete camera;
+}
+
+static bool keepScene(SceneNode* root, const string& filename, int width, int height,
+        const Point3D& eye, const Vector3D& view, const Vector3D& up, double fov,
+        const Colour& ambient, const list<Light*>& lights)
+{
+    delete s_scene->camera;
+
+    s_scene->root = root;
+    s_scene->camera = new Camera(width, height, eye, view, up, fov);
+    s_scene->filename = filename;
+    s_scene->ambient = ambient;
+    s_scene->lights = lights;
+
+    return true;
+}
+
+bool captureScene(const string& script, CapturedScene* scene) {
+    RenderFunction render = RENDER;
+
+    s_scene = scene;
+    RENDER = keepScene;
+
+    bool ok = run_lua(script);
+
+    RENDER = render;
+    s_scene = NULL;
+
+    return ok;
+}
@@ -0,0 +1,37 @@
+#ifndef CS488_CAPTURE_HPP
+#define CS488_CAPTURE_HPP
+
+#include <list>
+#include <string>
+
+#include "algebra.hpp"
+#include "camera.hpp"
+#include "light.hpp"
+#include "scene.hpp"
+
+// What a scene script asked gr.render to draw. The farm, the benchmarks
+// and the tests trace scenes themselves, so they run the script through
+// captureScene instead of letting it open a window.
+struct CapturedScene {
+    CapturedScene();
+    ~CapturedScene();
+
+    // NULL if the script never called gr.render
+    SceneNode* root;
+    Camera* camera;
+
+    std::string filename;
+    Colour ambient;
+    std::list<Light*> lights;
+
+private:
+    CapturedScene(const CapturedScene& other);
+    CapturedScene& operator=(const CapturedScene& other);
+};
+
+// Runs the script with gr.render filling in scene instead of rendering.
+// If the script renders more than once, the last call is kept. Returns
+// false if the script failed to run.
+bool captureScene(const std::string& script, CapturedScene* scene);
+
+#endif
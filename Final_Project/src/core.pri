@@ -0,0 +1,8 @@
+# Everything but main.cpp, shared by rt, the benchmarks in ../bench and the tests in ../test
+INCLUDEPATH += $$PWD
+
+HEADERS += $$PWD/a4.hpp $$PWD/algebra.hpp $$PWD/bbox.hpp $$PWD/bih.hpp $$PWD/camera.hpp $$PWD/intersection.hpp $$PWD/light.hpp $$PWD/lua488.hpp $$PWD/material.hpp $$PWD/mesh.hpp $$PWD/packet.hpp $$PWD/paintcanvas.hpp $$PWD/paintwindow.hpp $$PWD/polyroots.hpp $$PWD/primitive.hpp $$PWD/ray.hpp $$PWD/sample.hpp $$PWD/scene.hpp $$PWD/scene_lua.hpp $$PWD/tracer.hpp $$PWD/interval.hpp $$PWD/game.hpp $$PWD/tetris.hpp $$PWD/map.hpp $$PWD/budget.hpp $$PWD/renderservice.hpp $$PWD/framebuffer.hpp $$PWD/pool.hpp $$PWD/simd.hpp $$PWD/simdroots.hpp $$PWD/frustum.hpp $$PWD/lanemask.hpp $$PWD/perfcounters.hpp $$PWD/costmap.hpp $$PWD/pngwriter.hpp $$PWD/floatwriter.hpp $$PWD/imagewriter.hpp $$PWD/animation.hpp $$PWD/farm.hpp $$PWD/capture.hpp $$PWD/tracejob.hpp
+SOURCES += $$PWD/a4.cpp $$PWD/algebra.cpp $$PWD/bbox.cpp $$PWD/bih.cpp $$PWD/camera.cpp $$PWD/intersection.cpp $$PWD/light.cpp $$PWD/material.cpp $$PWD/mesh.cpp $$PWD/packet.cpp $$PWD/paintcanvas.cpp $$PWD/paintwindow.cpp $$PWD/polyroots.cpp $$PWD/primitive.cpp $$PWD/ray.cpp $$PWD/scene.cpp $$PWD/scene_lua.cpp $$PWD/tracer.cpp $$PWD/interval.cpp $$PWD/game.cpp $$PWD/tetris.cpp $$PWD/map.cpp $$PWD/budget.cpp $$PWD/renderservice.cpp $$PWD/framebuffer.cpp $$PWD/pool.cpp $$PWD/simdroots.cpp $$PWD/frustum.cpp $$PWD/perfcounters.cpp $$PWD/costmap.cpp $$PWD/pngwriter.cpp $$PWD/floatwriter.cpp $$PWD/imagewriter.cpp $$PWD/animation.cpp $$PWD/farm.cpp $$PWD/capture.cpp $$PWD/tracejob.cpp
+
+# Saved PNGs are deflated with zlib
+LIBS += -lz
@@ -0,0 +1,164 @@
+#include "costmap.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <math.h>
+
+using std::endl;
+using std::max;
+using std::min;
+using std::vector;
+
+CostMap::CostMap(int numThreads) :
+    m_threadNsecs(numThreads, 0), m_threadPackets(numThreads, 0), m_threadRays(numThreads, 0)
+{}
+
+void CostMap::reset() {
+    m_tiles.clear();
+    m_packetNsecs.clear();
+
+    m_threadNsecs.assign(m_threadNsecs.size(), 0);
+    m_threadPackets.assign(m_threadPackets.size(), 0);
+    m_threadRays.assign(m_threadRays.size(), 0);
+}
+
+void CostMap::beginPackets(int numPackets) {
+    m_packetNsecs.assign(numPackets, 0);
+}
+
+void CostMap::addPacket(int index, int thread, long long nsecs, int rays) {
+    m_packetNsecs[index] = nsecs;
+
+    m_threadNsecs[thread] += nsecs;
+    m_threadPackets[thread] += 1;
+    m_threadRays[thread] += rays;
+}
+
+void CostMap::endPackets(const vector<CameraPacket*>& packets) {
+    int n = min(packets.size(), m_packetNsecs.size());
+
+    for(int i = 0; i < n; ++i) {
+        Tile tile;
+        tile.i = packets[i]->getI();
+        tile.j = packets[i]->getJ();
+        tile.width = packets[i]->getWidth();
+        tile.height = packets[i]->getHeight();
+        tile.nsecs = m_packetNsecs[i];
+
+        m_tiles.push_back(tile);
+    }
+}
+
+// 0 is black, then red, yellow and 1 is white
+static QRgb heat(double v) {
+    v = min(1.0, max(0.0, v));
+
+    int r = (int)(255 * min(1.0, 3.0 * v));
+    int g = (int)(255 * min(1.0, max(0.0, 3.0 * v - 1.0)));
+    int b = (int)(255 * max(0.0, 3.0 * v - 2.0));
+
+    return qRgb(r, g, b);
+}
+
+void CostMap::draw(QImage* img, int top) const {
+    int n = m_tiles.size();
+    int bottom = top + img->height();
+
+    // Edge tiles are smaller, so tiles are compared per pixel
+    vector<double> perPixel(n);
+
+    double lo = INFINITY;
+    double hi = 0.0;
+
+    for(int i = 0; i < n; ++i) {
+        const Tile& tile = m_tiles[i];
+        perPixel[i] = tile.nsecs / (double)(tile.width * tile.height);
+
+        if(perPixel[i] > 0.0) {
+            lo = min(lo, perPixel[i]);
+            hi = max(hi, perPixel[i]);
+        }
+    }
+
+    double range = (hi > lo) ? log(hi / lo) : 1.0;
+
+    for(int i = 0; i < n; ++i) {
+        const Tile& tile = m_tiles[i];
+
+        if(tile.j >= bottom || tile.j + tile.height <= top) {
+            continue;
+        }
+
+        double v = (perPixel[i] > 0.0) ? log(perPixel[i] / lo) / range : 0.0;
+        QRgb colour = heat(v);
+
+        for(int y = max(tile.j, top); y < min(tile.j + tile.height, bottom); ++y) {
+            for(int x = 0; x < tile.width; ++x) {
+                img->setPixel(tile.i + x, y - top, colour);
+            }
+        }
+    }
+}
+
+/*  printLoad
+ *
+ *  A worker's load is the time it spent tracing packets. Imbalance is
+ *  the busiest worker's load over the mean, and efficiency the share of
+ *  the frame's worker time spent tracing, so waiting for the slowest
+ *  worker and the frame's overhead both show up as a lower figure.
+ */
+void CostMap::printLoad(std::ostream& out, long long frameNsecs) const {
+    int numThreads = m_threadNsecs.size();
+
+    if(numThreads == 0 || m_tiles.empty()) {
+        return;
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(1);
+
+    long long total = 0;
+    long long busiest = 0;
+
+    for(int t = 0; t < numThreads; ++t) {
+        out << "Thread " << t << ": " << m_threadPackets[t] << " packets, "
+            << m_threadRays[t] << " rays, " << m_threadNsecs[t] / 1.0e6 << " ms" << endl;
+
+        total += m_threadNsecs[t];
+        busiest = max(busiest, m_threadNsecs[t]);
+    }
+
+    double mean = total / (double)numThreads;
+
+    out << "Load: busiest " << busiest / 1.0e6 << " ms, mean " << mean / 1.0e6 << " ms, imbalance "
+        << std::setprecision(2) << ((mean > 0.0) ? busiest / mean : 1.0);
+
+    if(frameNsecs > 0) {
+        out << ", efficiency " << std::setprecision(0)
+            << 100.0 * total / ((double)numThreads * frameNsecs) << "%";
+    }
+
+    out << endl;
+
+    vector<long long> sorted;
+
+    for(auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+        sorted.push_back(it->nsecs);
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+
+    int n = sorted.size();
+    long long median = sorted[n / 2];
+    long long p99 = sorted[min(n - 1, (int)(0.99 * n))];
+
+    out << std::setprecision(3) << "Tiles: " << n << ", median " << median / 1.0e6 << " ms, p99 "
+        << p99 / 1.0e6 << " ms, max " << sorted[n - 1] / 1.0e6 << " ms";
+
+    if(median > 0) {
+        out << std::setprecision(0) << " (" << sorted[n - 1] / (double)median << "x median)";
+    }
+
+    out << endl;
+    out.flags(flags);
+}
@@ -0,0 +1,55 @@
+#ifndef CS488_COSTMAP_HPP
+#define CS488_COSTMAP_HPP
+
+#include <ostream>
+#include <vector>
+#include <QImage>
+
+#include "packet.hpp"
+
+// What each camera packet of a frame cost to trace and which worker
+// traced it. Workers write their own packets' entries, so no locking is
+// needed while packets are traced. A frame traced in bands is several
+// sets of packets, and their tiles all go into the same map.
+class CostMap {
+public:
+    CostMap(int numThreads);
+
+    // Forgets every tile and worker total
+    void reset();
+
+    // Costs for a set of packets are added as the workers trace them and
+    // kept as tiles of the frame by endPackets
+    void beginPackets(int numPackets);
+    void addPacket(int index, int thread, long long nsecs, int rays);
+    void endPackets(const std::vector<CameraPacket*>& packets);
+
+    // Colours every tile in rows top to top + img->height() - 1 by its
+    // time per pixel, on a log scale from the cheapest tile of the frame
+    // in black through red and yellow to the most expensive in white.
+    // img must be as wide as the frame.
+    void draw(QImage* img, int top) const;
+
+    // Time per worker, how far the busiest is from the mean, and the
+    // spread of tile costs. frameNsecs is the wall time spent tracing.
+    void printLoad(std::ostream& out, long long frameNsecs) const;
+
+private:
+    struct Tile {
+        int i;
+        int j;
+        int width;
+        int height;
+
+        long long nsecs;
+    };
+
+    std::vector<Tile> m_tiles;
+    std::vector<long long> m_packetNsecs;
+
+    std::vector<long long> m_threadNsecs;
+    std::vector<int> m_threadPackets;
+    std::vector<long> m_threadRays;
+};
+
+#endif
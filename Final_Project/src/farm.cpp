@@ -0,0 +1,678 @@
+#include "farm.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <QElapsedTimer>
+
+#include "capture.hpp"
+#include "imagewriter.hpp"
+#include "packet.hpp"
+#include "primitive.hpp"
+#include "tracejob.hpp"
+#include "tracer.hpp"
+
+using std::cerr;
+using std::cout;
+using std::deque;
+using std::endl;
+using std::max;
+using std::min;
+using std::string;
+using std::vector;
+
+// Tiles each worker is given ahead, so it never waits on the master
+#define TILES_IN_FLIGHT 2
+
+// The master wakes up at least this often to check the deadlines, in ms
+#define MAX_POLL_MS 1000
+
+// Messages are a type, a count of 32 bit words and then the words, all
+// in network byte order
+enum MessageType {
+    // Worker to master: width, height of the scene's image
+    MSG_HELLO = 1,
+    // Master to worker: width, height, sample width to render at
+    MSG_JOB,
+    // Master to worker: id, i, j, width, height of a tile
+    MSG_TILE,
+    // Worker to master: id, then blue, green and red of every pixel
+    MSG_PIXELS,
+    // Master to worker: no more tiles
+    MSG_QUIT
+};
+
+#define HEADER_BYTES 8
+
+FarmOptions::FarmOptions() :
+    workers(max(1L, sysconf(_SC_NPROCESSORS_ONLN))), sampleWidth(1), tilePackets(4), threads(1),
+    timeout(120), failAfter(0), stallAfter(0)
+{}
+
+//*************************** Scene capture *****************************
+
+// The scene both the master and a worker run their script for
+static CapturedScene s_scene;
+
+static bool loadScene(const string& scene) {
+    if(!captureScene(scene, &s_scene) || s_scene.root == NULL) {
+        cerr << "No scene rendered by " << scene << endl;
+        return false;
+    }
+
+    return true;
+}
+
+//*************************** Protocol *****************************
+
+static bool writeAll(int fd, const void* data, size_t size) {
+    const char* p = (const char*)data;
+
+    while(size > 0) {
+        ssize_t n = write(fd, p, size);
+
+        if(n < 0 && errno == EINTR) {
+            continue;
+        } else if(n <= 0) {
+            return false;
+        }
+
+        p += n;
+        size -= n;
+    }
+
+    return true;
+}
+
+static bool readAll(int fd, void* data, size_t size) {
+    char* p = (char*)data;
+
+    while(size > 0) {
+        ssize_t n = read(fd, p, size);
+
+        if(n < 0 && errno == EINTR) {
+            continue;
+        } else if(n <= 0) {
+            return false;
+        }
+
+        p += n;
+        size -= n;
+    }
+
+    return true;
+}
+
+static bool sendMessage(int fd, uint32_t type, const vector<uint32_t>& words) {
+    vector<uint32_t> message(2 + words.size());
+    message[0] = htonl(type);
+    message[1] = htonl(words.size());
+
+    for(size_t w = 0; w < words.size(); ++w) {
+        message[2 + w] = htonl(words[w]);
+    }
+
+    return writeAll(fd, &message[0], 4 * message.size());
+}
+
+// Reads one whole message, blocking until it arrives
+static bool receiveMessage(int fd, uint32_t* type, vector<uint32_t>* words) {
+    uint32_t header[2];
+
+    if(!readAll(fd, header, HEADER_BYTES)) {
+        return false;
+    }
+
+    *type = ntohl(header[0]);
+    words->resize(ntohl(header[1]));
+
+    if(!words->empty() && !readAll(fd, &(*words)[0], 4 * words->size())) {
+        return false;
+    }
+
+    for(size_t w = 0; w < words->size(); ++w) {
+        (*words)[w] = ntohl((*words)[w]);
+    }
+
+    return true;
+}
+
+static uint32_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, 4);
+    return bits;
+}
+
+static float bitsFloat(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, 4);
+    return value;
+}
+
+static string shellQuote(const string& text) {
+    string quoted = "'";
+
+    for(size_t c = 0; c < text.size(); ++c) {
+        if(text[c] == '\'') {
+            quoted += "'\\''";
+        } else {
+            quoted += text[c];
+        }
+    }
+
+    return quoted + "'";
+}
+
+//*************************** Master *****************************
+
+FarmMaster::FarmMaster(const string& scene, const FarmOptions& options) :
+    m_scene(scene), m_options(options), m_width(0), m_height(0), m_remaining(0), m_redispatched(0)
+{}
+
+FarmMaster::~FarmMaster() {
+    stopWorkers();
+}
+
+bool FarmMaster::startWorkers() {
+    string command = m_options.command;
+
+    if(command.empty()) {
+        char self[4096];
+        ssize_t n = readlink("/proc/self/exe", self, sizeof(self) - 1);
+
+        if(n <= 0) {
+            cerr << "Could not find this program to start workers, give --command" << endl;
+            return false;
+        }
+
+        self[n] = '\0';
+
+        char threads[32];
+        snprintf(threads, sizeof(threads), " --threads %d", m_options.threads);
+
+        command = shellQuote(self) + " --worker" + threads + " " + shellQuote(m_scene);
+    }
+
+    m_clock.start();
+
+    for(int w = 0; w < m_options.workers; ++w) {
+        int fds[2];
+
+        if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            cerr << "Could not create a socket for worker " << w << endl;
+            return false;
+        }
+
+        // Later workers must not inherit this end
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+
+        pid_t pid = fork();
+
+        if(pid == 0) {
+            dup2(fds[1], 0);
+            dup2(fds[1], 1);
+
+            if(fds[1] > 1) {
+                close(fds[1]);
+            }
+
+            char index[16];
+            snprintf(index, sizeof(index), "%d", w);
+            setenv("FARM_WORKER", index, 1);
+
+            execl("/bin/sh", "sh", "-c", command.c_str(), (char*)NULL);
+            _exit(127);
+        }
+
+        close(fds[1]);
+
+        if(pid < 0) {
+            close(fds[0]);
+            cerr << "Could not start worker " << w << endl;
+            return false;
+        }
+
+        Worker worker;
+        worker.pid = pid;
+        worker.fd = fds[0];
+        worker.ready = false;
+        worker.alive = true;
+        worker.done = 0;
+
+        // It owes the master its hello
+        worker.deadline = m_clock.elapsed() + 1000LL * m_options.timeout;
+
+        m_workers.push_back(worker);
+    }
+
+    return true;
+}
+
+void FarmMaster::stopWorkers() {
+    for(auto it = m_workers.begin(); it != m_workers.end(); ++it) {
+        if(it->alive) {
+            sendMessage(it->fd, MSG_QUIT, vector<uint32_t>());
+            close(it->fd);
+            it->alive = false;
+        }
+    }
+
+    for(auto it = m_workers.begin(); it != m_workers.end(); ++it) {
+        if(it->pid > 0) {
+            waitpid(it->pid, NULL, 0);
+            it->pid = 0;
+        }
+    }
+}
+
+void FarmMaster::markDead(Worker* worker, const string& reason) {
+    int index = worker - &m_workers[0];
+
+    cerr << "Worker " << index << " " << reason << ", sending its " << worker->tiles.size()
+        << " tiles to the others" << endl;
+
+    // Its tiles go to the front, since the band waits on them
+    m_queue.insert(m_queue.begin(), worker->tiles.begin(), worker->tiles.end());
+    m_redispatched += worker->tiles.size();
+    worker->tiles.clear();
+
+    close(worker->fd);
+    kill(worker->pid, SIGKILL);
+
+    worker->alive = false;
+    worker->deadline = -1;
+}
+
+void FarmMaster::checkDeadlines() {
+    long long now = m_clock.elapsed();
+
+    for(auto it = m_workers.begin(); it != m_workers.end(); ++it) {
+        if(it->alive && it->deadline >= 0 && now > it->deadline) {
+            markDead(&*it, it->ready ? "timed out on a tile" : "timed out loading the scene");
+        }
+    }
+}
+
+// Until the nearest deadline, but never longer than MAX_POLL_MS
+int FarmMaster::getPollTimeout() {
+    long long now = m_clock.elapsed();
+    long long timeout = MAX_POLL_MS;
+
+    for(auto it = m_workers.begin(); it != m_workers.end(); ++it) {
+        if(it->alive && it->deadline >= 0) {
+            timeout = min(timeout, max(0LL, it->deadline - now));
+        }
+    }
+
+    return timeout;
+}
+
+void FarmMaster::dispatch(Worker* worker) {
+    while(worker->alive && worker->ready && (int)worker->tiles.size() < TILES_IN_FLIGHT &&
+            !m_queue.empty()) {
+        int id = m_queue.front();
+        const Tile& tile = m_tiles[id];
+
+        vector<uint32_t> words;
+        words.push_back(id);
+        words.push_back(tile.i);
+        words.push_back(tile.j);
+        words.push_back(tile.width);
+        words.push_back(tile.height);
+
+        m_queue.pop_front();
+        worker->tiles.push_back(id);
+
+        // A worker traces its tiles in order, so its clock only runs
+        // for the oldest
+        if(worker->tiles.size() == 1) {
+            worker->deadline = m_clock.elapsed() + 1000LL * m_options.timeout;
+        }
+
+        if(!sendMessage(worker->fd, MSG_TILE, words)) {
+            markDead(worker, "stopped reading");
+        }
+    }
+}
+
+// Handles every whole message in the worker's input
+void FarmMaster::readMessages(Worker* worker, FrameBuffer* band) {
+    vector<unsigned char>& input = worker->input;
+    size_t start = 0;
+
+    while(worker->alive && input.size() - start >= HEADER_BYTES) {
+        uint32_t header[2];
+        memcpy(header, &input[start], HEADER_BYTES);
+
+        uint32_t type = ntohl(header[0]);
+        uint32_t count = ntohl(header[1]);
+
+        // Nothing a worker sends is bigger than a tile's pixels, and the
+        // first tile of a band is as tall as any
+        if(count > 1 + 3 * (uint32_t)(m_width * m_tiles[0].height)) {
+            markDead(worker, "sent a message too long");
+            return;
+        }
+
+        if(input.size() - start < HEADER_BYTES + 4 * (size_t)count) {
+            break;
+        }
+
+        vector<uint32_t> words(count);
+
+        for(uint32_t w = 0; w < count; ++w) {
+            uint32_t word;
+            memcpy(&word, &input[start + HEADER_BYTES + 4 * w], 4);
+            words[w] = ntohl(word);
+        }
+
+        start += HEADER_BYTES + 4 * count;
+
+        if(type == MSG_HELLO && !worker->ready) {
+            if(count != 2 || (int)words[0] != m_width || (int)words[1] != m_height) {
+                markDead(worker, "rendered a different scene");
+                return;
+            }
+
+            vector<uint32_t> job;
+            job.push_back(m_width);
+            job.push_back(m_height);
+            job.push_back(m_options.sampleWidth);
+
+            if(!sendMessage(worker->fd, MSG_JOB, job)) {
+                markDead(worker, "stopped reading");
+                return;
+            }
+
+            worker->ready = true;
+            worker->deadline = -1;
+
+        } else if(type == MSG_PIXELS && count >= 1) {
+            int id = words[0];
+            auto it = std::find(worker->tiles.begin(), worker->tiles.end(), id);
+
+            if(it == worker->tiles.end() || count != 1 + 3 * (uint32_t)(m_tiles[id].width * m_tiles[id].height)) {
+                markDead(worker, "sent a tile it was not given");
+                return;
+            }
+
+            const Tile& tile = m_tiles[id];
+            const uint32_t* src = &words[1];
+
+            for(int y = tile.j; y < tile.j + tile.height; ++y) {
+                for(int x = tile.i; x < tile.i + tile.width; ++x, src += 3) {
+                    float* pixel = band->getPixel(x, y);
+
+                    pixel[0] = bitsFloat(src[0]);
+                    pixel[1] = bitsFloat(src[1]);
+                    pixel[2] = bitsFloat(src[2]);
+                    pixel[3] = 1.0f;
+                }
+            }
+
+            worker->tiles.erase(it);
+            worker->done++;
+            m_remaining--;
+
+            worker->deadline = worker->tiles.empty() ? -1 :
+                m_clock.elapsed() + 1000LL * m_options.timeout;
+
+        } else {
+            markDead(worker, "sent a message out of turn");
+            return;
+        }
+    }
+
+    input.erase(input.begin(), input.begin() + min(start, input.size()));
+}
+
+/*  renderBand
+ *
+ *  Splits the band into tiles and keeps every live worker TILES_IN_FLIGHT
+ *  tiles ahead until all have come back. A worker that hangs up, fails
+ *  a write, breaks the protocol or misses its deadline is dropped and
+ *  its tiles requeued.
+ */
+bool FarmMaster::renderBand(FrameBuffer* band) {
+    int tileWidth = m_options.tilePackets * max(1, CameraPacket::getPacketWidth() / m_options.sampleWidth);
+    int tileHeight = m_options.tilePackets * max(1, CameraPacket::getPacketHeight() / m_options.sampleWidth);
+
+    int bottom = band->top() + band->rows();
+
+    m_tiles.clear();
+    m_queue.clear();
+
+    for(int j = band->top(); j < bottom; j += tileHeight) {
+        for(int i = 0; i < m_width; i += tileWidth) {
+            Tile tile;
+            tile.i = i;
+            tile.j = j;
+            tile.width = min(tileWidth, m_width - i);
+            tile.height = min(tileHeight, bottom - j);
+
+            m_queue.push_back(m_tiles.size());
+            m_tiles.push_back(tile);
+        }
+    }
+
+    m_remaining = m_tiles.size();
+
+    while(m_remaining > 0) {
+        vector<struct pollfd> fds;
+        vector<Worker*> polled;
+
+        for(auto it = m_workers.begin(); it != m_workers.end(); ++it) {
+            dispatch(&*it);
+
+            if(it->alive) {
+                struct pollfd fd;
+                fd.fd = it->fd;
+                fd.events = POLLIN;
+                fd.revents = 0;
+
+                fds.push_back(fd);
+                polled.push_back(&*it);
+            }
+        }
+
+        if(fds.empty()) {
+            cerr << "Every worker died with " << m_remaining << " tiles left" << endl;
+            return false;
+        }
+
+        if(poll(&fds[0], fds.size(), getPollTimeout()) < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+
+            cerr << "Could not wait for the workers" << endl;
+            return false;
+        }
+
+        for(size_t f = 0; f < fds.size(); ++f) {
+            if(fds[f].revents == 0) {
+                continue;
+            }
+
+            Worker* worker = polled[f];
+
+            unsigned char buffer[65536];
+            ssize_t n = read(worker->fd, buffer, sizeof(buffer));
+
+            if(n < 0 && errno == EINTR) {
+                continue;
+            } else if(n <= 0) {
+                markDead(worker, "hung up");
+                continue;
+            }
+
+            worker->input.insert(worker->input.end(), buffer, buffer + n);
+            readMessages(worker, band);
+        }
+
+        checkDeadlines();
+    }
+
+    return true;
+}
+
+bool FarmMaster::render() {
+    if(!loadScene(m_scene)) {
+        return false;
+    }
+
+    m_width = s_scene.camera->getWidth();
+    m_height = s_scene.camera->getHeight();
+
+    // Dead workers show up as failed writes instead
+    signal(SIGPIPE, SIG_IGN);
+
+    if(!startWorkers()) {
+        return false;
+    }
+
+    ImageWriter writer;
+
+    if(!writer.open(s_scene.filename, m_width, m_height)) {
+        return false;
+    }
+
+    int tileHeight = m_options.tilePackets * max(1, CameraPacket::getPacketHeight() / m_options.sampleWidth);
+    int bandRows = ImageWriter::getBandRows(m_width, tileHeight);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    bool ok = true;
+
+    for(int top = 0; top < m_height && ok; top += bandRows) {
+        FrameBuffer band(m_width, m_height, top, min(bandRows, m_height - top));
+
+        ok = renderBand(&band) && writer.writeRows(band);
+    }
+
+    ok = writer.close() && ok;
+
+    stopWorkers();
+
+    for(size_t w = 0; w < m_workers.size(); ++w) {
+        cout << "Worker " << w << ": " << m_workers[w].done << " tiles" << endl;
+    }
+
+    if(ok) {
+        cout << "Rendered " << s_scene.filename << " in " << timer.elapsed() << " ms with "
+            << m_workers.size() << " workers, " << m_redispatched << " tiles sent again" << endl;
+    } else {
+        cerr << "Could not render " << s_scene.filename << endl;
+    }
+
+    return ok;
+}
+
+//*************************** Worker *****************************
+
+FarmWorker::FarmWorker(const string& scene, const FarmOptions& options) :
+    m_scene(scene), m_options(options)
+{}
+
+bool FarmWorker::run() {
+    // The protocol keeps stdout, and the scene's own output goes to stderr
+    int in = 0;
+    int out = dup(1);
+    dup2(2, 1);
+
+    if(!loadScene(m_scene)) {
+        return false;
+    }
+
+    vector<Primitive*> primitives;
+    s_scene.root->getPrimitives(&primitives);
+
+    Tracer tracer(&primitives, s_scene.ambient, &s_scene.lights);
+    Camera cam(*s_scene.camera);
+
+    vector<uint32_t> hello;
+    hello.push_back(cam.getWidth());
+    hello.push_back(cam.getHeight());
+
+    if(!sendMessage(out, MSG_HELLO, hello)) {
+        return false;
+    }
+
+    int sampleWidth = 1;
+    int done = 0;
+
+    uint32_t type;
+    vector<uint32_t> words;
+
+    while(receiveMessage(in, &type, &words)) {
+        if(type == MSG_JOB && words.size() == 3) {
+            cam.updateDimensions(words[0], words[1]);
+            sampleWidth = words[2];
+
+        } else if(type == MSG_TILE && words.size() == 5) {
+            if(m_options.failAfter > 0 && done == m_options.failAfter) {
+                _exit(1);
+            }
+
+            if(m_options.stallAfter > 0 && done == m_options.stallAfter) {
+                while(true) {
+                    pause();
+                }
+            }
+
+            int i = words[1];
+            int j = words[2];
+            int width = words[3];
+            int height = words[4];
+
+            FrameBuffer rows(cam.getWidth(), cam.getHeight(), j, height);
+
+            vector<CameraPacket*>* packets =
+                CameraPacket::genPackets(&rows, &tracer, cam, sampleWidth, i, j, width, height);
+
+            TraceJob::run(packets, m_options.threads);
+            CameraPacket::deletePackets(packets);
+
+            vector<uint32_t> pixels;
+            pixels.reserve(1 + 3 * width * height);
+            pixels.push_back(words[0]);
+
+            for(int y = j; y < j + height; ++y) {
+                for(int x = i; x < i + width; ++x) {
+                    const float* pixel = rows.getPixel(x, y);
+
+                    pixels.push_back(floatBits(pixel[0]));
+                    pixels.push_back(floatBits(pixel[1]));
+                    pixels.push_back(floatBits(pixel[2]));
+                }
+            }
+
+            if(!sendMessage(out, MSG_PIXELS, pixels)) {
+                return false;
+            }
+
+            done++;
+
+        } else {
+            break;
+        }
+    }
+
+    for(auto it = primitives.begin(); it != primitives.end(); ++it) {
+        delete *it;
+    }
+
+    return true;
+}
@@ -0,0 +1,144 @@
+#ifndef CS488_FARM_HPP
+#define CS488_FARM_HPP
+
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <QElapsedTimer>
+
+#include "camera.hpp"
+#include "framebuffer.hpp"
+#include "light.hpp"
+#include "scene.hpp"
+
+// Renders one image across several worker processes. The master runs
+// the scene script only to learn the image's file name and size, then
+// starts the workers, each of which runs the same script and traces the
+// tiles it is sent. Tiles are blocks of whole camera packets handed out
+// a few at a time as workers finish them, so faster workers take more
+// of the image. The tiles of a worker that dies go back to the others.
+//
+// Workers speak the protocol on their stdin and stdout, so one can run
+// on another machine with a command such as
+//     ssh host 'cd data && rt --worker scene.lua'
+// Each command is run by sh with FARM_WORKER set to the worker's index.
+//
+// A worker that sends nothing for longer than the timeout while it owes
+// the master its hello or a tile is taken for dead, killed, and its
+// tiles go to the others, so a hung or unreachable worker can't stall
+// the image.
+
+struct FarmOptions {
+    FarmOptions();
+
+    // Worker processes the master starts
+    int workers;
+
+    // Starts one worker. By default this program with --worker.
+    std::string command;
+
+    // Samples per pixel along each axis
+    int sampleWidth;
+
+    // Tile side, in camera packets
+    int tilePackets;
+
+    // Threads tracing each tile in a worker
+    int threads;
+
+    // Seconds a worker may take over a tile, or to load the scene and
+    // send its hello, before the master gives up on it
+    int timeout;
+
+    // A worker exits without a word after this many tiles, to test the
+    // master's recovery. 0 never does.
+    int failAfter;
+
+    // A worker stops answering without exiting after this many tiles, to
+    // test the timeout. 0 never does.
+    int stallAfter;
+};
+
+class FarmMaster {
+public:
+    FarmMaster(const std::string& scene, const FarmOptions& options);
+    ~FarmMaster();
+
+    // Renders the scene's image and saves it where the scene asked.
+    // Returns false if the scene failed to load, every worker died or
+    // the image could not be saved.
+    bool render();
+
+private:
+    struct Tile {
+        int i;
+        int j;
+        int width;
+        int height;
+    };
+
+    struct Worker {
+        pid_t pid;
+        int fd;
+
+        bool ready;
+        bool alive;
+
+        // Bytes read but not yet a whole message
+        std::vector<unsigned char> input;
+
+        // Tiles sent and not yet returned
+        std::deque<int> tiles;
+        int done;
+
+        // When the master gives up on the worker's hello or its oldest
+        // tile, in ms on m_clock. -1 while it owes nothing.
+        long long deadline;
+    };
+
+    bool startWorkers();
+    void stopWorkers();
+    void markDead(Worker* worker, const std::string& reason);
+    void checkDeadlines();
+    int getPollTimeout();
+
+    bool renderBand(FrameBuffer* band);
+    void dispatch(Worker* worker);
+    void readMessages(Worker* worker, FrameBuffer* band);
+
+    std::string m_scene;
+    FarmOptions m_options;
+
+    // The scene's image size
+    int m_width;
+    int m_height;
+
+    std::vector<Worker> m_workers;
+
+    // The tiles of the current band, and those waiting to be sent
+    std::vector<Tile> m_tiles;
+    std::deque<int> m_queue;
+    int m_remaining;
+
+    int m_redispatched;
+
+    // Started with the workers, for their deadlines
+    QElapsedTimer m_clock;
+};
+
+class FarmWorker {
+public:
+    FarmWorker(const std::string& scene, const FarmOptions& options);
+
+    // Answers the master on stdin and stdout until told to quit. Anything
+    // the scene prints goes to stderr.
+    bool run();
+
+private:
+    std::string m_scene;
+    FarmOptions m_options;
+};
+
+#endif
@@ -0,0 +1,253 @@
+#include "floatwriter.hpp"
+
+#include <ctype.h>
+#include <iostream>
+#include <stdint.h>
+#include <string.h>
+
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+
+// Both formats are written little endian whatever the host is
+static void putInt(unsigned char* dest, uint32_t value) {
+    for(int i = 0; i < 4; ++i) {
+        dest[i] = (value >> (8 * i)) & 0xff;
+    }
+}
+
+static void putFloat(unsigned char* dest, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, 4);
+    putInt(dest, bits);
+}
+
+static void appendInt(vector<unsigned char>* out, uint32_t value) {
+    unsigned char bytes[4];
+    putInt(bytes, value);
+    out->insert(out->end(), bytes, bytes + 4);
+}
+
+static void appendFloat(vector<unsigned char>* out, float value) {
+    unsigned char bytes[4];
+    putFloat(bytes, value);
+    out->insert(out->end(), bytes, bytes + 4);
+}
+
+static void appendString(vector<unsigned char>* out, const char* s) {
+    out->insert(out->end(), s, s + strlen(s) + 1);
+}
+
+// An EXR header attribute: its name, type, size and then its value
+static void appendAttribute(vector<unsigned char>* out, const char* name, const char* type,
+        const vector<unsigned char>& value) {
+    appendString(out, name);
+    appendString(out, type);
+    appendInt(out, value.size());
+    out->insert(out->end(), value.begin(), value.end());
+}
+
+FloatWriter::FloatWriter() :
+    m_file(NULL), m_failed(false), m_format(pfm), m_width(0), m_height(0), m_row(0), m_dataStart(0)
+{}
+
+FloatWriter::~FloatWriter() {
+    destroy();
+}
+
+void FloatWriter::destroy() {
+    if(m_file != NULL) {
+        fclose(m_file);
+    }
+
+    m_file = NULL;
+}
+
+bool FloatWriter::formatFor(const string& filename, Format* format) {
+    size_t dot = filename.find_last_of('.');
+    string ext = (dot == string::npos) ? "" : filename.substr(dot + 1);
+
+    for(size_t i = 0; i < ext.size(); ++i) {
+        ext[i] = tolower(ext[i]);
+    }
+
+    if(ext == "pfm") {
+        *format = pfm;
+        return true;
+    } else if(ext == "exr") {
+        *format = exr;
+        return true;
+    }
+
+    return false;
+}
+
+/*  writeExrHeader
+ *
+ *  The attributes every scanline file needs, then the table of where
+ *  each line starts. Lines are uncompressed, so they are all the same
+ *  size and the table is known before any are traced.
+ */
+void FloatWriter::writeExrHeader() {
+    vector<unsigned char> header;
+
+    static const unsigned char magic[4] = { 0x76, 0x2f, 0x31, 0x01 };
+    header.insert(header.end(), magic, magic + 4);
+
+    // Version 2, single part scanline
+    appendInt(&header, 2);
+
+    // Channels in name order, each 32 bit float and not subsampled
+    vector<unsigned char> channels;
+    const char* names[] = { "B", "G", "R" };
+
+    for(int c = 0; c < 3; ++c) {
+        appendString(&channels, names[c]);
+        appendInt(&channels, 2);
+        appendInt(&channels, 0);
+        appendInt(&channels, 1);
+        appendInt(&channels, 1);
+    }
+
+    channels.push_back(0);
+    appendAttribute(&header, "channels", "chlist", channels);
+
+    appendAttribute(&header, "compression", "compression", vector<unsigned char>(1, 0));
+
+    vector<unsigned char> window;
+    appendInt(&window, 0);
+    appendInt(&window, 0);
+    appendInt(&window, m_width - 1);
+    appendInt(&window, m_height - 1);
+
+    appendAttribute(&header, "dataWindow", "box2i", window);
+    appendAttribute(&header, "displayWindow", "box2i", window);
+
+    // Increasing y
+    appendAttribute(&header, "lineOrder", "lineOrder", vector<unsigned char>(1, 0));
+
+    vector<unsigned char> one;
+    appendFloat(&one, 1.0f);
+    appendAttribute(&header, "pixelAspectRatio", "float", one);
+
+    vector<unsigned char> centre;
+    appendFloat(&centre, 0.0f);
+    appendFloat(&centre, 0.0f);
+    appendAttribute(&header, "screenWindowCenter", "v2f", centre);
+    appendAttribute(&header, "screenWindowWidth", "float", one);
+
+    header.push_back(0);
+
+    m_dataStart = header.size() + 8 * m_height;
+
+    // Each line is its y and size, then the line itself
+    uint64_t lineSize = 8 + 12 * m_width;
+
+    for(int y = 0; y < m_height; ++y) {
+        uint64_t offset = m_dataStart + y * lineSize;
+
+        appendInt(&header, offset & 0xffffffff);
+        appendInt(&header, offset >> 32);
+    }
+
+    if(fwrite(&header[0], 1, header.size(), m_file) != header.size()) {
+        m_failed = true;
+    }
+}
+
+bool FloatWriter::open(const string& filename, int width, int height, Format format) {
+    destroy();
+
+    m_file = fopen(filename.c_str(), "wb");
+
+    if(m_file == NULL) {
+        cerr << "Could not open " << filename << " for writing" << endl;
+        return false;
+    }
+
+    m_failed = false;
+    m_format = format;
+    m_width = width;
+    m_height = height;
+    m_row = 0;
+
+    if(m_format == pfm) {
+        // A negative scale means little endian
+        m_dataStart = fprintf(m_file, "PF\n%d %d\n-1.0\n", width, height);
+        m_failed = m_dataStart < 0;
+
+        m_line.resize(12 * width);
+    } else {
+        writeExrHeader();
+
+        m_line.resize(8 + 12 * width);
+    }
+
+    if(m_failed) {
+        cerr << "Could not write " << filename << endl;
+        destroy();
+        return false;
+    }
+
+    return true;
+}
+
+bool FloatWriter::writeRows(const FrameBuffer& band) {
+    if(m_file == NULL || band.width() != m_width || band.top() != m_row ||
+            m_row + band.rows() > m_height) {
+        return false;
+    }
+
+    for(int y = band.top(); y < band.top() + band.rows(); ++y) {
+        const float* src = band.getPixel(0, y);
+
+        if(m_format == pfm) {
+            // Rows go bottom to top
+            for(int x = 0; x < m_width; ++x, src += 4) {
+                putFloat(&m_line[12 * x], src[2]);
+                putFloat(&m_line[12 * x + 4], src[1]);
+                putFloat(&m_line[12 * x + 8], src[0]);
+            }
+
+            long offset = m_dataStart + (long)(m_height - 1 - y) * m_line.size();
+
+            if(fseek(m_file, offset, SEEK_SET) != 0) {
+                m_failed = true;
+            }
+        } else {
+            putInt(&m_line[0], y);
+            putInt(&m_line[4], 12 * m_width);
+
+            // Each channel's whole line in turn, blue first as in the
+            // buffer's pixels
+            unsigned char* dest = &m_line[8];
+
+            for(int c = 0; c < 3; ++c) {
+                for(int x = 0; x < m_width; ++x, dest += 4) {
+                    putFloat(dest, src[4 * x + c]);
+                }
+            }
+        }
+
+        if(fwrite(&m_line[0], 1, m_line.size(), m_file) != m_line.size()) {
+            m_failed = true;
+        }
+    }
+
+    m_row += band.rows();
+
+    return !m_failed;
+}
+
+bool FloatWriter::close() {
+    if(m_file == NULL || m_row != m_height) {
+        destroy();
+        return false;
+    }
+
+    bool ok = !m_failed && fflush(m_file) == 0 && !ferror(m_file);
+    destroy();
+
+    return ok;
+}
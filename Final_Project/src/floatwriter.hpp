@@ -0,0 +1,53 @@
+#ifndef CS488_FLOATWRITER_HPP
+#define CS488_FLOATWRITER_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "framebuffer.hpp"
+
+// Writes the frame buffer's float colours straight to disk, unclamped
+// and unquantized, for compositing. Bands are given top to bottom as
+// with PngWriter.
+//
+// pfm is the portable float map: a short text header and raw RGB floats.
+// exr is an uncompressed scanline OpenEXR file with 32 bit float R, G and
+// B channels, written without OpenEXR itself.
+class FloatWriter {
+public:
+    enum Format { pfm, exr };
+
+    FloatWriter();
+    ~FloatWriter();
+
+    bool open(const std::string& filename, int width, int height, Format format);
+
+    // Appends every row of band, which must be the next rows of the image
+    bool writeRows(const FrameBuffer& band);
+
+    // Finishes the file. Returns false if anything failed to write.
+    bool close();
+
+    // The format for a file name, by its extension
+    static bool formatFor(const std::string& filename, Format* format);
+
+private:
+    void writeExrHeader();
+    void destroy();
+
+    FILE* m_file;
+    bool m_failed;
+    Format m_format;
+
+    int m_width;
+    int m_height;
+    int m_row;
+
+    // Where the rows start in the file
+    long m_dataStart;
+
+    std::vector<unsigned char> m_line;
+};
+
+#endif
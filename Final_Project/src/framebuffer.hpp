@@ -0,0 +1,119 @@
+#ifndef CS488_FRAMEBUFFER_HPP
+#define CS488_FRAMEBUFFER_HPP
+
+#include <vector>
+#include <QImage>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "algebra.hpp"
+
+// A colour as four floats in the byte order of QImage::Format_RGB32
+// (blue, green, red, alpha), so quantizing it gives the pixel directly
+struct PixelColour {
+    PixelColour() {
+        v[0] = v[1] = v[2] = 0.0f;
+        v[3] = 1.0f;
+    }
+
+    PixelColour(const Colour& colour) {
+        v[0] = colour.B();
+        v[1] = colour.G();
+        v[2] = colour.R();
+        v[3] = 1.0f;
+    }
+
+    float v[4];
+};
+
+// Sums PixelColours with all four channels in one register
+class PixelSum {
+public:
+    PixelSum();
+
+    void add(const PixelColour& colour);
+    void store(float* dest, float scale) const;
+
+private:
+#ifdef __SSE2__
+    __m128 m_sum;
+#else
+    float m_sum[4];
+#endif
+};
+
+// Float colours for every pixel of a frame. Workers write pixels here,
+// and resolve quantizes the whole frame into a QImage in one pass.
+//
+// A buffer can also hold just a band of rows of a larger frame, so huge
+// images can be traced and written out a band at a time. Pixels are
+// still addressed by their row in the whole frame.
+class FrameBuffer {
+public:
+    FrameBuffer(int width, int height);
+
+    // Rows top to top + rows - 1 of a width by height frame
+    FrameBuffer(int width, int height, int top, int rows);
+
+    // Size of the whole frame
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+
+    // The rows held
+    int top() const { return m_top; }
+    int rows() const { return m_rows; }
+
+    float* getPixel(int x, int y) { return &m_data[4 * ((y - m_top) * m_width + x)]; }
+    const float* getPixel(int x, int y) const { return &m_data[4 * ((y - m_top) * m_width + x)]; }
+
+    // img must be Format_RGB32, as wide as the frame and as tall as the
+    // rows held
+    void resolve(QImage* img) const;
+
+private:
+    int m_width;
+    int m_height;
+
+    int m_top;
+    int m_rows;
+
+    std::vector<float> m_data;
+};
+
+#ifdef __SSE2__
+
+inline PixelSum::PixelSum() :
+    m_sum(_mm_setzero_ps())
+{}
+
+inline void PixelSum::add(const PixelColour& colour) {
+    m_sum = _mm_add_ps(m_sum, _mm_loadu_ps(colour.v));
+}
+
+inline void PixelSum::store(float* dest, float scale) const {
+    _mm_storeu_ps(dest, _mm_mul_ps(m_sum, _mm_set1_ps(scale)));
+}
+
+#else
+
+inline PixelSum::PixelSum() {
+    m_sum[0] = m_sum[1] = m_sum[2] = m_sum[3] = 0.0f;
+}
+
+inline void PixelSum::add(const PixelColour& colour) {
+    for(int i = 0; i < 4; ++i) {
+        m_sum[i] += colour.v[i];
+    }
+}
+
+inline void PixelSum::store(float* dest, float scale) const {
+    for(int i = 0; i < 4; ++i) {
+        dest[i] = m_sum[i] * scale;
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,130 @@
+#include "frustum.hpp"
+
+#include <math.h>
+#include <limits>
+
+using std::vector;
+
+// Directions further than this from the frustum's axis (as a cosine)
+// would make the side planes fold over, so such packets aren't bounded
+#define MIN_AXIS_COS 0.05
+
+// Slopes are widened by this much so rays on the boundary stay inside
+#define SLOPE_SLACK 1.0e-9
+
+static bool samePoint(const Point3D& a, const Point3D& b) {
+    return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+}
+
+void Frustum::addPlane(const Vector3D& normal, double offset) {
+    m_normals[m_numPlanes] = normal;
+    m_offsets[m_numPlanes] = offset;
+    ++m_numPlanes;
+}
+
+/*  build
+ *
+ *  Each direction is measured by its slopes d.u / d.axis and
+ *  d.v / d.axis, where the axis is the average direction. The smallest
+ *  and largest slopes on each side give the four side planes. For camera
+ *  rays, whose directions are linear across the image plane, the slopes
+ *  of the corner rays already bound every ray in between.
+ */
+bool Frustum::build(const vector<Ray*>& rays) {
+    m_valid = false;
+    m_numPlanes = 0;
+
+    const Ray* first = NULL;
+    Vector3D axis(0.0, 0.0, 0.0);
+
+    for(auto it = rays.begin(); it != rays.end(); ++it) {
+        if(*it == NULL) {
+            continue;
+        }
+
+        if(first == NULL) {
+            first = *it;
+        } else if(!samePoint((*it)->getOrigin(), first->getOrigin())) {
+            return false;
+        }
+
+        axis = axis + (*it)->getDirection();
+    }
+
+    if(first == NULL || axis.length2() < 1.0e-20) {
+        return false;
+    }
+
+    axis.normalize();
+    m_apex = first->getOrigin();
+
+    // Any vector not parallel to the axis gives the other two
+    Vector3D helper = (fabs(axis[0]) < 0.5) ? Vector3D(1.0, 0.0, 0.0) : Vector3D(0.0, 1.0, 0.0);
+    Vector3D u = axis.cross(helper);
+    u.normalize();
+    Vector3D v = axis.cross(u);
+
+    double uMin = std::numeric_limits<double>::infinity();
+    double uMax = -uMin;
+    double vMin = uMin;
+    double vMax = -uMin;
+
+    bool finite = true;
+    double far = 0.0;
+
+    for(auto it = rays.begin(); it != rays.end(); ++it) {
+        if(*it == NULL) {
+            continue;
+        }
+
+        const Vector3D& d = (*it)->getDirection();
+        double along = d.dot(axis);
+
+        if(along < MIN_AXIS_COS) {
+            return false;
+        }
+
+        double su = d.dot(u) / along;
+        double sv = d.dot(v) / along;
+
+        uMin = fmin(uMin, su);
+        uMax = fmax(uMax, su);
+        vMin = fmin(vMin, sv);
+        vMax = fmax(vMax, sv);
+
+        if((*it)->hasEndpoint()) {
+            far = fmax(far, ((*it)->getLength() + (*it)->getEpsilon()) * along);
+        } else {
+            finite = false;
+        }
+    }
+
+    uMin -= SLOPE_SLACK * (1.0 + fabs(uMin));
+    uMax += SLOPE_SLACK * (1.0 + fabs(uMax));
+    vMin -= SLOPE_SLACK * (1.0 + fabs(vMin));
+    vMax += SLOPE_SLACK * (1.0 + fabs(vMax));
+
+    // (p - apex).u >= uMin (p - apex).axis, and so on
+    Vector3D normals[4] = {
+        u - uMin * axis,
+        uMax * axis - u,
+        v - vMin * axis,
+        vMax * axis - v
+    };
+
+    Vector3D apex(m_apex);
+
+    for(int i = 0; i < 4; ++i) {
+        addPlane(normals[i], normals[i].dot(apex));
+    }
+
+    addPlane(axis, axis.dot(apex));
+
+    if(finite) {
+        double slack = SLOPE_SLACK * (1.0 + far);
+        addPlane(-axis, -axis.dot(apex) - far - slack);
+    }
+
+    m_valid = true;
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef CS488_FRUSTUM_HPP
+#define CS488_FRUSTUM_HPP
+
+#include <math.h>
+#include <vector>
+
+#include "algebra.hpp"
+#include "ray.hpp"
+
+// The planes bounding a set of rays that leave the same point, such as
+// the camera rays of a packet or the shadow rays from a point light.
+// Four planes through the apex bound the directions, a near plane drops
+// what is behind the apex, and a far plane is added when every ray ends.
+class Frustum {
+public:
+    Frustum() : m_valid(false), m_numPlanes(0) {}
+
+    // False if the rays don't share an origin or spread too wide to be
+    // bounded this way, in which case nothing is ever culled
+    bool build(const std::vector<Ray*>& rays);
+
+    bool isValid() const { return m_valid; }
+
+    // True only if the box is wholly outside one of the planes
+    bool cullsBox(const Point3D& min, const Point3D& max) const;
+
+private:
+    void addPlane(const Vector3D& normal, double offset);
+
+    bool m_valid;
+
+    Point3D m_apex;
+
+    // Points p inside satisfy m_normals[i].dot(p) >= m_offsets[i]
+    Vector3D m_normals[6];
+    double m_offsets[6];
+    int m_numPlanes;
+};
+
+inline bool Frustum::cullsBox(const Point3D& min, const Point3D& max) const {
+    for(int i = 0; i < m_numPlanes; ++i) {
+        const Vector3D& n = m_normals[i];
+
+        // The corner furthest along the normal
+        double dist = n[0] * (n[0] > 0.0 ? max[0] : min[0]) +
+                      n[1] * (n[1] > 0.0 ? max[1] : min[1]) +
+                      n[2] * (n[2] > 0.0 ? max[2] : min[2]);
+
+        if(dist < m_offsets[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#endif
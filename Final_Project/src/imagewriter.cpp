@@ -0,0 +1,75 @@
+#include "imagewriter.hpp"
+
+#include <algorithm>
+#include <string.h>
+#include <QString>
+
+using std::max;
+using std::string;
+
+// Largest band of an image traced and written at once, in pixels
+#define BAND_PIXELS (1 << 20)
+
+ImageWriter::ImageWriter() :
+    m_kind(other), m_failed(false)
+{}
+
+int ImageWriter::getBandRows(int width, int tileHeight) {
+    tileHeight = max(1, tileHeight);
+    return max(1, BAND_PIXELS / (max(1, width) * tileHeight)) * tileHeight;
+}
+
+bool ImageWriter::open(const string& filename, int width, int height) {
+    m_filename = filename;
+    m_failed = false;
+
+    FloatWriter::Format format;
+
+    if(QString::fromStdString(filename).endsWith(".png", Qt::CaseInsensitive)) {
+        m_kind = png;
+        return m_png.open(filename, width, height);
+    } else if(FloatWriter::formatFor(filename, &format)) {
+        m_kind = floats;
+        return m_floats.open(filename, width, height, format);
+    }
+
+    m_kind = other;
+    m_whole = QImage(width, height, QImage::Format_RGB32);
+
+    return true;
+}
+
+bool ImageWriter::writeRows(const FrameBuffer& band) {
+    if(m_kind == floats) {
+        m_failed = !m_floats.writeRows(band) || m_failed;
+        return !m_failed;
+    }
+
+    QImage img(band.width(), band.rows(), QImage::Format_RGB32);
+    band.resolve(&img);
+
+    if(m_kind == png) {
+        m_failed = !m_png.writeRows(img) || m_failed;
+    } else {
+        for(int y = 0; y < band.rows(); ++y) {
+            memcpy(m_whole.scanLine(band.top() + y), img.constScanLine(y), 4 * band.width());
+        }
+    }
+
+    return !m_failed;
+}
+
+bool ImageWriter::close() {
+    bool ok;
+
+    if(m_kind == png) {
+        ok = m_png.close();
+    } else if(m_kind == floats) {
+        ok = m_floats.close();
+    } else {
+        ok = m_whole.save(QString::fromStdString(m_filename));
+        m_whole = QImage();
+    }
+
+    return ok && !m_failed;
+}
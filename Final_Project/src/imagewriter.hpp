@@ -0,0 +1,42 @@
+#ifndef CS488_IMAGEWRITER_HPP
+#define CS488_IMAGEWRITER_HPP
+
+#include <string>
+#include <QImage>
+
+#include "floatwriter.hpp"
+#include "framebuffer.hpp"
+#include "pngwriter.hpp"
+
+// Writes an image band by band in the format its file name asks for.
+// PNGs and float PFM and EXR files are streamed as bands arrive; any
+// other format is gathered into one QImage for Qt to save at close.
+class ImageWriter {
+public:
+    ImageWriter();
+
+    bool open(const std::string& filename, int width, int height);
+
+    // Appends band, which must be the next rows of the image
+    bool writeRows(const FrameBuffer& band);
+
+    // Finishes the file. Returns false if anything failed to write.
+    bool close();
+
+    // Rows in a band of whole tiles tileHeight pixels high, so a band of
+    // an image width pixels across stays near a fixed number of pixels
+    static int getBandRows(int width, int tileHeight);
+
+private:
+    enum Kind { png, floats, other };
+
+    std::string m_filename;
+    Kind m_kind;
+    bool m_failed;
+
+    PngWriter m_png;
+    FloatWriter m_floats;
+    QImage m_whole;
+};
+
+#endif
@@ -5,8 +5,13 @@
 using std::cout;
 using std::endl;
 
+ShadingRecord::ShadingRecord() :
+    shininess(0.0), transmitRatio(0.0), medium(1.0), diffuse(false), specular(false)
+{}
+
 Intersection::Intersection(const Point3D& point, double t, Primitive* primitive, const Vector3D& normal):
-    m_point(point), m_param(t), m_primitive(primitive), m_normal(normal)
+    m_point(point), m_param(t), m_primitive(primitive), m_normal(normal), m_footprint(0.0), 
+    m_finalized(false)
 {
 }
 
@@ -18,6 +23,11 @@ Intersection::Intersection(const Intersection& other) {
 
     m_primitive = other.m_primitive;
     m_normal = other.m_normal;
+
+    m_footprint = other.m_footprint;
+
+    m_shading = other.m_shading;
+    m_finalized = other.m_finalized;
 }
 
 Intersection& Intersection::operator=(const Intersection& other) {
@@ -27,11 +37,40 @@ Intersection& Intersection::operator=(const Intersection& other) {
 
         m_primitive = other.m_primitive;
         m_normal = other.m_normal;
+
+        m_footprint = other.m_footprint;
+
+        m_shading = other.m_shading;
+        m_finalized = other.m_finalized;
     }
     return *this;
 }
 
+void Intersection::finalize(const Ray& ray) {
+    m_footprint = ray.getFootprint(m_point);
+
+    PhongMaterial* material = m_primitive->getMaterial();
+
+    m_shading.normal = getNormal();
+    m_shading.albedo = m_primitive->getColour(m_point, m_footprint);
+
+    m_shading.ks = material->getKS();
+    m_shading.shininess = material->getShininess();
+
+    m_shading.transmitRatio = material->getTransmitRatio();
+    m_shading.medium = material->getMedium();
+
+    m_shading.diffuse = material->isDiffuse();
+    m_shading.specular = material->isSpecular();
+
+    m_finalized = true;
+}
+
 Vector3D Intersection::getNormal() const {
+    if(m_finalized) {
+        return m_shading.normal;
+    }
+
     if(m_primitive->getBump() == NULL) {
         return m_normal;
     }
@@ -44,20 +83,6 @@ Vector3D Intersection::getNormal() const {
     return newNormal;
 }
 
-Colour Intersection::getDiffuse() const {
-    return m_primitive->getColour(m_point);    
-}
-
-Colour Intersection::getSpecular() const {
-    PhongMaterial* material = m_primitive->getMaterial();
-    return material->getKS();
-}
-
-Colour Intersection::getShininess() const {
-    PhongMaterial* material = m_primitive->getMaterial();
-    return material->getShininess();
-}
-
 std::ostream& operator<<(std::ostream& out, const Intersection& isect)
 {
     out << "I[" << isect.getPoint() << ", " << isect.getParam() << ", "
@@ -2,12 +2,31 @@
 #define INTERSECTION_HPP
 
 #include "algebra.hpp"
+#include "ray.hpp"
 
 class Primitive;
 
+// What shading needs to know about a hit. Intersection::finalize fills
+// it in once, so shading never goes back to the primitive or material.
+struct ShadingRecord {
+    ShadingRecord();
+
+    Vector3D normal;
+
+    Colour albedo;
+    Colour ks;
+    double shininess;
+
+    double transmitRatio;
+    double medium;
+
+    bool diffuse;
+    bool specular;
+};
+
 class Intersection {
 public:
-    Intersection() {}
+    Intersection() : m_footprint(0.0), m_finalized(false) {}
     Intersection(const Point3D& point, double t, Primitive* primitive, const Vector3D& normal);
 
     ~Intersection();
@@ -19,11 +38,17 @@ public:
     double getParam() const { return m_param; }
     Primitive* getPrimitive() const { return m_primitive; }
 
-    Vector3D getNormal() const ;
+    // Width of the ray's cone at the hit point, used to filter textures
+    double getFootprint() const { return m_footprint; }
+
+    // Called once this is known to be the closest hit along ray. Records
+    // the footprint and resolves the shading record.
+    void finalize(const Ray& ray);
+
+    // Only valid after finalize
+    const ShadingRecord& getShading() const { return m_shading; }
 
-    Colour getDiffuse() const;
-    Colour getSpecular() const;
-    Colour getShininess() const;
+    Vector3D getNormal() const ;
 
 private:
     Point3D m_point;
@@ -31,6 +56,11 @@ private:
 
     Primitive* m_primitive;
     Vector3D m_normal;
+
+    double m_footprint;
+
+    ShadingRecord m_shading;
+    bool m_finalized;
 };
 
 std::ostream& operator<<(std::ostream& out, const Intersection& isect);
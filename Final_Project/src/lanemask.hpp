@@ -0,0 +1,139 @@
+#ifndef CS488_LANEMASK_HPP
+#define CS488_LANEMASK_HPP
+
+#include <assert.h>
+#include <stdint.h>
+
+// The largest packet a mask can describe
+#define MAX_LANES 256
+
+class LaneIterator;
+
+// One bit per ray of a packet. A LaneIterator visits only the set lanes
+// and skips clear words whole, so lanes that are done cost nothing.
+class LaneMask {
+public:
+    LaneMask() : m_numWords(0) {}
+
+    // numLanes lanes, all clear
+    explicit LaneMask(int numLanes);
+
+    void set(int lane) { m_words[lane >> 6] |= (uint64_t)1 << (lane & 63); }
+    void clear(int lane) { m_words[lane >> 6] &= ~((uint64_t)1 << (lane & 63)); }
+    bool get(int lane) const { return (m_words[lane >> 6] >> (lane & 63)) & 1; }
+
+    bool any() const;
+    int count() const;
+
+    // The lowest set lane, or -1 if there are none
+    int first() const;
+
+    // The four lanes from lane, which must be a multiple of four, as the
+    // low bits of the result
+    unsigned int getFour(int lane) const { return (m_words[lane >> 6] >> (lane & 63)) & 0xf; }
+
+    // Clears the lanes of the four from lane that are set in bits
+    void clearFour(int lane, unsigned int bits) { m_words[lane >> 6] &= ~((uint64_t)bits << (lane & 63)); }
+
+    LaneMask& operator&=(const LaneMask& other);
+
+    // Clears every lane set in other
+    void remove(const LaneMask& other);
+
+private:
+    friend class LaneIterator;
+
+    uint64_t m_words[MAX_LANES / 64];
+    int m_numWords;
+};
+
+// Walks the lanes that were set when it was made, lowest first:
+//
+//     LaneIterator it(mask);
+//     for(int i = it.next(); i >= 0; i = it.next()) { ... }
+//
+// Changing the mask during the walk doesn't change what is visited.
+class LaneIterator {
+public:
+    LaneIterator(const LaneMask& mask) :
+        m_mask(mask), m_word(0), m_bits(mask.m_numWords > 0 ? mask.m_words[0] : 0) {}
+
+    int next();
+
+private:
+    LaneMask m_mask;
+
+    int m_word;
+    uint64_t m_bits;
+};
+
+inline LaneMask::LaneMask(int numLanes) {
+    assert(numLanes <= MAX_LANES);
+
+    m_numWords = (numLanes + 63) / 64;
+
+    for(int i = 0; i < m_numWords; ++i) {
+        m_words[i] = 0;
+    }
+}
+
+inline bool LaneMask::any() const {
+    for(int i = 0; i < m_numWords; ++i) {
+        if(m_words[i] != 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline int LaneMask::count() const {
+    int count = 0;
+
+    for(int i = 0; i < m_numWords; ++i) {
+        count += __builtin_popcountll(m_words[i]);
+    }
+
+    return count;
+}
+
+inline int LaneMask::first() const {
+    for(int i = 0; i < m_numWords; ++i) {
+        if(m_words[i] != 0) {
+            return (i << 6) + __builtin_ctzll(m_words[i]);
+        }
+    }
+
+    return -1;
+}
+
+inline LaneMask& LaneMask::operator&=(const LaneMask& other) {
+    for(int i = 0; i < m_numWords; ++i) {
+        m_words[i] &= other.m_words[i];
+    }
+
+    return *this;
+}
+
+inline void LaneMask::remove(const LaneMask& other) {
+    for(int i = 0; i < m_numWords; ++i) {
+        m_words[i] &= ~other.m_words[i];
+    }
+}
+
+inline int LaneIterator::next() {
+    while(m_bits == 0) {
+        if(++m_word >= m_mask.m_numWords) {
+            return -1;
+        }
+
+        m_bits = m_mask.m_words[m_word];
+    }
+
+    int lane = (m_word << 6) + __builtin_ctzll(m_bits);
+    m_bits &= m_bits - 1;
+
+    return lane;
+}
+
+#endif
@@ -10,7 +10,7 @@ Light::Light()
   falloff[2] = 0.0;
 }
 
-Colour Light::getIntensity(Point3D& point) const {
+Colour Light::getIntensity(const Point3D& point) const {
     double r = (point - position).length();
     double ratio;
     
@@ -8,7 +8,7 @@
 struct Light {
   Light();
 
-  Colour getIntensity(Point3D& point) const;
+  Colour getIntensity(const Point3D& point) const;
 
   Colour colour;
   Point3D position;
@@ -1,11 +1,70 @@
 #include <iostream>
+#include <stdlib.h>
+#include "farm.hpp"
 #include "scene_lua.hpp"
 
+static void usage()
+{
+  std::cerr << "Usage: rt [scene.lua]" << std::endl
+            << "       rt --farm workers [--command cmd] [--samples n] [--tile packets]"
+            << " [--threads n] [--timeout seconds] scene.lua" << std::endl
+            << "       rt --worker [--threads n] [--fail-after tiles] [--stall-after tiles]"
+            << " scene.lua" << std::endl;
+}
+
 int main(int argc, char** argv)
 {
   std::string filename = "tetris.lua";
-  if (argc >= 2) {
-    filename = argv[1];
+
+  bool farm = false;
+  bool worker = false;
+  FarmOptions options;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (arg == "--farm" && hasValue) {
+      farm = true;
+      options.workers = atoi(argv[++i]);
+    } else if (arg == "--worker") {
+      worker = true;
+    } else if (arg == "--command" && hasValue) {
+      options.command = argv[++i];
+    } else if (arg == "--samples" && hasValue) {
+      options.sampleWidth = atoi(argv[++i]);
+    } else if (arg == "--tile" && hasValue) {
+      options.tilePackets = atoi(argv[++i]);
+    } else if (arg == "--threads" && hasValue) {
+      options.threads = atoi(argv[++i]);
+    } else if (arg == "--timeout" && hasValue) {
+      options.timeout = atoi(argv[++i]);
+    } else if (arg == "--fail-after" && hasValue) {
+      options.failAfter = atoi(argv[++i]);
+    } else if (arg == "--stall-after" && hasValue) {
+      options.stallAfter = atoi(argv[++i]);
+    } else if (arg[0] != '-') {
+      filename = arg;
+    } else {
+      usage();
+      return 1;
+    }
+  }
+
+  if ((farm && worker) || options.workers < 1 || options.sampleWidth < 1 ||
+      options.tilePackets < 1 || options.threads < 1 || options.timeout < 1) {
+    usage();
+    return 1;
+  }
+
+  if (farm) {
+    FarmMaster master(filename, options);
+    return master.render() ? 0 : 1;
+  }
+
+  if (worker) {
+    FarmWorker farmWorker(filename, options);
+    return farmWorker.run() ? 0 : 1;
   }
 
   if (!run_lua(filename)) {
@@ -13,4 +72,3 @@ int main(int argc, char** argv)
     return 1;
   }
 }
-
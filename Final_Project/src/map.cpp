@@ -1,6 +1,8 @@
 #include "map.hpp"
 
 #include <QColor>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 using std::cout;
@@ -10,9 +12,80 @@ Map::Map(const char* filename) {
     m_img.load(QString(filename));
 }
 
+//***************************** MipLevel *******************************
+
+MipLevel::MipLevel(int width, int height) :
+    m_width(width), m_height(height), m_tilesPerRow((width + 3) / 4)
+{
+    m_texels.assign(16 * m_tilesPerRow * ((height + 3) / 4), 0);
+}
+
+//***************************** Texture ********************************
+
+// Box filters a level down to half its size, clamping at odd edges
+static MipLevel downsample(const MipLevel& level) {
+    int width = std::max(1, (level.width() + 1) / 2);
+    int height = std::max(1, (level.height() + 1) / 2);
+
+    MipLevel next(width, height);
+
+    for(int j = 0; j < height; ++j) {
+        for(int i = 0; i < width; ++i) {
+            int i0 = std::min(2*i, level.width() - 1);
+            int i1 = std::min(2*i + 1, level.width() - 1);
+            int j0 = std::min(2*j, level.height() - 1);
+            int j1 = std::min(2*j + 1, level.height() - 1);
+
+            uint t00 = level.get(i0, j0);
+            uint t01 = level.get(i0, j1);
+            uint t10 = level.get(i1, j0);
+            uint t11 = level.get(i1, j1);
+
+            uint texel = 0;
+
+            for(int shift = 0; shift < 32; shift += 8) {
+                uint sum = ((t00 >> shift) & 0xff) + ((t01 >> shift) & 0xff) + 
+                    ((t10 >> shift) & 0xff) + ((t11 >> shift) & 0xff);
+
+                texel |= ((sum + 2) / 4) << shift;
+            }
+
+            next.set(i, j, texel);
+        }
+    }
+
+    return next;
+}
+
+// Converts the image into the mip pyramid once, so lookups never go
+// through QImage
 Texture::Texture(const char* filename) :
     Map(filename)
-{}
+{
+    if(m_img.isNull()) {
+        m_levels.push_back(MipLevel(1, 1));
+        return;
+    }
+
+    QImage img = m_img.convertToFormat(QImage::Format_RGB32);
+    m_img = QImage();
+
+    MipLevel base(img.width(), img.height());
+
+    for(int j = 0; j < img.height(); ++j) {
+        const uint* line = (const uint*)img.constScanLine(j);
+
+        for(int i = 0; i < img.width(); ++i) {
+            base.set(i, j, line[i]);
+        }
+    }
+
+    m_levels.push_back(base);
+
+    while(m_levels.back().width() > 1 || m_levels.back().height() > 1) {
+        m_levels.push_back(downsample(m_levels.back()));
+    }
+}
 
 static double clamp(double val, double min, double max) {
     if(val > max) {
@@ -24,52 +97,109 @@ static double clamp(double val, double min, double max) {
     }
 }
 
-// Uses Texture Mapping method described in class
-Colour Texture::getColour(const Point2D& point) {
-    double dx = (m_img.width() - 2) * clamp(point[0], 0.0, 1.0);
-    double dy = (m_img.height() - 2) * clamp(point[1], 0.0, 1.0);
+static Colour toColour(uint texel) {
+    const double scale = 1.0 / 255.0;
 
-    int i = (int)dx;
-    int j = (int)dy;
+    return Colour(scale * qRed(texel), scale * qGreen(texel), scale * qBlue(texel));
+}
+
+// Bilinear lookup within a single level. Texture coordinates cover
+// texels 0 to width - 2 of the full size image, as they did before
+// textures were mip-mapped, so the base level looks the same. Coarser
+// levels take the same spot, moved onto their own texel centres.
+Colour Texture::sample(int level, const Point2D& point) const {
+    const MipLevel& base = m_levels.front();
+    const MipLevel& mip = m_levels.at(level);
+
+    double dx = std::max(base.width() - 2, 0) * clamp(point[0], 0.0, 1.0);
+    double dy = std::max(base.height() - 2, 0) * clamp(point[1], 0.0, 1.0);
+
+    if(level > 0) {
+        double size = (double)(1 << level);
+
+        dx = clamp((dx + 0.5) / size - 0.5, 0.0, mip.width() - 1);
+        dy = clamp((dy + 0.5) / size - 0.5, 0.0, mip.height() - 1);
+    }
+
+    int i = std::min((int)dx, std::max(mip.width() - 2, 0));
+    int j = std::min((int)dy, std::max(mip.height() - 2, 0));
+
+    int i1 = std::min(i + 1, mip.width() - 1);
+    int j1 = std::min(j + 1, mip.height() - 1);
 
     double up = dx - i;
     double vp = dy - j;
 
-    QColor c00 = QColor(m_img.pixel(i, j));
-    QColor c01 = QColor(m_img.pixel(i, j+1));
-    QColor c10 = QColor(m_img.pixel(i+1, j));
-    QColor c11 = QColor(m_img.pixel(i+1, j+1));
+    Colour d00 = toColour(mip.get(i, j));
+    Colour d01 = toColour(mip.get(i, j1));
+    Colour d10 = toColour(mip.get(i1, j));
+    Colour d11 = toColour(mip.get(i1, j1));
 
-    Colour d00 = Colour(c00.redF(), c00.greenF(), c00.blueF());
-    Colour d01 = Colour(c01.redF(), c01.greenF(), c01.blueF());
-    Colour d10 = Colour(c10.redF(), c10.greenF(), c10.blueF());
-    Colour d11 = Colour(c11.redF(), c11.greenF(), c11.blueF());
+    return d00*(1-up)*(1-vp) + d01*(1-up)*vp + d10*(1-vp)*up + d11*up*vp;
+}
+
+// Picks the level whose texels match the footprint and blends it with
+// the next coarser one
+Colour Texture::getColour(const Point2D& point, double footprint) {
+    const MipLevel& base = m_levels.front();
+    double texels = footprint * std::max(base.width(), base.height());
+
+    if(texels <= 1.0 || m_levels.size() == 1) {
+        return sample(0, point);
+    }
 
-    Colour interp = d00*(1-up)*(1-vp) + d01*(1-up)*vp + d10*(1-vp)*up + d11*up*vp;
+    double lod = std::min(log2(texels), (double)(m_levels.size() - 1));
 
-    return interp;
+    int level = (int)lod;
+    double frac = lod - level;
+
+    Colour colour = sample(level, point);
+
+    if(frac > 1.0e-3 && level + 1 < (int)m_levels.size()) {
+        colour = (1.0 - frac) * colour + frac * sample(level + 1, point);
+    }
+
+    return colour;
 }
 
+//******************************* Bump *********************************
+
+// Takes the blue channel as the height field and stores its gradient for
+// every texel far enough from the border
 Bump::Bump(const char* filename) :
-    Map(filename)
-{}
+    Map(filename), m_width(m_img.width()), m_height(m_img.height())
+{
+    m_gradients.assign(2 * m_width * m_height, 0.0f);
+
+    QImage img = m_img.convertToFormat(QImage::Format_RGB32);
+    m_img = QImage();
+
+    for(int j = 2; j < m_height - 2; ++j) {
+        const uint* line = (const uint*)img.constScanLine(j);
+        const uint* up = (const uint*)img.constScanLine(j - 2);
+        const uint* down = (const uint*)img.constScanLine(j + 2);
+
+        for(int i = 2; i < m_width - 2; ++i) {
+            float* gradient = &m_gradients[2 * (j * m_width + i)];
+
+            gradient[0] = (int)qBlue(line[i + 2]) - (int)qBlue(line[i - 2]);
+            gradient[1] = (int)qBlue(down[i]) - (int)qBlue(up[i]);
+        }
+    }
+}
 
 Point2D Bump::getOffset(const Point2D& point) {
-    double dx = (m_img.width() - 5) * clamp(point[0], 0.0, 1.0) + 2;
-    double dy = (m_img.height() - 5) * clamp(point[1], 0.0, 1.0) + 2;
+    if(m_width < 5 || m_height < 5) {
+        return Point2D(0.0, 0.0);
+    }
+
+    double dx = (m_width - 5) * clamp(point[0], 0.0, 1.0) + 2;
+    double dy = (m_height - 5) * clamp(point[1], 0.0, 1.0) + 2;
 
     int i = (int)dx;
     int j = (int)dy;
 
-    int h01 = qBlue(m_img.pixel(i-2, j));
-
-    int h10 = qBlue(m_img.pixel(i, j-2));
-    int h12 = qBlue(m_img.pixel(i, j+2));
-
-    int h21 = qBlue(m_img.pixel(i+2, j));
-    
-    double du = (h21 - h01);
-    double dv = (h12 - h10);
+    const float* gradient = &m_gradients[2 * (j * m_width + i)];
 
-    return Point2D(du, dv);
+    return Point2D(gradient[0], gradient[1]);
 }
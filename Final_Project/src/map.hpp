@@ -1,6 +1,7 @@
 #ifndef CS488_MAP_HPP
 #define CS488_MAP_HPP
 
+#include <vector>
 #include <QImage>
 #include "algebra.hpp"
 
@@ -12,11 +13,41 @@ protected:
     QImage m_img;
 };
 
+// One level of a texture's mip pyramid. Texels are packed 0xAARRGGBB and
+// stored in 4x4 tiles, so a bilinear lookup usually stays in one tile.
+class MipLevel {
+public:
+    MipLevel(int width, int height);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+
+    uint get(int i, int j) const { return m_texels[getIndex(i, j)]; }
+    void set(int i, int j, uint texel) { m_texels[getIndex(i, j)] = texel; }
+
+private:
+    int getIndex(int i, int j) const {
+        return (((j >> 2) * m_tilesPerRow + (i >> 2)) << 4) + ((j & 3) << 2) + (i & 3);
+    }
+
+    int m_width;
+    int m_height;
+    int m_tilesPerRow;
+
+    std::vector<uint> m_texels;
+};
+
 class Texture : public Map {
 public:
     Texture(const char* filename);
 
-    Colour getColour(const Point2D& point);
+    // footprint is the width of the lookup in texture coordinates
+    Colour getColour(const Point2D& point, double footprint);
+
+private:
+    Colour sample(int level, const Point2D& point) const;
+
+    std::vector<MipLevel> m_levels;
 };
 
 class Bump : public Map {
@@ -24,6 +55,13 @@ public:
     Bump(const char* filename);
 
     Point2D getOffset(const Point2D& point);
+
+private:
+    int m_width;
+    int m_height;
+
+    // Height differences (du, dv) across 4 texels for every texel
+    std::vector<float> m_gradients;
 };
 
 #endif
@@ -39,26 +39,29 @@ static double clamp(double val, double min, double max) {
  *      light: the light source 
  */
 Colour PhongMaterial::getColour(const Vector3D& l, const Vector3D& v, const Intersection* isect, const Light& light) {
+    return getLighting(l, v, isect->getShading(), isect->getPoint(), light);
+}
+
+Colour PhongMaterial::getLighting(const Vector3D& l, const Vector3D& v, const ShadingRecord& shading, 
+        const Point3D& point, const Light& light) 
+{
     Colour colour(0.0, 0.0, 0.0);
 
     Vector3D l_norm = l;
     Vector3D v_norm = v;
 
-    Vector3D normal = isect->getNormal();
+    Vector3D normal = shading.normal;
 
     if(v_norm.dot(normal) < 0) {
         normal = -normal;
     }
 
-    Point3D point = isect->getPoint();
     Colour intensity = light.getIntensity(point);
 
-    Colour kd = isect->getDiffuse();
-
-    colour += kd * intensity * clamp(l_norm.dot(normal), 0.0, 1.0);
+    colour += shading.albedo * intensity * clamp(l_norm.dot(normal), 0.0, 1.0);
 
     Vector3D r = - l_norm + 2 * normal * l_norm.dot(normal);
-    colour += m_ks * pow(clamp(r.dot(v_norm), 0.0, 1.0), m_shininess) * intensity;
+    colour += shading.ks * pow(clamp(r.dot(v_norm), 0.0, 1.0), shading.shininess) * intensity;
 
     return colour;
 }
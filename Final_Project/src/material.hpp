@@ -24,6 +24,10 @@ public:
 
   virtual Colour getColour(const Vector3D& in, const Vector3D& out, const Intersection* isect, const Light& light);
 
+  // Phong lighting from a finalized hit, without going through the material
+  static Colour getLighting(const Vector3D& in, const Vector3D& out, const ShadingRecord& shading, 
+    const Point3D& point, const Light& light);
+
   Colour getKD() const { return m_kd; }
   Colour getKS() const { return m_ks; }
 
@@ -1,5 +1,10 @@
 #include "mesh.hpp"
+#include "pool.hpp"
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
 
 using std::cout;
 using std::endl;
@@ -18,13 +23,188 @@ static Vector3D getLineNormal(const Point3D& p1, const Point3D& p2, const Point3
     return normal;
 }
 
+// ************************** TriangleMesh *******************************
+
+TriangleMesh::TriangleMesh() :
+    m_numVertices(0)
+{}
+
+void TriangleMesh::addVertex(const Point3D& vertex) {
+    for(int i = 0; i < 3; ++i) {
+        m_verts.push_back((float)vertex[i]);
+    }
+
+    ++m_numVertices;
+}
+
+void TriangleMesh::addTriangle(unsigned int a, unsigned int b, unsigned int c) {
+    m_indices.push_back(a);
+    m_indices.push_back(b);
+    m_indices.push_back(c);
+}
+
+void TriangleMesh::finalize(bool quantize) {
+    m_min = Point3D(0, 0, 0);
+    m_max = Point3D(0, 0, 0);
+
+    if(m_numVertices > 0) {
+        m_min = m_max = getVertex(0);
+    }
+
+    for(int i = 1; i < m_numVertices; ++i) {
+        Point3D vertex = getVertex(i);
+
+        m_min = Point3D::min(m_min, vertex);
+        m_max = Point3D::max(m_max, vertex);
+    }
+
+    if(!quantize) {
+        std::vector<float>(m_verts).swap(m_verts);
+        std::vector<unsigned int>(m_indices).swap(m_indices);
+        return;
+    }
+
+    for(int i = 0; i < 3; ++i) {
+        m_step[i] = (m_max[i] - m_min[i]) / 65535.0;
+    }
+
+    m_quantized.resize(m_verts.size());
+
+    for(int i = 0; i < (int)m_verts.size(); ++i) {
+        int axis = i % 3;
+        double step = m_step[axis] > 0.0 ? m_step[axis] : 1.0;
+
+        m_quantized[i] = (unsigned short)floor((m_verts[i] - m_min[axis]) / step + 0.5);
+    }
+
+    std::vector<float>().swap(m_verts);
+    std::vector<unsigned int>(m_indices).swap(m_indices);
+}
+
+// Parses one vertex reference of a face ("7", "7/2" or "7/2/4").
+// Negative references count back from the last vertex read.
+static bool parseObjIndex(char** str, int numVertices, unsigned int* index) {
+    char* end;
+    long value = strtol(*str, &end, 10);
+
+    if(end == *str) {
+        return false;
+    }
+
+    while(*end != '\0' && *end != ' ' && *end != '\t' && *end != '\r' && *end != '\n') {
+        ++end;
+    }
+
+    *str = end;
+
+    if(value < 0) {
+        value += numVertices + 1;
+    }
+
+    if(value < 1 || value > numVertices) {
+        return false;
+    }
+
+    *index = (unsigned int)(value - 1);
+    return true;
+}
+
+TriangleMesh* TriangleMesh::readObj(const std::string& filename, bool quantize) {
+    FILE* file = fopen(filename.c_str(), "r");
+
+    if(file == NULL) {
+        return NULL;
+    }
+
+    TriangleMesh* mesh = new TriangleMesh();
+
+    char line[1024];
+    std::vector<unsigned int> face;
+
+    while(fgets(line, sizeof(line), file) != NULL) {
+        if(line[0] == 'v' && (line[1] == ' ' || line[1] == '\t')) {
+            char* str = line + 2;
+            Point3D vertex;
+
+            for(int i = 0; i < 3; ++i) {
+                vertex[i] = strtod(str, &str);
+            }
+
+            mesh->addVertex(vertex);
+
+        } else if(line[0] == 'f' && (line[1] == ' ' || line[1] == '\t')) {
+            char* str = line + 2;
+            unsigned int index;
+
+            face.clear();
+
+            while(parseObjIndex(&str, mesh->m_numVertices, &index)) {
+                face.push_back(index);
+            }
+
+            for(uint i = 1; i + 1 < face.size(); ++i) {
+                mesh->addTriangle(face[0], face[i], face[i + 1]);
+            }
+        }
+    }
+
+    fclose(file);
+
+    mesh->finalize(quantize);
+    return mesh;
+}
+
 // ****************************** Mesh ***********************************
 
+static bool allTriangles(const std::vector< std::vector<int> >& faces) {
+    for(auto it = faces.begin(); it != faces.end(); ++it) {
+        if(it->size() != 3) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Faces are read without bounds checks once built, so an index past the
+// vertices throws out_of_range here instead
+static void checkFaces(int numVertices, const std::vector< std::vector<int> >& faces) {
+    for(auto it = faces.begin(); it != faces.end(); ++it) {
+        for(auto index = it->begin(); index != it->end(); ++index) {
+            if(*index < 0 || *index >= numVertices) {
+                throw std::out_of_range("Mesh face refers to a missing vertex");
+            }
+        }
+    }
+}
+
 Mesh::Mesh(const std::vector<Point3D>& verts,
-           const std::vector< std::vector<int> >& faces)
-  : m_verts(verts),
-    m_faces(faces)
+           const std::vector< std::vector<int> >& faces, bool quantize)
+  : m_triangles(NULL), m_ownsTriangles(false)
 {
+    checkFaces(verts.size(), faces);
+
+    if(allTriangles(faces)) {
+        m_triangles = new TriangleMesh();
+        m_ownsTriangles = true;
+
+        for(auto it = verts.begin(); it != verts.end(); ++it) {
+            m_triangles->addVertex(*it);
+        }
+
+        for(auto it = faces.begin(); it != faces.end(); ++it) {
+            m_triangles->addTriangle(it->at(0), it->at(1), it->at(2));
+        }
+
+        m_triangles->finalize(quantize);
+        setBBox(m_triangles->getMin(), m_triangles->getMax());
+
+        return;
+    }
+
+    m_verts = verts;
+    m_faces = faces;
+
     Point3D a_min = verts.at(0);
     Point3D a_max = verts.at(0);
 
@@ -42,17 +222,43 @@ Mesh::Mesh(const std::vector<Point3D>& verts,
     setBBox(a_min, a_max);
 }
 
+Mesh::Mesh(TriangleMesh* triangles) :
+    m_triangles(triangles), m_ownsTriangles(true)
+{
+    setBBox(m_triangles->getMin(), m_triangles->getMax());
+}
+
+Mesh::~Mesh() {
+    if(m_ownsTriangles) {
+        delete m_triangles;
+    }
+}
+
+// Clones share the triangles of the mesh they were made from, which
+// outlives them in the scene graph
 Mesh::Mesh(const Mesh& other) : Primitive(other)
 {
     m_verts = other.m_verts;
     m_faces = other.m_faces;
+
+    m_triangles = other.m_triangles;
+    m_ownsTriangles = false;
 }
 
 Mesh& Mesh::operator=(const Mesh& other) {
-    Primitive::operator=(other);
+    if(this != &other) {
+        Primitive::operator=(other);
 
-    m_verts = other.m_verts;
-    m_faces = other.m_faces;
+        m_verts = other.m_verts;
+        m_faces = other.m_faces;
+
+        if(m_ownsTriangles) {
+            delete m_triangles;
+        }
+
+        m_triangles = other.m_triangles;
+        m_ownsTriangles = false;
+    }
     
     return *this;
 }
@@ -78,6 +284,10 @@ bool Mesh::getIntersection(const Ray& ray, Intersection* isect) {
     if(!m_modelBBox.intersect(modelRay)) {
         return false;
     }
+
+    if(m_triangles != NULL) {
+        return getTriangleIntersection(modelRay, isect);
+    }
     
     Intersection* best = NULL;
 
@@ -128,6 +338,42 @@ bool Mesh::getIntersection(const Ray& ray, Intersection* isect) {
     return false;
 }
 
+bool Mesh::getTriangleIntersection(const Ray& modelRay, Intersection* isect) {
+    bool hit = false;
+
+    double t_best = 0.0;
+    Vector3D normal;
+
+    for(int i = 0; i < m_triangles->getNumTriangles(); ++i) {
+        const unsigned int* tri = m_triangles->getTriangle(i);
+
+        Point3D v0 = m_triangles->getVertex(tri[0]);
+        Vector3D e1 = m_triangles->getVertex(tri[1]) - v0;
+        Vector3D e2 = m_triangles->getVertex(tri[2]) - v0;
+
+        double t;
+
+        if(getTriangleParam(v0, e1, e2, modelRay, &t) && (!hit || t < t_best)) {
+            if(isect == NULL) {
+                return true;
+            }
+
+            hit = true;
+            t_best = t;
+            normal = e1.cross(e2);
+        }
+    }
+
+    if(hit) {
+        normal = transNorm(m_inv, normal);
+        normal.normalize();
+
+        *isect = Intersection(m_trans * modelRay(t_best), t_best, this, normal);
+    }
+
+    return hit;
+}
+
 bool Mesh::getPolyIntersection(const Face& poly, Intersection* isect) {
     Point3D point = isect->getPoint();
     int n = poly.size();
@@ -184,7 +430,10 @@ Point3D Mesh::getInnerPoint(const Face& poly) {
 }
 
 void Mesh::addMeshPolygons(vector<Primitive*>* primitives) {
-    if(m_faces.at(0).size() == 3) {
+    if(m_triangles != NULL) {
+        primitives->push_back(clone());
+
+    } else if(m_faces.at(0).size() == 3) {
        for(auto it = m_faces.begin(); it != m_faces.end(); ++it) {
             Triangle* poly = new Triangle(m_verts, (*it), m_trans);
 
@@ -217,8 +466,22 @@ void Mesh::addMeshPolygons(vector<Primitive*>* primitives) {
     }
 }
 
+void Mesh::addToPool(PrimitivePool* pool) {
+    if(m_triangles != NULL) {
+        pool->addMesh(this, *m_triangles, m_trans, m_inv);
+    } else {
+        Primitive::addToPool(pool);
+    }
+}
+
 std::ostream& operator<<(std::ostream& out, const Mesh& mesh)
 {
+  if (mesh.m_triangles != NULL) {
+    std::cerr << "mesh(" << mesh.m_triangles->getNumVertices() << " vertices, "
+              << mesh.m_triangles->getNumTriangles() << " triangles);" << std::endl;
+    return out;
+  }
+
   std::cerr << "mesh({";
   for (std::vector<Point3D>::const_iterator I = mesh.m_verts.begin(); I != mesh.m_verts.end(); ++I) {
     if (I != mesh.m_verts.begin()) std::cerr << ",\n      ";
@@ -323,6 +586,14 @@ bool Polygon::getIntersection(const Ray& ray, Intersection* isect) {
     return true;
 }
 
+// Polygons are convex, so a fan covers them. The triangles keep this
+// polygon for shading.
+void Polygon::addToPool(PrimitivePool* pool) {
+    for(uint i = 1; i + 1 < m_verts.size(); ++i) {
+        pool->addTriangle(this, m_verts.at(0), m_verts.at(i), m_verts.at(i + 1));
+    }
+}
+
 bool Polygon::getPlaneIntersection(const Ray& ray, Intersection* isect) {
     Point3D p = m_verts.at(0);
 
@@ -380,7 +651,7 @@ Quad& Quad::operator=(const Quad& other) {
     return *this;
 }
 
-Colour Quad::getColour(const Point3D& point) {
+Colour Quad::getColour(const Point3D& point, double footprint) {
     if(m_texture == NULL) {
         return m_material->getKD();
     }
@@ -390,7 +661,9 @@ Colour Quad::getColour(const Point3D& point) {
     double x = (rotPoint[0] - m_ix[0]) / (m_ix[1] - m_ix[0]);
     double z = (rotPoint[2] - m_iz[0]) / (m_iz[1] - m_iz[0]);
 
-    return m_texture->getColour(Point2D(x, z));
+    double extent = std::min(m_ix[1] - m_ix[0], m_iz[1] - m_iz[0]);
+
+    return m_texture->getColour(Point2D(x, z), footprint / extent);
 }
 
 Vector3D Quad::getOffset(const Point3D& point) {
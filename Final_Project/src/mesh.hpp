@@ -7,12 +7,111 @@
 #include "intersection.hpp"
 
 #include <iosfwd>
+#include <string>
 #include <vector>
 
+// Möller-Trumbore. Sets t and returns true if the line from o along d
+// hits the triangle with corner v0 and edges e1 and e2 within the
+// parameter range of ray.
+inline bool getTriangleParam(const Point3D& v0, const Vector3D& e1, const Vector3D& e2,
+        const Point3D& o, const Vector3D& d, const Ray& ray, double* t)
+{
+    Vector3D p = d.cross(e2);
+    double det = e1.dot(p);
+
+    if(fabs(det) < 1.0e-12) {
+        return false;
+    }
+
+    double invDet = 1.0 / det;
+    Vector3D s = o - v0;
+
+    double u = s.dot(p) * invDet;
+    if(u < 0.0 || u > 1.0) {
+        return false;
+    }
+
+    Vector3D q = s.cross(e1);
+
+    double v = d.dot(q) * invDet;
+    if(v < 0.0 || u + v > 1.0) {
+        return false;
+    }
+
+    *t = e2.dot(q) * invDet;
+    return ray.checkParam(*t);
+}
+
+inline bool getTriangleParam(const Point3D& v0, const Vector3D& e1, const Vector3D& e2,
+        const Ray& ray, double* t)
+{
+    return getTriangleParam(v0, e1, e2, ray.getOrigin(), ray.getDirection(), ray, t);
+}
+
+// The triangles of a mesh as one vertex buffer and one buffer of index
+// triples. Vertices are floats, or 16 bits per axis across the bounding
+// box once quantized. Clones of a mesh share it.
+class TriangleMesh {
+public:
+    TriangleMesh();
+
+    void addVertex(const Point3D& vertex);
+    void addTriangle(unsigned int a, unsigned int b, unsigned int c);
+
+    // Computes the bounds and, if asked, quantizes the vertices. Nothing
+    // more can be added afterwards.
+    void finalize(bool quantize);
+
+    int getNumVertices() const { return m_numVertices; }
+    int getNumTriangles() const { return m_indices.size() / 3; }
+
+    Point3D getVertex(int index) const;
+    const unsigned int* getTriangle(int index) const { return &m_indices[3 * index]; }
+
+    const Point3D& getMin() const { return m_min; }
+    const Point3D& getMax() const { return m_max; }
+
+    // Reads the vertices and faces of an OBJ file, splitting larger faces
+    // into fans. Returns NULL if the file can't be read.
+    static TriangleMesh* readObj(const std::string& filename, bool quantize);
+
+private:
+    int m_numVertices;
+
+    std::vector<float> m_verts;
+    std::vector<unsigned short> m_quantized;
+
+    Point3D m_min;
+    Point3D m_max;
+    Vector3D m_step;
+
+    std::vector<unsigned int> m_indices;
+};
+
+// Inline, as the pool reads mesh vertices in its inner loop
+inline Point3D TriangleMesh::getVertex(int index) const {
+    if(m_quantized.empty()) {
+        const float* v = &m_verts[3 * index];
+        return Point3D(v[0], v[1], v[2]);
+    }
+
+    const unsigned short* q = &m_quantized[3 * index];
+
+    return Point3D(m_min[0] + q[0] * m_step[0],
+            m_min[1] + q[1] * m_step[1],
+            m_min[2] + q[2] * m_step[2]);
+}
+
 class Mesh : public Primitive {
 public:
+    // Meshes made only of triangles are kept as a TriangleMesh
     Mesh(const std::vector<Point3D>& verts,
-       const std::vector< std::vector<int> >& faces);
+       const std::vector< std::vector<int> >& faces, bool quantize = false);
+
+    // Takes ownership of triangles
+    Mesh(TriangleMesh* triangles);
+
+    virtual ~Mesh();
 
     Mesh(const Mesh& other);
     Mesh& operator=(const Mesh& other);
@@ -21,11 +120,19 @@ public:
     virtual bool getIntersection(const Ray& ray, Intersection* isect);
 
     virtual bool isMesh() { return true; }
+    bool isIndexed() const { return m_triangles != NULL; }
+
+    // Adds what the mesh is traced as: itself when indexed, and a
+    // Triangle, Quad or Polygon per face otherwise
     void addMeshPolygons(std::vector<Primitive*>* primitives);
 
+    virtual void addToPool(PrimitivePool* pool);
+
     typedef std::vector<int> Face;
   
 private:
+    bool getTriangleIntersection(const Ray& modelRay, Intersection* isect);
+
     bool getPolyIntersection(const Face& poly, Intersection* isect);
     bool getPlaneIntersection(const Face& poly, const Ray& ray, Intersection* isect);
     
@@ -35,6 +142,9 @@ private:
     std::vector<Point3D> m_verts;
     std::vector<Face> m_faces;
 
+    TriangleMesh* m_triangles;
+    bool m_ownsTriangles;
+
     friend std::ostream& operator<<(std::ostream& out, const Mesh& mesh);
 };
 
@@ -47,6 +157,7 @@ public:
 
     virtual Polygon* clone() { return new Polygon(*this); }
     virtual bool getIntersection(const Ray& ray, Intersection* isect);
+    virtual void addToPool(PrimitivePool* pool);
 
 protected:
     bool getPlaneIntersection(const Ray& ray, Intersection* isect);
@@ -75,7 +186,7 @@ public:
     Quad& operator=(const Quad& other);
     
     virtual Quad* clone() { return new Quad(*this); }
-    virtual Colour getColour(const Point3D& point);
+    virtual Colour getColour(const Point3D& point, double footprint);
     virtual Vector3D getOffset(const Point3D& point);
 
 private:
@@ -1,15 +1,18 @@
 #include <iostream>
 #include "packet.hpp"
 #include "tracer.hpp"
+#include "material.hpp"
 #include "a4.hpp"
+#include "perfcounters.hpp"
 
 using std::vector;
+using std::list;
 using std::cout;
 using std::endl;
 using std::max;
 
-int Packet::SAMPLE_WIDTH = 1;
-#define PACKET_WIDTH 16
+int CameraPacket::PACKET_WIDTH = 16;
+int CameraPacket::PACKET_HEIGHT = 16;
 
 //***************************** Packet *********************************
 Packet::Packet() 
@@ -45,6 +48,8 @@ void Packet::copy(const Packet& other) {
     m_finite = other.m_finite;
     m_length = other.m_length;
 
+    m_frustum = other.m_frustum;
+
     m_rays = copyRays(other.m_rays);
 }
 
@@ -85,6 +90,8 @@ void Packet::updateIntervals() {
     }
 
     m_dirReciproc = m_direction.reciprocal();
+
+    m_frustum.build(*m_rays);
 }
 
 void Packet::setRays(vector<Ray*>* rays) {
@@ -100,10 +107,11 @@ void Packet::setRays(vector<Ray*>* rays) {
 
 //************************** CameraPacket ******************************
 
-CameraPacket::CameraPacket() {}
+CameraPacket::CameraPacket() : m_sampleWidth(1) {}
 
-CameraPacket::CameraPacket(int width, int height, int i, int j, QImage* img, Tracer* tracer) :
-    m_width(width), m_height(height), m_i(i), m_j(j), m_img(img),
+CameraPacket::CameraPacket(int width, int height, int i, int j, int sampleWidth, FrameBuffer* frame,
+        Tracer* tracer) :
+    m_width(width), m_height(height), m_sampleWidth(sampleWidth), m_i(i), m_j(j), m_frame(frame),
     m_tracer(tracer)
 {
 }
@@ -119,8 +127,10 @@ void CameraPacket::copy(const CameraPacket& other) {
     m_i = other.m_i;
     m_j = other.m_j;
 
-    m_img = other.m_img;
+    m_frame = other.m_frame;
     m_tracer = other.m_tracer;
+
+    m_cache = other.m_cache;
 }
 
 CameraPacket::CameraPacket(const CameraPacket& other) : 
@@ -139,13 +149,13 @@ CameraPacket& CameraPacket::operator=(const CameraPacket& other) {
 }
 
 void CameraPacket::genRays(const Camera& cam) {
-    int packetWidth = SAMPLE_WIDTH * m_width;
-    int packetHeight = SAMPLE_WIDTH * m_height;
+    int packetWidth = m_sampleWidth * m_width;
+    int packetHeight = m_sampleWidth * m_height;
 
-    double pixelFraction = 1.0 / SAMPLE_WIDTH;
+    double pixelFraction = 1.0 / m_sampleWidth;
     
-    double starting_i = m_i - 0.5 * (SAMPLE_WIDTH - 1) * pixelFraction;
-    double j = m_j - 0.5 * (SAMPLE_WIDTH - 1) * pixelFraction;
+    double starting_i = m_i - 0.5 * (m_sampleWidth - 1) * pixelFraction;
+    double j = m_j - 0.5 * (m_sampleWidth - 1) * pixelFraction;
 
     vector<Ray*>* rays = new vector<Ray*>();
     
@@ -162,39 +172,134 @@ void CameraPacket::genRays(const Camera& cam) {
     }
 
     setRays(rays);
+    m_cache.assign(rays->size(), RayCache());
 }
 
-void CameraPacket::trace() {
-    if(PACKETS) {
-        int n = m_rays->size();
+// Returns the number of camera rays that were traced
+int CameraPacket::trace() {
+    int traced;
 
-        ColourVector colours(n);
-        vector<bool> v_hit(n);
+    // Read once, so the whole packet is traced and written one way
+    bool cached = CACHE;
 
-        Packet packet(*this);
-        m_tracer->tracePacket(packet, &colours, v_hit);
+    {
+        PerfPhase phase(PerfCounters::primary);
 
-        for(int j = 0; j < m_height; j++) {
-            for(int i = 0; i < m_width; i++) {
-                tracePixel(i, j, colours, v_hit);
-            }
+        if(PACKETS) {
+            traced = tracePackets(cached);
+        } else {
+            traced = traceRays(cached);
+        }
+
+        if(PROFILE) {
+            PerfCounters::addRays(PerfCounters::primary, traced);
+        }
+    }
+
+    PerfPhase phase(PerfCounters::framebuffer);
+
+    for(int j = 0; j < m_height; j++) {
+        for(int i = 0; i < m_width; i++) {
+            writePixel(i, j, cached);
+        }
+    }
+
+    return traced;
+}
+
+static void fillCache(RayCache& cache, bool hit, const Colour& colour, const Intersection& isect) {
+    cache.valid = true;
+    cache.hit = hit;
+    cache.colour = colour;
+
+    if(hit) {
+        cache.point = isect.getPoint();
+        cache.normal = isect.getNormal();
+        cache.material = isect.getPrimitive()->getMaterial();
+    }
+}
+
+int CameraPacket::traceRays(bool cached) {
+    int n = m_rays->size();
+    int traced = 0;
+
+    for(int i = 0; i < n; ++i) {
+        RayCache& cache = m_cache.at(i);
+
+        if(cached && !cache.dirty) {
+            continue;
         }
 
-    } else {
-        for(int j = 0; j < m_height; j++) {
-            for(int i = 0; i < m_width; i++) {
-                tracePixel(i, j);
+        Colour colour(0.0, 0.0, 0.0);
+        Intersection isect;
+
+        cache.mirrors.clear();
+
+        bool hit = m_tracer->traceRay(*m_rays->at(i), colour, 0, &isect, cached ? &cache.mirrors : NULL);
+        fillCache(cache, hit, colour, isect);
+
+        ++traced;
+    }
+
+    return traced;
+}
+
+int CameraPacket::tracePackets(bool cached) {
+    int n = m_rays->size();
+    int traced = n;
+
+    ColourVector colours(n);
+    vector<bool> v_hit(n);
+    vector<Intersection> primary(n);
+
+    Packet packet(*this);
+
+    if(cached) {
+        vector<Ray*>* rays = packet.getRays();
+        int numDirty = 0;
+
+        // Clean rays are dropped from the packet; the packet's bounds
+        // still cover the remaining ones.
+        for(int i = 0; i < n; ++i) {
+            if(m_cache.at(i).dirty) {
+                ++numDirty;
+            } else {
+                delete rays->at(i);
+                rays->at(i) = NULL;
             }
         }
+
+        if(numDirty == 0) {
+            return 0;
+        }
+
+        traced = numDirty;
     }
+
+    vector<MirrorPath> paths(cached ? n : 0);
+
+    m_tracer->tracePacket(packet, &colours, v_hit, 0, &primary, cached ? &paths : NULL);
+
+    for(int i = 0; i < n; ++i) {
+        if(!cached || m_cache.at(i).dirty) {
+            fillCache(m_cache.at(i), v_hit.at(i), colours.at(i), primary.at(i));
+        }
+
+        if(cached && m_cache.at(i).dirty) {
+            m_cache.at(i).mirrors = paths.at(i);
+        }
+    }
+
+    return traced;
 }
 
 void CameraPacket::updateIntervals() {
-    int packetWidth = SAMPLE_WIDTH * m_width;
-    int packetHeight = SAMPLE_WIDTH * m_height;
+    int packetWidth = m_sampleWidth * m_width;
+    int packetHeight = m_sampleWidth * m_height;
 
     if(packetWidth * packetHeight <= 1) {
         Packet::updateIntervals();
+        return;
     }
 
     m_origin = IVector3D(m_rays->at(0)->getOrigin());
@@ -203,126 +308,199 @@ void CameraPacket::updateIntervals() {
     m_finite = false;
     m_length = std::numeric_limits<double>::infinity();
 
-    int indices[4] = {0, packetWidth-1, packetWidth*packetHeight - 1, packetHeight * (packetWidth - 1) + 1};
+    // The corner samples bound every camera ray in between. A packet one
+    // ray tall or wide repeats corners, which is harmless.
+    vector<Ray*> corners;
+    corners.push_back(m_rays->at(0));
+    corners.push_back(m_rays->at(packetWidth - 1));
+    corners.push_back(m_rays->at(packetWidth * (packetHeight - 1)));
+    corners.push_back(m_rays->at(packetWidth * packetHeight - 1));
 
-    for(int i = 0; i < 4; ++i) {
-        Ray* ray = m_rays->at(indices[i]);
-        Point3D o = ray->getOrigin();
-        Vector3D d = ray->getDirection();
+    for(auto it = corners.begin(); it != corners.end(); ++it) {
+        Point3D o = (*it)->getOrigin();
+        Vector3D d = (*it)->getDirection();
 
         m_origin.extend(o);
         m_direction.extend(d);
     }
 
     m_dirReciproc = m_direction.reciprocal();
+
+    m_frustum.build(corners);
 }
 
-void CameraPacket::tracePixel(int i, int j) {
-    int width = m_img->width();
-    int height = m_img->height();
+void CameraPacket::writePixel(int i, int j, bool cached) {
+    int width = m_frame->width();
+    int height = m_frame->height();
 
-    int packetWidth = m_width * SAMPLE_WIDTH;
+    int packetWidth = m_width * m_sampleWidth;
 
     int img_i = m_i + i;
     int img_j = m_j + j;
 
-    Colour averageColour(0.0, 0.0, 0.0);
+    bool changed = !cached;
+
+    for(int y = 0; y < m_sampleWidth && !changed; y++) {
+        for(int x = 0; x < m_sampleWidth; x++) {
+            int index = packetWidth * ((m_sampleWidth * j) + y) + m_sampleWidth * i + x;
+
+            if(m_cache.at(index).dirty) {
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    if(!changed) {
+        return;
+    }
+
+    PixelSum sum;
    
 #ifdef BLACK_BACKGROUND 
-    Colour backgroundColour = averageColour;
+    PixelColour backgroundColour;
 #else
-    Colour backgroundColour( ((double)img_i)/(double)width, ((double)img_j)/(double)height, 
-       (1.0 - ((double)img_i)/(double)width) );
+    PixelColour backgroundColour(Colour( ((double)img_i)/(double)width, ((double)img_j)/(double)height, 
+       (1.0 - ((double)img_i)/(double)width) ));
 #endif
 
-    for(int y = 0; y < SAMPLE_WIDTH; y++) {
-        for(int x = 0; x < SAMPLE_WIDTH; x++) {
-            int index = packetWidth * ((SAMPLE_WIDTH * j) + y) + SAMPLE_WIDTH * i + x;
-            
-            Colour colour(0.0, 0.0, 0.0);
-            bool hit = m_tracer->traceRay(*m_rays->at(index), colour);
+    for(int y = 0; y < m_sampleWidth; y++) {
+        for(int x = 0; x < m_sampleWidth; x++) {
+            int index = packetWidth * ((m_sampleWidth * j) + y) + m_sampleWidth * i + x;
+            RayCache& cache = m_cache.at(index);
 
-            if(hit) {
-                averageColour += colour;
+            if(cache.hit) {
+                sum.add(cache.colour);
             } else {
-                averageColour += backgroundColour;
+                sum.add(backgroundColour);
             }
+
+            cache.dirty = false;
         }
     }
 
-    double factor = 1.0 / (SAMPLE_WIDTH * SAMPLE_WIDTH);
-    averageColour = factor * averageColour;
-
-    m_img->setPixel(img_i, img_j, averageColour.toInt());
+    sum.store(m_frame->getPixel(img_i, img_j), 1.0f / (m_sampleWidth * m_sampleWidth));
 }
 
-void CameraPacket::tracePixel(int i, int j, ColourVector& colours, vector<bool>& v_hit) {
-    int width = m_img->width();
-    int height = m_img->height();
+/*  isDirty
+ *
+ *  A ray needs retracing if its primary segment, a segment between two
+ *  of its mirror bounces or the shadow segment from any hit passes
+ *  through a moved bounding box. Every bounce the tracer followed was
+ *  recorded, so this holds through any number of mirrors. Paths that
+ *  met a refractive surface are always retraced since they bend through
+ *  the object.
+ */
+bool CameraPacket::isDirty(int index, const vector<AABB>& moved, const list<Light*>* lights) {
+    RayCache& cache = m_cache.at(index);
+
+    if(!cache.valid) {
+        return true;
+    }
 
-    int packetWidth = m_width * SAMPLE_WIDTH;
+    if(cache.hit && cache.material->getTransmitRatio() > 1.0e-10) {
+        return true;
+    }
 
-    int img_i = m_i + i;
-    int img_j = m_j + j;
+    const MirrorPath& mirrors = cache.mirrors;
 
-    Colour averageColour;
-   
-#ifdef BLACK_BACKGROUND 
-    Colour backgroundColour;
-#else
-    Colour backgroundColour( ((double)img_i)/(double)width, ((double)img_j)/(double)height, 
-       (1.0 - ((double)img_i)/(double)width) );
-#endif
+    if(mirrors.refracted) {
+        return true;
+    }
 
-    for(int y = 0; y < SAMPLE_WIDTH; y++) {
-        for(int x = 0; x < SAMPLE_WIDTH; x++) {
-            int index = packetWidth * ((SAMPLE_WIDTH * j) + y) + SAMPLE_WIDTH * i + x;
-            bool hit = v_hit.at(index);
+    Ray* ray = m_rays->at(index);
+    Ray primary = cache.hit ? Ray(ray->getOrigin(), cache.point) : *ray;
 
-            if(hit) {
-                averageColour += colours.at(index);
-            } else {
-                averageColour += backgroundColour;
+    vector<Ray> secondary;
+
+    if(cache.hit) {
+        Point3D from = cache.point;
+
+        for(size_t p = 0; p <= mirrors.points.size(); ++p) {
+            for(auto it = lights->begin(); it != lights->end(); ++it) {
+                secondary.push_back(Ray(from, (*it)->position));
             }
+
+            if(p < mirrors.points.size()) {
+                secondary.push_back(Ray(from, mirrors.points[p]));
+                from = mirrors.points[p];
+            }
+        }
+
+        if(mirrors.escaped) {
+            secondary.push_back(Ray(from, mirrors.escapeDir));
         }
     }
 
-    double factor = 1.0 / (SAMPLE_WIDTH * SAMPLE_WIDTH);
-    averageColour = factor * averageColour;
+    for(auto it = moved.begin(); it != moved.end(); ++it) {
+        if(it->intersect(primary) || it->contains(primary)) {
+            return true;
+        }
+
+        for(auto ray_it = secondary.begin(); ray_it != secondary.end(); ++ray_it) {
+            if(it->intersect(*ray_it) || it->contains(*ray_it)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Rays traced while the cache was off kept no mirror paths, so nothing
+// they cached can be trusted once it is back on
+void CameraPacket::resetCache() {
+    m_cache.assign(m_cache.size(), RayCache());
+}
+
+void CameraPacket::invalidate(const vector<AABB>& moved, const list<Light*>* lights) {
+    int n = m_cache.size();
+
+    for(int i = 0; i < n; ++i) {
+        RayCache& cache = m_cache.at(i);
 
-    m_img->setPixel(img_i, img_j, averageColour.toInt());
+        if(!cache.dirty) {
+            cache.dirty = isDirty(i, moved, lights);
+        }
+    }
 }
 
 // Static functions to help manage vectors of packets
-vector<CameraPacket*>* CameraPacket::genPackets(QImage* img, Tracer* tracer, const Camera& cam, int sampleWidth) {
-    CameraPacket::SAMPLE_WIDTH = sampleWidth;
+vector<CameraPacket*>* CameraPacket::genPackets(FrameBuffer* frame, Tracer* tracer, const Camera& cam, int sampleWidth) {
+    return genPackets(frame, tracer, cam, sampleWidth, 0, frame->top(), frame->width(), frame->rows());
+}
 
-    int width = img->width();
-    int height = img->height();
+vector<CameraPacket*>* CameraPacket::genPackets(FrameBuffer* frame, Tracer* tracer, const Camera& cam, int sampleWidth,
+        int left, int top, int width, int height) {
+    int right = left + width;
+    int bottom = top + height;
 
-    int std_pixelWidth = PACKET_WIDTH / SAMPLE_WIDTH;
+    // A tile is at least one pixel, even when a pixel has more samples
+    // across than the packet
+    int std_pixelWidth = max(1, PACKET_WIDTH / sampleWidth);
+    int std_pixelHeight = max(1, PACKET_HEIGHT / sampleWidth);
 
     vector<CameraPacket*>* packets = new vector<CameraPacket*>();
 
-    for(int j = 0; j < height; j += std_pixelWidth) {
+    for(int j = top; j < bottom; j += std_pixelHeight) {
         int pixelHeight;
         
-        if(height - j < std_pixelWidth) {
-            pixelHeight = height - j;
+        if(bottom - j < std_pixelHeight) {
+            pixelHeight = bottom - j;
         } else {
-            pixelHeight = std_pixelWidth;
+            pixelHeight = std_pixelHeight;
         }
         
-        for(int i = 0; i < width; i += std_pixelWidth) {
+        for(int i = left; i < right; i += std_pixelWidth) {
             int pixelWidth;
 
-            if(width - i < std_pixelWidth) {
-                pixelWidth = width - i;
+            if(right - i < std_pixelWidth) {
+                pixelWidth = right - i;
             } else {
                 pixelWidth = std_pixelWidth;
             }
 
-            CameraPacket* newPacket = new CameraPacket(pixelWidth, pixelHeight, i, j, img, tracer);
+            CameraPacket* newPacket = new CameraPacket(pixelWidth, pixelHeight, i, j, sampleWidth, frame, tracer);
             newPacket->genRays(cam);
 
             packets->push_back(newPacket);
@@ -332,6 +510,17 @@ vector<CameraPacket*>* CameraPacket::genPackets(QImage* img, Tracer* tracer, con
     return packets;
 }
 
+bool CameraPacket::setPacketSize(int width, int height) {
+    if(width < 1 || height < 1 || width > MAX_PACKET_WIDTH || height > MAX_PACKET_WIDTH) {
+        return false;
+    }
+
+    PACKET_WIDTH = width;
+    PACKET_HEIGHT = height;
+
+    return true;
+}
+
 void CameraPacket::deletePackets(vector<CameraPacket*>* packets) {
     for(auto it = packets->begin(); it != packets->end(); it++) {
         delete (*it);
@@ -339,3 +528,31 @@ void CameraPacket::deletePackets(vector<CameraPacket*>* packets) {
 
     delete packets;
 }
+
+int CameraPacket::countRays(vector<CameraPacket*>* packets) {
+    int count = 0;
+
+    for(auto it = packets->begin(); it != packets->end(); it++) {
+        count += (*it)->m_rays->size();
+    }
+
+    return count;
+}
+
+void CameraPacket::invalidatePackets(vector<CameraPacket*>* packets, const vector<AABB>& moved,
+        const list<Light*>* lights) 
+{
+    if(moved.empty()) {
+        return;
+    }
+
+    for(auto it = packets->begin(); it != packets->end(); it++) {
+        (*it)->invalidate(moved, lights);
+    }
+}
+
+void CameraPacket::resetPackets(vector<CameraPacket*>* packets) {
+    for(auto it = packets->begin(); it != packets->end(); it++) {
+        (*it)->resetCache();
+    }
+}
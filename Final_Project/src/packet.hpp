@@ -2,13 +2,57 @@
 #define  CS488_PACKET_HPP
 
 #include<vector>
-#include<QImage>
+#include<list>
 
 #include "ray.hpp"
 #include "interval.hpp"
 #include "camera.hpp"
+#include "framebuffer.hpp"
+#include "frustum.hpp"
+
+// The most rays across a camera packet. With up to 4x4 samples a pixel,
+// the largest packet still fits in a LaneMask.
+#define MAX_PACKET_WIDTH 16
 
 class Tracer;
+class AABB;
+class PhongMaterial;
+struct Light;
+
+// Where the mirror bounces of a camera ray went, past its primary hit.
+// Every bounce up to the tracer's depth limit is kept, so a change seen
+// through any number of mirrors dirties the ray.
+struct MirrorPath {
+    MirrorPath() : escaped(false), refracted(false) {}
+
+    void clear() { points.clear(); escaped = false; refracted = false; }
+
+    // Where each reflected ray hit, in order
+    std::vector<Point3D> points;
+
+    // The last reflected ray hit nothing and left along escapeDir
+    bool escaped;
+    Vector3D escapeDir;
+
+    // Some bounce hit a transmissive surface, whose paths aren't kept
+    bool refracted;
+};
+
+// What a camera ray saw the last time it was traced. Rays whose paths
+// can't have been touched by moving primitives keep their colour.
+struct RayCache {
+    RayCache() : valid(false), dirty(true), hit(false), material(NULL) {}
+
+    bool valid;
+    bool dirty;
+    bool hit;
+
+    PixelColour colour;
+    Point3D point;
+    Vector3D normal;
+    PhongMaterial* material;
+    MirrorPath mirrors;
+};
 
 class Packet {
 public:
@@ -25,6 +69,8 @@ public:
     bool isFinite() const { return m_finite; }
     double getLength() const { return m_length; }
 
+    const Frustum& getFrustum() const { return m_frustum; }
+
     void setRays(std::vector<Ray*>* rays);
     std::vector<Ray*>* getRays() { return m_rays; }
 
@@ -41,7 +87,8 @@ protected:
     bool m_finite;
     double m_length;
 
-    static int SAMPLE_WIDTH;
+    // Only valid when the rays share an origin
+    Frustum m_frustum;
 
 private:
     void copy(const Packet& other);
@@ -50,7 +97,7 @@ private:
 class CameraPacket : public Packet{
 public:
     CameraPacket();
-    CameraPacket(int width, int height, int i, int j, QImage* img, Tracer* tracer);
+    CameraPacket(int width, int height, int i, int j, int sampleWidth, FrameBuffer* frame, Tracer* tracer);
 
     virtual ~CameraPacket();
 
@@ -58,11 +105,34 @@ public:
     CameraPacket& operator=(const CameraPacket& other);
 
     void genRays(const Camera& cam);
-    void trace();
+    int trace();
+
+    // The tile of the frame this packet covers, in pixels
+    int getI() const { return m_i; }
+    int getJ() const { return m_j; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+    void invalidate(const std::vector<AABB>& moved, const std::list<Light*>* lights);
+
+    // Forgets every cached ray, so the next trace redoes the whole packet
+    void resetCache();
     
     // Static functions to help manage vectors of packets
-    static std::vector<CameraPacket*>* genPackets(QImage* img, Tracer* tracer, const Camera& cam, int sampleWidth);
+    static std::vector<CameraPacket*>* genPackets(FrameBuffer* frame, Tracer* tracer, const Camera& cam, int sampleWidth);
+    // Just the packets of a rectangle with its top left pixel at left,
+    // top, which should be on a packet boundary and lie within the rows
+    // frame holds
+    static std::vector<CameraPacket*>* genPackets(FrameBuffer* frame, Tracer* tracer, const Camera& cam, int sampleWidth,
+            int left, int top, int width, int height);
+    static bool setPacketSize(int width, int height);
+    static int getPacketWidth() { return PACKET_WIDTH; }
+    static int getPacketHeight() { return PACKET_HEIGHT; }
     static void deletePackets(std::vector<CameraPacket*>* packets);
+    static int countRays(std::vector<CameraPacket*>* packets);
+    static void invalidatePackets(std::vector<CameraPacket*>* packets, const std::vector<AABB>& moved, 
+            const std::list<Light*>* lights);
+    static void resetPackets(std::vector<CameraPacket*>* packets);
 
 protected:
     virtual void updateIntervals();
@@ -70,19 +140,33 @@ protected:
 private: 
     void copy(const CameraPacket& other);
 
-    void tracePixel(int i, int j);
-    void tracePixel(int i, int j, ColourVector& colours, std::vector<bool>& v_hit);
+    // cached is CACHE as read once at the start of trace
+    int traceRays(bool cached);
+    int tracePackets(bool cached);
+    void writePixel(int i, int j, bool cached);
+
+    bool isDirty(int index, const std::vector<AABB>& moved, const std::list<Light*>* lights);
 
     int m_width;
     int m_height;
 
+    // Samples per pixel along each axis. Every packet keeps its own, so
+    // packets of frames with different sample widths can be traced at
+    // the same time.
     int m_sampleWidth;
 
     int m_i;
     int m_j;
 
-    QImage* m_img;
+    FrameBuffer* m_frame;
     Tracer* m_tracer;
+
+    std::vector<RayCache> m_cache;
+
+    // Rays across and down the packets made by genPackets. Tiles cover
+    // as many whole pixels as fit, and at least one.
+    static int PACKET_WIDTH;
+    static int PACKET_HEIGHT;
 };
 
 #endif
@@ -4,43 +4,30 @@
 #include <QtGui>
 #include <cmath>
 #include <iostream>
-#include <QElapsedTimer>
-#include <set>
 
 #include "paintcanvas.hpp"
 
 using std::list;
 using std::vector;
-using std::set;
 using std::string;
 
-using std::cerr;
-using std::cout;
-using std::endl;
-
 #define FRAMERATE 30
 
 PaintCanvas::PaintCanvas(QWidget *parent, Camera* cam, const list<Light*>* lights, Colour ambient, 
         SceneNode* root, string& filename) :
-    QWidget(parent), m_game(NULL), m_printStatus(false),
-    m_initCam(cam), m_lights(lights), 
-    m_ambient(ambient), m_filename(QString(filename.c_str())), 
-    m_root(root), m_refreshScreen(false), m_paused(false), 
-    m_piecesMoved(false),
-    m_tickCount(0), m_sampleWidth(1)
+    QWidget(parent), m_game(NULL), m_initCam(cam), 
+    m_filename(QString(filename.c_str())), m_root(root), 
+    m_paused(false), m_piecesMoved(false), m_sampleWidth(1)
 {
-    m_cam = new Camera(*cam);
-    m_cam->updateDimensions(width(), height());
-
     m_root->initGame(m_game);
     
-    m_primitives = new vector<Primitive*>();
-    m_root->getPrimitives(m_primitives, m_game);
+    vector<Primitive*>* primitives = new vector<Primitive*>();
+    m_root->getPrimitives(primitives, m_game);
 
-    m_tracer = new Tracer(m_primitives, ambient, lights);
+    m_service = new RenderService(*cam, primitives, ambient, lights, 1000/FRAMERATE);
+    m_service->setInteractive(m_game != NULL);
 
-    m_img = new QImage(width(), height(), QImage::Format_RGB32);
-    m_packets = CameraPacket::genPackets(m_img, m_tracer, *m_cam, m_sampleWidth);
+    connect(m_service, SIGNAL(frameReady()), this, SLOT(swapFrame()), Qt::QueuedConnection);
 
     m_resizeTimer = new QTimer(this);
     m_resizeTimer->setSingleShot(true);
@@ -59,6 +46,7 @@ PaintCanvas::PaintCanvas(QWidget *parent, Camera* cam, const list<Light*>* light
 }
 
 PaintCanvas::~PaintCanvas() {
+    delete m_service;
 }
 
 QSize PaintCanvas::minimumSizeHint() const {
@@ -70,31 +58,7 @@ QSize PaintCanvas::sizeHint() const {
 }
 
 void PaintCanvas::saveImage() {
-    pause();
-
-    Camera* t_cam = new Camera(*m_cam);
-    t_cam->updateDimensions(m_initCam->getWidth(), m_initCam->getHeight());
-
-    QImage img(m_initCam->getWidth(), m_initCam->getHeight(), QImage::Format_RGB32);
-    
-    vector<CameraPacket*>* t_packets = m_packets;
-    m_packets = CameraPacket::genPackets(&img, m_tracer, *t_cam, m_sampleWidth);
-
-    QElapsedTimer timer;
-    timer.start();
-
-    computeQImage();
-    img.save(m_filename);
-
-    cout << "Time to save image: " << timer.elapsed() << endl;
-    timer.invalidate();
-
-    delete t_cam;
-
-    CameraPacket::deletePackets(m_packets);
-    m_packets = t_packets;
-
-    pause();
+    m_service->save(m_filename, m_initCam->getWidth(), m_initCam->getHeight());
 }
 
 void PaintCanvas::setSampleWidth(int width) {
@@ -102,76 +66,68 @@ void PaintCanvas::setSampleWidth(int width) {
     resizeAction();
 }
 
-void PaintCanvas::resizeAction() {
-    m_cam->updateDimensions(width(), height());
-
-    delete m_img;
-    m_img = new QImage(width(), height(), QImage::Format_RGB32);
-
-    QElapsedTimer timer;
-    timer.start();
+void PaintCanvas::setBudget(bool enabled) {
+    m_service->setBudget(enabled);
+}
 
-    CameraPacket::deletePackets(m_packets);
-    m_packets = CameraPacket::genPackets(m_img, m_tracer, *m_cam, m_sampleWidth);
-    
-    cout << "Time to resize image: " << timer.elapsed() << endl;
-    timer.invalidate();
+bool PaintCanvas::isBudgetEnabled() {
+    return m_service->isBudgetEnabled();
+}
 
-    m_refreshScreen = true;
-    update();
+void PaintCanvas::setCache(bool enabled) {
+    m_service->setCache(enabled);
 }
 
+bool PaintCanvas::isCacheEnabled() {
+    return m_service->isCacheEnabled();
+}
 
-void PaintCanvas::paintEvent(QPaintEvent* event) {
-    (void) event;
+void PaintCanvas::setAcceleration(bool bih, bool packets) {
+    m_service->setAcceleration(bih, packets);
+}
 
-    QElapsedTimer timer;
+void PaintCanvas::setProfile(bool enabled) {
+    m_service->setProfile(enabled);
+}
 
-    if(m_refreshScreen) {
-        timer.start();
-    }
-      
-    if(m_piecesMoved || INTERP) {
-        bool temp = m_refreshScreen;
-        m_refreshScreen = false;
-        
-        while(m_tickCount > 0) {
-            m_game->tick();
-            --m_tickCount;
-        }
+bool PaintCanvas::isProfileEnabled() {
+    return m_service->isProfileEnabled();
+}
 
-        m_piecesMoved = false;
+void PaintCanvas::setHeatmap(bool enabled) {
+    m_service->setHeatmap(enabled);
+}
 
-        for(auto it = m_primitives->begin(); it != m_primitives->end(); ++it) {
-            delete *it;
-        }
+bool PaintCanvas::isHeatmapEnabled() {
+    return m_service->isHeatmapEnabled();
+}
 
-        m_primitives->clear();
-        
-        if(INTERP) {
-            double fallAmount = 1.0 - m_gameTimer->remainingTime() / (double)m_gameTimer->interval();
-            m_root->getPrimitives(m_primitives, m_game, fallAmount);
+void PaintCanvas::tunePackets() {
+    m_service->autoTune();
+}
 
-        } else {
-            m_root->getPrimitives(m_primitives, m_game);
-        }
+void PaintCanvas::togglePrintStatus() {
+    m_service->setPrintStatus(!m_service->getPrintStatus());
+}
 
-        m_tracer->updatePrimitives(m_primitives);
+void PaintCanvas::resizeAction() {
+    m_service->resize(width(), height(), m_sampleWidth);
+}
 
-        m_refreshScreen = temp;
+void PaintCanvas::swapFrame() {
+    if(m_service->takeFrame(m_front)) {
+        update();
     }
+}
 
-    if(m_refreshScreen) {
-        m_refreshScreen = false;
+void PaintCanvas::paintEvent(QPaintEvent* event) {
+    (void) event;
 
-        computeQImage();
+    QPainter painter(this);
 
-        cout << "Time to compute image: " << timer.elapsed() << endl;
-        timer.invalidate();
+    if(!m_front.isNull()) {
+        painter.drawImage(QRect(0, 0, width(), height()), m_front);
     }
-
-    QPainter painter(this);
-    painter.drawImage(QRect(0, 0, width(), height()), *m_img);
 }
 
 void PaintCanvas::resizeEvent(QResizeEvent* event) {
@@ -180,71 +136,6 @@ void PaintCanvas::resizeEvent(QResizeEvent* event) {
     m_resizeTimer->start();
 }
 
-void PaintCanvas::computeQImage() {
-    m_index = 0;
-    m_k = 1;
-
-    pthread_mutex_init(&m_mutex, NULL);
-
-    pthread_attr_t attr;
-    pthread_attr_init(&attr);
-    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-    if(m_printStatus) {
-        cout << "0\% complete" << endl;
-    }
-
-    for(int a = 0; a < NUMTHREADS; a++) {
-        pthread_create(&m_threads[a], &attr, thread_bootstrap, this);
-    }
-
-    pthread_attr_destroy(&attr);
-    for(int a = 0; a < NUMTHREADS; a++) {
-        int rc = pthread_join(m_threads[a], NULL);
-        if(rc) {
-            cerr << "ERROR. Return code from pthread_join() is "
-                << rc << endl;
-            exit(-1);
-        }
-    }
-
-    if(m_printStatus) {
-        cout << "100\% complete" << endl;
-    }
-
-    pthread_mutex_destroy(&m_mutex);
-}
-
-void* PaintCanvas::thread_bootstrap(void* canvas) {
-    ((PaintCanvas*)canvas)->computePixels();
-    return NULL;
-}
-
-void PaintCanvas::computePixels() {
-    int numPackets = m_packets->size();
-    int index;
-
-    while(true) {
-        pthread_mutex_lock(&m_mutex);
-        
-        if(m_index >= numPackets) {
-            pthread_mutex_unlock(&m_mutex);
-            pthread_exit((void*) 0);
-        }
-
-        index = m_index++; 
-
-        pthread_mutex_unlock(&m_mutex);
-
-        m_packets->at(index)->trace();
-
-        if(m_printStatus && index == (int) ((m_k/10.0) * numPackets)) {
-            cout << m_k*10 << "\% complete" << endl;
-            m_k++;
-        }
-    }       
-}
-
 void PaintCanvas::setTickSpeed(Speed speed)
 {
     if(m_game != NULL) {
@@ -287,7 +178,7 @@ void PaintCanvas::moveLeft() {
 }
 
 void PaintCanvas::moveRight() {
-if(!(m_game == NULL || m_paused)) {
+    if(!(m_game == NULL || m_paused)) {
         m_game->moveRight();
         m_piecesMoved = true;
         refresh();
@@ -295,7 +186,7 @@ if(!(m_game == NULL || m_paused)) {
 }
 
 void PaintCanvas::rotateCW() {
-if(!(m_game == NULL || m_paused)) {
+    if(!(m_game == NULL || m_paused)) {
         m_game->rotateCW();
         m_piecesMoved = true;
         refresh();
@@ -323,8 +214,7 @@ void PaintCanvas::newGame() {
     if(m_game != NULL) {
         m_game->reset();
         m_piecesMoved = true;
-
-        update();
+        refresh();
     }
 }
 
@@ -337,22 +227,30 @@ void PaintCanvas::pause() {
         }
 
         m_paused = !m_paused;
+        m_service->setInteractive(!m_paused);
     }
 }
 
+// Hands the current game state to the render service
 void PaintCanvas::refresh() {
     if(m_piecesMoved || INTERP) {
-        m_refreshScreen = true;
+        vector<Primitive*>* primitives = new vector<Primitive*>();
+
+        if(INTERP && m_game != NULL) {
+            double fallAmount = 1.0 - m_gameTimer->remainingTime() / (double)m_gameTimer->interval();
+            m_root->getPrimitives(primitives, m_game, fallAmount);
+        } else {
+            m_root->getPrimitives(primitives, m_game);
+        }
+
+        m_service->updateScene(primitives);
+        m_piecesMoved = false;
     }
-    
-    update();
 }
 
 void PaintCanvas::tick() {
     if(!m_game->isGameOver()) {
-        ++m_tickCount;
+        m_game->tick();
         m_piecesMoved = true;
     }
 }
-
-
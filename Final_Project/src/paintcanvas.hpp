@@ -5,18 +5,19 @@
 #define PAINTCANVAS_HPP
 
 #include <list>
+#include <string>
 #include <vector>
 #include <QWidget>
 #include <QPainter>
+#include <QImage>
 #include <QString>
 
 #include "algebra.hpp"
 #include "light.hpp"
 #include "camera.hpp"
-#include "tracer.hpp"
-#include "packet.hpp"
 #include "game.hpp"
 #include "scene.hpp"
+#include "renderservice.hpp"
 
 class PaintCanvas : public QWidget {
 
@@ -50,8 +51,24 @@ public:
     void rotateCCW();
     void drop();
 
+    void setBudget(bool enabled);
+    bool isBudgetEnabled();
+
+    void setCache(bool enabled);
+    bool isCacheEnabled();
+
+    void setAcceleration(bool bih, bool packets);
+
+    void setProfile(bool enabled);
+    bool isProfileEnabled();
+    void setHeatmap(bool enabled);
+    bool isHeatmapEnabled();
+
+    void tunePackets();
+
+    void togglePrintStatus();
+
     Game* m_game;
-    bool m_printStatus;
 
 public slots:
     void resizeAction();
@@ -62,46 +79,28 @@ protected:
     virtual void resizeEvent(QResizeEvent* event);
 
     Camera* m_initCam;
-    Camera* m_cam;
-    
-    Tracer* m_tracer;
-    QImage* m_img;
-
-    const std::list<Light*>* m_lights;
-    Colour m_ambient;
 
-    std::vector<Primitive*>* m_primitives;
     QString m_filename;
 
     SceneNode* m_root;
 
 private:
-    void computeQImage();
-
-    static void* thread_bootstrap(void* canvas);
-    void computePixels();
-
-    int m_index;
-    int m_k;
-
-    std::vector<CameraPacket*>* m_packets;
-
-    static const int NUMTHREADS = 8;
-    pthread_t m_threads[NUMTHREADS];
-    pthread_mutex_t m_mutex;
+    // Frames are traced by m_service, which owns the tracer. m_front is
+    // the last finished frame and is only touched by the GUI thread.
+    RenderService* m_service;
+    QImage m_front;
 
     QTimer* m_resizeTimer;
     QTimer* m_gameTimer;
     QTimer* m_updateTimer;
 
-    bool m_refreshScreen;
     bool m_paused;
     bool m_piecesMoved;
 
-    int m_tickCount;
     int m_sampleWidth;
 
 private slots:
     void tick();
+    void swapFrame();
 };
 #endif
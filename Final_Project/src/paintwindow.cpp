@@ -186,29 +186,58 @@ void PaintWindow::createAccelActions()
     QAction* noneAct = new QAction(tr("&None"), m_group_accel);
     QAction* bihAct = new QAction(tr("&BIH"), m_group_accel);
     QAction* allAct = new QAction(tr("&BIH and Packets"), m_group_accel);
+    QAction* cacheAct = new QAction(tr("Frame &Cache"), this);
+    QAction* budgetAct = new QAction(tr("Frame B&udget"), this);
+    QAction* tuneAct = new QAction(tr("&Tune Packet Size"), this);
+    QAction* profileAct = new QAction(tr("&Profile"), this);
+    QAction* heatmapAct = new QAction(tr("Cost &Heatmap"), this);
     
     m_accel_actions.push_back(noneAct);
     m_accel_actions.push_back(bihAct);
     m_accel_actions.push_back(allAct);
+    m_accel_actions.push_back(cacheAct);
+    m_accel_actions.push_back(budgetAct);
+    m_accel_actions.push_back(tuneAct);
+    m_accel_actions.push_back(profileAct);
+    m_accel_actions.push_back(heatmapAct);
 
     noneAct->setShortcut(Qt::Key_8);
     bihAct->setShortcut(Qt::Key_9);
     allAct->setShortcut(Qt::Key_0);
+    cacheAct->setShortcut(Qt::Key_C);
+    budgetAct->setShortcut(Qt::Key_B);
+    tuneAct->setShortcut(Qt::Key_T);
+    profileAct->setShortcut(Qt::Key_R);
+    heatmapAct->setShortcut(Qt::Key_H);
 
     noneAct->setStatusTip(tr("No acceleration"));
     bihAct->setStatusTip(tr("Use BIH"));
     allAct->setStatusTip(tr("Use BIH and ray packets"));
+    cacheAct->setStatusTip(tr("Only retrace pixels affected by moving pieces"));
+    budgetAct->setStatusTip(tr("Lower the quality while playing to hold the frame rate"));
+    tuneAct->setStatusTip(tr("Time a few packet sizes on this view and use the fastest"));
+    profileAct->setStatusTip(tr("Print hardware counters for each render phase after every frame"));
+    heatmapAct->setStatusTip(tr("Print worker load after every frame and save a tile cost heatmap with images"));
 
     connect(noneAct, SIGNAL(triggered()), this, SLOT(setNoAccel()));
     connect(bihAct, SIGNAL(triggered()), this, SLOT(setBihAccel()));
     connect(allAct, SIGNAL(triggered()), this, SLOT(setAllAccel()));
+    connect(cacheAct, SIGNAL(triggered()), this, SLOT(toggleCache()));
+    connect(budgetAct, SIGNAL(triggered()), this, SLOT(toggleBudget()));
+    connect(tuneAct, SIGNAL(triggered()), this, SLOT(tunePackets()));
+    connect(profileAct, SIGNAL(triggered()), this, SLOT(toggleProfile()));
+    connect(heatmapAct, SIGNAL(triggered()), this, SLOT(toggleHeatmap()));
     
     for (auto& action : m_accel_actions) {
         addAction(action);
-        action->setCheckable(true);
+        action->setCheckable(action != tuneAct);
     }
 
     allAct->setChecked(true);
+    cacheAct->setChecked(m_canvas->isCacheEnabled());
+    budgetAct->setChecked(m_canvas->isBudgetEnabled());
+    profileAct->setChecked(m_canvas->isProfileEnabled());
+    heatmapAct->setChecked(m_canvas->isHeatmapEnabled());
 }
 
 void PaintWindow::createMenu() {
@@ -243,7 +272,7 @@ void PaintWindow::pause() {
 }
 
 void PaintWindow::printStatus() {
-    m_canvas->m_printStatus = !m_canvas->m_printStatus;
+    m_canvas->togglePrintStatus();
 }
 
 void PaintWindow::save() {
@@ -279,18 +308,35 @@ void PaintWindow::setFourSamples() {
 }
 
 void PaintWindow::setNoAccel() {
-    BIH = false;
-    PACKETS = false;
+    m_canvas->setAcceleration(false, false);
 }
 
 void PaintWindow::setBihAccel() {
-    BIH = true;
-    PACKETS = false;
+    m_canvas->setAcceleration(true, false);
 }
 
 void PaintWindow::setAllAccel() {
-    BIH = true;
-    PACKETS = true;
+    m_canvas->setAcceleration(true, true);
+}
+
+void PaintWindow::toggleCache() {
+    m_canvas->setCache(!m_canvas->isCacheEnabled());
+}
+
+void PaintWindow::toggleBudget() {
+    m_canvas->setBudget(!m_canvas->isBudgetEnabled());
+}
+
+void PaintWindow::toggleProfile() {
+    m_canvas->setProfile(!m_canvas->isProfileEnabled());
+}
+
+void PaintWindow::toggleHeatmap() {
+    m_canvas->setHeatmap(!m_canvas->isHeatmapEnabled());
+}
+
+void PaintWindow::tunePackets() {
+    m_canvas->tunePackets();
 }
 
 void PaintWindow::interp() {
@@ -75,6 +75,11 @@ private slots:
     void setNoAccel();
     void setBihAccel();
     void setAllAccel();
+    void toggleCache();
+    void toggleBudget();
+    void tunePackets();
+    void toggleProfile();
+    void toggleHeatmap();
 
     void interp();
 };
@@ -0,0 +1,394 @@
+#include "perfcounters.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+using std::endl;
+using std::setw;
+
+// Cycles, instructions, cache misses and branch mispredicts
+#define NUM_COUNTERS 4
+
+// Wall clock nanoseconds come first, then the counters
+#define NUM_VALUES (1 + NUM_COUNTERS)
+
+// Phases nested deeper than this are counted towards the last one kept
+#define MAX_NESTING 64
+
+static const char* PHASE_NAMES[PerfCounters::numPhases] = {
+    "build", "flatten", "primary", "shadow", "reflection", "refraction", "framebuffer"
+};
+
+static const char* COUNTER_NAMES[NUM_COUNTERS] = {
+    "cycles", "instr", "cache-miss", "branch-miss"
+};
+
+namespace {
+    struct Counts {
+        unsigned long long values[NUM_VALUES];
+        long rays;
+    };
+
+    struct ThreadCounters {
+        // Group file descriptor, or -1 without counters
+        int leader;
+        int fds[NUM_COUNTERS];
+
+        // Where each counter is in a group read, or -1 if it didn't open
+        int positions[NUM_COUNTERS];
+        int numOpen;
+
+        unsigned long long last[NUM_VALUES];
+
+        PerfCounters::Phase stack[MAX_NESTING];
+        int depth;
+
+        Counts counts[PerfCounters::numPhases];
+    };
+}
+
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+static pthread_key_t s_key;
+
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+static Counts s_totals[PerfCounters::numPhases];
+
+// Whether any thread managed to open each counter
+static bool s_opened[NUM_COUNTERS];
+
+//*************************** Counters *****************************
+
+#ifdef __linux__
+
+static const unsigned long long COUNTER_CONFIGS[NUM_COUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+// The first counter that opens leads the group, and the rest join it so
+// they can all be read with one call
+static void openCounters(ThreadCounters* counters) {
+    for(int i = 0; i < NUM_COUNTERS; ++i) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = COUNTER_CONFIGS[i];
+        attr.read_format = PERF_FORMAT_GROUP;
+        attr.disabled = (counters->leader == -1) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        // This thread, on any CPU
+        int fd = syscall(__NR_perf_event_open, &attr, 0, -1, counters->leader, 0);
+
+        if(fd == -1) {
+            continue;
+        }
+
+        if(counters->leader == -1) {
+            counters->leader = fd;
+        }
+
+        counters->fds[i] = fd;
+        counters->positions[i] = counters->numOpen++;
+    }
+
+    if(counters->leader != -1) {
+        ioctl(counters->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(counters->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+static void closeCounters(ThreadCounters* counters) {
+    for(int i = 0; i < NUM_COUNTERS; ++i) {
+        if(counters->fds[i] != -1) {
+            close(counters->fds[i]);
+        }
+    }
+}
+
+static void readCounters(ThreadCounters* counters, unsigned long long* values) {
+    if(counters->leader == -1) {
+        return;
+    }
+
+    // Number of counters, then their values
+    unsigned long long group[1 + NUM_COUNTERS];
+
+    if(read(counters->leader, group, sizeof(group)) <= 0) {
+        return;
+    }
+
+    for(int i = 0; i < NUM_COUNTERS; ++i) {
+        if(counters->positions[i] != -1) {
+            values[1 + i] = group[1 + counters->positions[i]];
+        }
+    }
+}
+
+#else
+
+static void openCounters(ThreadCounters* counters) {
+    (void)counters;
+}
+
+static void closeCounters(ThreadCounters* counters) {
+    (void)counters;
+}
+
+static void readCounters(ThreadCounters* counters, unsigned long long* values) {
+    (void)counters;
+    (void)values;
+}
+
+#endif
+
+static void sample(ThreadCounters* counters, unsigned long long* values) {
+    memset(values, 0, NUM_VALUES * sizeof(unsigned long long));
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    values[0] = now.tv_sec * 1000000000ULL + now.tv_nsec;
+
+    readCounters(counters, values);
+}
+
+//*************************** Threads *****************************
+
+static void deleteThreadCounters(void* arg) {
+    ThreadCounters* counters = (ThreadCounters*)arg;
+
+    closeCounters(counters);
+    delete counters;
+}
+
+static void createKey() {
+    pthread_key_create(&s_key, deleteThreadCounters);
+}
+
+static ThreadCounters* getThreadCounters() {
+    pthread_once(&s_once, createKey);
+
+    ThreadCounters* counters = (ThreadCounters*)pthread_getspecific(s_key);
+
+    if(counters == NULL) {
+        counters = new ThreadCounters();
+        memset(counters, 0, sizeof(ThreadCounters));
+
+        counters->leader = -1;
+
+        for(int i = 0; i < NUM_COUNTERS; ++i) {
+            counters->fds[i] = -1;
+            counters->positions[i] = -1;
+        }
+
+        openCounters(counters);
+
+        pthread_mutex_lock(&s_mutex);
+        for(int i = 0; i < NUM_COUNTERS; ++i) {
+            s_opened[i] = s_opened[i] || counters->positions[i] != -1;
+        }
+        pthread_mutex_unlock(&s_mutex);
+
+        pthread_setspecific(s_key, counters);
+    }
+
+    return counters;
+}
+
+// Adds what was counted since the last sample to the innermost phase
+static void charge(ThreadCounters* counters, const unsigned long long* now) {
+    if(counters->depth == 0) {
+        return;
+    }
+
+    int top = std::min(counters->depth, MAX_NESTING) - 1;
+    Counts& counts = counters->counts[counters->stack[top]];
+
+    for(int i = 0; i < NUM_VALUES; ++i) {
+        counts.values[i] += now[i] - counters->last[i];
+    }
+}
+
+static void mergeCounts(ThreadCounters* counters) {
+    pthread_mutex_lock(&s_mutex);
+
+    for(int p = 0; p < PerfCounters::numPhases; ++p) {
+        for(int i = 0; i < NUM_VALUES; ++i) {
+            s_totals[p].values[i] += counters->counts[p].values[i];
+        }
+
+        s_totals[p].rays += counters->counts[p].rays;
+    }
+
+    pthread_mutex_unlock(&s_mutex);
+
+    memset(counters->counts, 0, sizeof(counters->counts));
+}
+
+//*************************** PerfCounters *****************************
+
+void PerfCounters::begin(Phase phase) {
+    ThreadCounters* counters = getThreadCounters();
+
+    unsigned long long now[NUM_VALUES];
+    sample(counters, now);
+
+    charge(counters, now);
+
+    if(counters->depth < MAX_NESTING) {
+        counters->stack[counters->depth] = phase;
+    }
+
+    ++counters->depth;
+    memcpy(counters->last, now, sizeof(now));
+}
+
+void PerfCounters::end() {
+    ThreadCounters* counters = getThreadCounters();
+
+    if(counters->depth == 0) {
+        return;
+    }
+
+    unsigned long long now[NUM_VALUES];
+    sample(counters, now);
+
+    charge(counters, now);
+
+    --counters->depth;
+    memcpy(counters->last, now, sizeof(now));
+
+    if(counters->depth == 0) {
+        mergeCounts(counters);
+    }
+}
+
+void PerfCounters::addRays(Phase phase, long rays) {
+    ThreadCounters* counters = getThreadCounters();
+    counters->counts[phase].rays += rays;
+
+    if(counters->depth == 0) {
+        mergeCounts(counters);
+    }
+}
+
+void PerfCounters::reset() {
+    pthread_mutex_lock(&s_mutex);
+    memset(s_totals, 0, sizeof(s_totals));
+    pthread_mutex_unlock(&s_mutex);
+}
+
+// A value per ray, or n/a for counters that never opened
+static void printValue(std::ostream& out, bool opened, double value, int width, int precision) {
+    if(opened) {
+        out << std::fixed << std::setprecision(precision) << setw(width) << value;
+    } else {
+        out << setw(width) << "n/a";
+    }
+}
+
+/*  report
+ *
+ *  Prints thread time and every counter per phase, then the same per ray
+ *  traced by the phase, with a last line for the whole frame per camera
+ *  ray. Instructions per cycle, and misses per thousand instructions,
+ *  show whether a phase is waiting on memory or on branches.
+ */
+void PerfCounters::report(std::ostream& out) {
+    Counts totals[numPhases];
+    bool opened[NUM_COUNTERS];
+
+    pthread_mutex_lock(&s_mutex);
+    memcpy(totals, s_totals, sizeof(totals));
+    memcpy(opened, s_opened, sizeof(opened));
+    pthread_mutex_unlock(&s_mutex);
+
+    bool any = false;
+    for(int i = 0; i < NUM_COUNTERS; ++i) {
+        any = any || opened[i];
+    }
+
+    if(!any) {
+        out << "Hardware counters unavailable, see /proc/sys/kernel/perf_event_paranoid" << endl;
+    }
+
+    std::ios::fmtflags flags = out.flags();
+
+    out << std::left << setw(12) << "phase" << std::right << setw(12) << "thread ms";
+    for(int i = 0; i < NUM_COUNTERS; ++i) {
+        out << setw(14) << COUNTER_NAMES[i];
+    }
+    out << setw(8) << "IPC" << setw(12) << "cache MPKI" << setw(12) << "branch MPKI" << endl;
+
+    Counts sum;
+    memset(&sum, 0, sizeof(sum));
+
+    for(int p = 0; p < numPhases; ++p) {
+        const unsigned long long* values = totals[p].values;
+
+        for(int i = 0; i < NUM_VALUES; ++i) {
+            sum.values[i] += values[i];
+        }
+
+        double instructions = (double)values[2];
+
+        out << std::left << setw(12) << PHASE_NAMES[p] << std::right;
+        printValue(out, true, values[0] / 1.0e6, 12, 1);
+
+        for(int i = 0; i < NUM_COUNTERS; ++i) {
+            printValue(out, opened[i], (double)values[1 + i], 14, 0);
+        }
+
+        printValue(out, opened[0] && opened[1] && values[1] > 0,
+                instructions / values[1], 8, 2);
+        printValue(out, opened[1] && opened[2] && instructions > 0,
+                1000.0 * values[3] / instructions, 12, 2);
+        printValue(out, opened[1] && opened[3] && instructions > 0,
+                1000.0 * values[4] / instructions, 12, 2);
+        out << endl;
+    }
+
+    out << endl << std::left << setw(12) << "per ray" << std::right << setw(12) << "rays"
+        << setw(12) << "ns";
+    for(int i = 0; i < NUM_COUNTERS; ++i) {
+        out << setw(14) << COUNTER_NAMES[i];
+    }
+    out << endl;
+
+    for(int p = 0; p <= numPhases; ++p) {
+        // The last line is everything per camera ray
+        const Counts& counts = (p < numPhases) ? totals[p] : sum;
+        long rays = (p < numPhases) ? counts.rays : totals[primary].rays;
+
+        if(rays == 0) {
+            continue;
+        }
+
+        out << std::left << setw(12) << ((p < numPhases) ? PHASE_NAMES[p] : "frame")
+            << std::right << setw(12) << rays;
+        printValue(out, true, counts.values[0] / (double)rays, 12, 1);
+
+        for(int i = 0; i < NUM_COUNTERS; ++i) {
+            printValue(out, opened[i], counts.values[1 + i] / (double)rays, 14, 2);
+        }
+
+        out << endl;
+    }
+
+    out.flags(flags);
+}
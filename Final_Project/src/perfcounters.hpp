@@ -0,0 +1,67 @@
+#ifndef CS488_PERFCOUNTERS_HPP
+#define CS488_PERFCOUNTERS_HPP
+
+#include <ostream>
+#include "a4.hpp"
+
+// Hardware counters per render phase, read with perf_event_open when
+// PROFILE is on. Every thread opens its own counters the first time it
+// enters a phase. Phases nest, and a nested phase's counts only go to
+// that phase, so a shadow pass run from a reflection isn't counted as
+// reflection. Counts go into shared totals when a thread leaves its
+// outermost phase.
+//
+// Counters are read when a camera packet or a batch of secondary rays
+// starts and ends, never per ray, since every read is a system call.
+// Rays traced one at a time, as without packets, are counted towards
+// the phase of the batch that cast them.
+//
+// Where perf_event_open isn't available or allowed, only wall clock
+// time and ray counts are kept.
+class PerfCounters {
+public:
+    enum Phase {
+        build,          // BIH construction
+        flatten,        // Scene graph to primitive list
+        primary,        // Camera rays
+        shadow,
+        reflection,
+        refraction,
+        framebuffer,    // Pixel writes and resolving the frame
+        numPhases
+    };
+
+    static void begin(Phase phase);
+    static void end();
+
+    // Rays traced by a phase, for the per ray figures
+    static void addRays(Phase phase, long rays);
+
+    static void reset();
+
+    // Totals and per ray figures for everything since the last reset.
+    // Only counts from phases that have ended are included.
+    static void report(std::ostream& out);
+};
+
+// Counts everything until it goes out of scope towards phase, if PROFILE
+// was on when it was made
+class PerfPhase {
+public:
+    PerfPhase(PerfCounters::Phase phase) : m_active(PROFILE) {
+        if(m_active) {
+            PerfCounters::begin(phase);
+        }
+    }
+
+    ~PerfPhase() {
+        if(m_active) {
+            PerfCounters::end();
+        }
+    }
+
+private:
+    bool m_active;
+};
+
+#endif
@@ -0,0 +1,410 @@
+#include "pngwriter.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+using std::cerr;
+using std::endl;
+using std::max;
+using std::min;
+using std::string;
+using std::vector;
+
+// Bands are not split into parts smaller than this, since every part
+// starts deflating with an empty window
+#define MIN_PART_ROWS 16
+
+#define MAX_THREADS 64
+
+// Output is taken from zlib this many bytes at a time
+#define DEFLATE_BUFFER 16384
+
+int PngWriter::LEVEL = 6;
+PngWriter::Filter PngWriter::FILTER = PngWriter::adaptive;
+int PngWriter::THREADS = 8;
+
+static const unsigned char SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+// One thread's share of a band: rows first to last - 1 of img
+struct PngWriter::Part {
+    const QImage* img;
+    int first;
+    int last;
+
+    // The row above first as RGB, used when first is the top of img
+    const unsigned char* above;
+
+    int level;
+    Filter filter;
+
+    // The deflated rows, and the Adler-32 and length of the filtered
+    // bytes that went into them
+    vector<unsigned char> out;
+    uLong adler;
+    uLong length;
+    bool ok;
+};
+
+static void putInt(unsigned char* dest, uLong value) {
+    dest[0] = (value >> 24) & 0xff;
+    dest[1] = (value >> 16) & 0xff;
+    dest[2] = (value >> 8) & 0xff;
+    dest[3] = value & 0xff;
+}
+
+static void toRGB(const QImage& img, int y, unsigned char* dest) {
+    const QRgb* src = (const QRgb*)img.constScanLine(y);
+
+    for(int x = 0; x < img.width(); ++x) {
+        *dest++ = qRed(src[x]);
+        *dest++ = qGreen(src[x]);
+        *dest++ = qBlue(src[x]);
+    }
+}
+
+static inline int paethPredictor(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+
+    if(pa <= pb && pa <= pc) {
+        return a;
+    }
+
+    return (pb <= pc) ? b : c;
+}
+
+// Writes the filter type and then line filtered against prev into dest.
+// Bytes to the left of the row count as zero.
+static void filterRow(int type, const unsigned char* line, const unsigned char* prev, int stride,
+        unsigned char* dest) {
+    *dest++ = type;
+
+    switch(type) {
+    case PngWriter::none:
+        memcpy(dest, line, stride);
+        break;
+    case PngWriter::sub:
+        for(int x = 0; x < stride; ++x) {
+            dest[x] = line[x] - ((x >= 3) ? line[x - 3] : 0);
+        }
+        break;
+    case PngWriter::up:
+        for(int x = 0; x < stride; ++x) {
+            dest[x] = line[x] - prev[x];
+        }
+        break;
+    case PngWriter::average:
+        for(int x = 0; x < stride; ++x) {
+            dest[x] = line[x] - ((((x >= 3) ? line[x - 3] : 0) + prev[x]) >> 1);
+        }
+        break;
+    default:
+        for(int x = 0; x < stride; ++x) {
+            int a = (x >= 3) ? line[x - 3] : 0;
+            int c = (x >= 3) ? prev[x - 3] : 0;
+            dest[x] = line[x] - paethPredictor(a, prev[x], c);
+        }
+        break;
+    }
+}
+
+// Sum of the filtered bytes as signed values, the usual guess at which
+// filter will deflate best
+static long filteredCost(const unsigned char* row, int stride) {
+    long cost = 0;
+
+    for(int x = 1; x <= stride; ++x) {
+        cost += abs((signed char)row[x]);
+    }
+
+    return cost;
+}
+
+// Feeds everything in strm to deflate and appends what comes out
+static bool deflateAll(z_stream* strm, int flush, vector<unsigned char>* out) {
+    unsigned char buffer[DEFLATE_BUFFER];
+
+    do {
+        strm->next_out = buffer;
+        strm->avail_out = DEFLATE_BUFFER;
+
+        if(deflate(strm, flush) == Z_STREAM_ERROR) {
+            return false;
+        }
+
+        out->insert(out->end(), buffer, buffer + DEFLATE_BUFFER - strm->avail_out);
+    } while(strm->avail_out == 0);
+
+    return true;
+}
+
+void PngWriter::encodePart(Part* part) {
+    int stride = 3 * part->img->width();
+
+    vector<unsigned char> prev(stride);
+    vector<unsigned char> line(stride);
+
+    // Room for the row with each filter, when picking the best
+    int tries = (part->filter == adaptive) ? 5 : 1;
+    vector<unsigned char> filtered(tries * (stride + 1));
+
+    if(part->first > 0) {
+        toRGB(*part->img, part->first - 1, &prev[0]);
+    } else {
+        memcpy(&prev[0], part->above, stride);
+    }
+
+    part->adler = adler32(0L, Z_NULL, 0);
+    part->length = 0;
+    part->ok = false;
+
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+
+    // A raw stream, since the parts share the one zlib header
+    if(deflateInit2(&strm, part->level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return;
+    }
+
+    bool ok = true;
+
+    for(int y = part->first; y < part->last && ok; ++y) {
+        toRGB(*part->img, y, &line[0]);
+
+        unsigned char* row = &filtered[0];
+
+        if(part->filter == adaptive) {
+            long best = -1;
+
+            for(int type = none; type <= paeth; ++type) {
+                unsigned char* candidate = &filtered[type * (stride + 1)];
+                filterRow(type, &line[0], &prev[0], stride, candidate);
+
+                long cost = filteredCost(candidate, stride);
+
+                if(best < 0 || cost < best) {
+                    best = cost;
+                    row = candidate;
+                }
+            }
+        } else {
+            filterRow(part->filter, &line[0], &prev[0], stride, row);
+        }
+
+        part->adler = adler32(part->adler, row, stride + 1);
+        part->length += stride + 1;
+
+        strm.next_in = row;
+        strm.avail_in = stride + 1;
+        ok = deflateAll(&strm, Z_NO_FLUSH, &part->out);
+
+        prev.swap(line);
+    }
+
+    // Byte aligned and not final, so the next part can follow directly
+    strm.avail_in = 0;
+    part->ok = ok && deflateAll(&strm, Z_SYNC_FLUSH, &part->out);
+
+    deflateEnd(&strm);
+}
+
+void* PngWriter::part_bootstrap(void* part) {
+    encodePart((Part*)part);
+    return NULL;
+}
+
+PngWriter::PngWriter() :
+    m_file(NULL), m_failed(false), m_width(0), m_height(0), m_row(0),
+    m_level(LEVEL), m_filter(FILTER), m_threads(THREADS), m_adler(0)
+{}
+
+PngWriter::~PngWriter() {
+    destroy();
+}
+
+void PngWriter::destroy() {
+    if(m_file != NULL) {
+        fclose(m_file);
+    }
+
+    m_file = NULL;
+}
+
+void PngWriter::writeChunk(const char* type, const unsigned char* data, size_t size) {
+    unsigned char header[8];
+    putInt(header, size);
+    memcpy(header + 4, type, 4);
+
+    uLong sum = crc32(crc32(0L, Z_NULL, 0), header + 4, 4);
+
+    if(size > 0) {
+        sum = crc32(sum, data, size);
+    }
+
+    unsigned char crc[4];
+    putInt(crc, sum);
+
+    if(fwrite(header, 1, 8, m_file) != 8 || fwrite(data, 1, size, m_file) != size ||
+            fwrite(crc, 1, 4, m_file) != 4) {
+        m_failed = true;
+    }
+}
+
+bool PngWriter::open(const string& filename, int width, int height) {
+    destroy();
+
+    m_file = fopen(filename.c_str(), "wb");
+
+    if(m_file == NULL) {
+        cerr << "Could not open " << filename << " for writing" << endl;
+        return false;
+    }
+
+    m_level = LEVEL;
+    m_filter = FILTER;
+    m_threads = THREADS;
+
+    m_failed = fwrite(SIGNATURE, 1, 8, m_file) != 8;
+
+    // 8 bit RGB, not interlaced
+    unsigned char ihdr[13];
+    putInt(ihdr, width);
+    putInt(ihdr + 4, height);
+    ihdr[8] = 8;
+    ihdr[9] = 2;
+    ihdr[10] = ihdr[11] = ihdr[12] = 0;
+
+    writeChunk("IHDR", ihdr, 13);
+
+    // The zlib header, with the level hint zlib itself would give
+    unsigned char zheader[2] = { 0x78, 0x9c };
+
+    if(m_level < 2) {
+        zheader[1] = 0x01;
+    } else if(m_level < 6) {
+        zheader[1] = 0x5e;
+    } else if(m_level > 6) {
+        zheader[1] = 0xda;
+    }
+
+    writeChunk("IDAT", zheader, 2);
+
+    m_width = width;
+    m_height = height;
+    m_row = 0;
+    m_adler = adler32(0L, Z_NULL, 0);
+
+    m_prevLine.assign(3 * width, 0);
+
+    if(m_failed) {
+        cerr << "Could not write " << filename << endl;
+        destroy();
+        return false;
+    }
+
+    return true;
+}
+
+bool PngWriter::writeRows(const QImage& img) {
+    if(m_file == NULL || img.width() != m_width || m_row + img.height() > m_height) {
+        return false;
+    }
+
+    int rows = img.height();
+    int numParts = max(1, min(m_threads, rows / MIN_PART_ROWS));
+
+    vector<Part> parts(numParts);
+
+    for(int p = 0; p < numParts; ++p) {
+        parts[p].img = &img;
+        parts[p].first = rows * p / numParts;
+        parts[p].last = rows * (p + 1) / numParts;
+        parts[p].above = &m_prevLine[0];
+        parts[p].level = m_level;
+        parts[p].filter = m_filter;
+    }
+
+    if(numParts == 1) {
+        encodePart(&parts[0]);
+    } else {
+        vector<pthread_t> threads(numParts);
+
+        for(int p = 0; p < numParts; ++p) {
+            pthread_create(&threads[p], NULL, part_bootstrap, &parts[p]);
+        }
+
+        for(int p = 0; p < numParts; ++p) {
+            pthread_join(threads[p], NULL);
+        }
+    }
+
+    for(int p = 0; p < numParts; ++p) {
+        if(!parts[p].ok) {
+            m_failed = true;
+        }
+
+        if(!parts[p].out.empty()) {
+            writeChunk("IDAT", &parts[p].out[0], parts[p].out.size());
+        }
+
+        m_adler = adler32_combine(m_adler, parts[p].adler, parts[p].length);
+    }
+
+    if(rows > 0) {
+        toRGB(img, rows - 1, &m_prevLine[0]);
+    }
+
+    m_row += rows;
+
+    return !m_failed;
+}
+
+bool PngWriter::close() {
+    if(m_file == NULL || m_row != m_height) {
+        destroy();
+        return false;
+    }
+
+    // An empty final block with fixed codes ends the deflate stream, and
+    // the Adler-32 of every filtered row ends the zlib stream
+    unsigned char end[6] = { 0x03, 0x00 };
+    putInt(end + 2, m_adler);
+
+    writeChunk("IDAT", end, 6);
+    writeChunk("IEND", NULL, 0);
+
+    bool ok = !m_failed && fflush(m_file) == 0 && !ferror(m_file);
+    destroy();
+
+    return ok;
+}
+
+bool PngWriter::setCompression(int level, Filter filter, int threads) {
+    if(level < 0 || level > 9 || threads < 1 || threads > MAX_THREADS) {
+        return false;
+    }
+
+    LEVEL = level;
+    FILTER = filter;
+    THREADS = threads;
+
+    return true;
+}
+
+bool PngWriter::parseFilter(const string& name, Filter* filter) {
+    static const char* names[] = { "none", "sub", "up", "average", "paeth", "adaptive" };
+
+    for(int i = none; i <= adaptive; ++i) {
+        if(name == names[i]) {
+            *filter = (Filter)i;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,74 @@
+#ifndef CS488_PNGWRITER_HPP
+#define CS488_PNGWRITER_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <zlib.h>
+#include <QImage>
+
+// Writes an 8 bit RGB PNG a few rows at a time, so only the rows being
+// written have to be in memory. Rows must be given top to bottom, and
+// every row must be written before close.
+//
+// Each band of rows is split into parts that are filtered and deflated
+// on their own threads. Every part is a separate deflate stream ended
+// with a sync flush, so the parts join into one valid zlib stream.
+class PngWriter {
+public:
+    // Row filters, as numbered by the PNG spec. adaptive picks the one
+    // with the smallest sum of absolute differences for each row.
+    enum Filter { none, sub, up, average, paeth, adaptive };
+
+    PngWriter();
+    ~PngWriter();
+
+    bool open(const std::string& filename, int width, int height);
+
+    // Appends every row of img, which must be Format_RGB32 and as wide
+    // as the image
+    bool writeRows(const QImage& img);
+
+    // Finishes the file. Returns false if anything failed to write.
+    bool close();
+
+    // zlib level from 0 (stored) to 9, the row filter and how many
+    // threads encode each band. Applies to files opened afterwards.
+    static bool setCompression(int level, Filter filter, int threads);
+    static Filter getFilter() { return FILTER; }
+    static int getThreads() { return THREADS; }
+    static bool parseFilter(const std::string& name, Filter* filter);
+
+private:
+    struct Part;
+
+    static void* part_bootstrap(void* part);
+    static void encodePart(Part* part);
+
+    void writeChunk(const char* type, const unsigned char* data, size_t size);
+    void destroy();
+
+    FILE* m_file;
+    bool m_failed;
+
+    int m_width;
+    int m_height;
+    int m_row;
+
+    int m_level;
+    Filter m_filter;
+    int m_threads;
+
+    // Adler-32 of every filtered byte so far, for the zlib trailer
+    uLong m_adler;
+
+    // The last row written, as RGB, which the first row of the next band
+    // is filtered against
+    std::vector<unsigned char> m_prevLine;
+
+    static int LEVEL;
+    static Filter FILTER;
+    static int THREADS;
+};
+
+#endif
@@ -0,0 +1,492 @@
+#include "pool.hpp"
+#include "primitive.hpp"
+#include "mesh.hpp"
+#include "polyroots.hpp"
+#include "simdroots.hpp"
+
+#include <math.h>
+#include <algorithm>
+#include <limits>
+
+using std::vector;
+
+// ********************** Affine *****************************
+
+Affine::Affine(const Matrix4x4& mat) {
+    for(int i = 0; i < 3; ++i) {
+        Vector4D row = mat.getRow(i);
+
+        for(int j = 0; j < 4; ++j) {
+            m[4*i + j] = row[j];
+        }
+    }
+}
+
+Point3D Affine::transformPoint(const Point3D& p) const {
+    return Point3D(
+            m[0]*p[0] + m[1]*p[1] + m[2]*p[2] + m[3],
+            m[4]*p[0] + m[5]*p[1] + m[6]*p[2] + m[7],
+            m[8]*p[0] + m[9]*p[1] + m[10]*p[2] + m[11]);
+}
+
+Vector3D Affine::transformVector(const Vector3D& v) const {
+    return Vector3D(
+            m[0]*v[0] + m[1]*v[1] + m[2]*v[2],
+            m[4]*v[0] + m[5]*v[1] + m[6]*v[2],
+            m[8]*v[0] + m[9]*v[1] + m[10]*v[2]);
+}
+
+Vector3D Affine::transformNormal(const Vector3D& n) const {
+    return Vector3D(
+            m[0]*n[0] + m[4]*n[1] + m[8]*n[2],
+            m[1]*n[0] + m[5]*n[1] + m[9]*n[2],
+            m[2]*n[0] + m[6]*n[1] + m[10]*n[2]);
+}
+
+// ********************** Bounds *****************************
+
+Bounds::Bounds(const Point3D& min, const Point3D& max) {
+    for(int i = 0; i < 3; ++i) {
+        m_min[i] = (float)min[i];
+        m_max[i] = (float)max[i];
+
+        if(m_min[i] > min[i]) {
+            m_min[i] = nextafterf(m_min[i], -HUGE_VALF);
+        }
+        if(m_max[i] < max[i]) {
+            m_max[i] = nextafterf(m_max[i], HUGE_VALF);
+        }
+    }
+}
+
+// ********************** PrimitivePool *****************************
+
+PrimitivePool::PrimitivePool(vector<Primitive*>* primitives) :
+    m_numMeshTriangles(0)
+{
+    for(auto it = primitives->begin(); it != primitives->end(); ++it) {
+        (*it)->addToPool(this);
+    }
+}
+
+void PrimitivePool::addRef(Type type, int index, const Bounds& bounds) {
+    m_refs.push_back(((unsigned int)type << 29) | (unsigned int)index);
+    m_bounds.push_back(bounds);
+}
+
+void PrimitivePool::addWorldSphere(Primitive* prim, const Point3D& center, double radius) {
+    Ball ball;
+    ball.center = center;
+    ball.radius = radius;
+    ball.prim = prim;
+
+    Vector3D extent(radius, radius, radius);
+
+    addRef(Type::worldSphere, m_worldSpheres.size(), Bounds(center - extent, center + extent));
+    m_worldSpheres.push_back(ball);
+}
+
+void PrimitivePool::addSphere(Primitive* prim, const Matrix4x4& inv) {
+    Shape sphere;
+    sphere.inv = Affine(inv);
+    sphere.prim = prim;
+
+    AABB* bbox = prim->getWorldBBox();
+
+    addRef(Type::sphere, m_spheres.size(), Bounds(bbox->m_min, bbox->m_max));
+    m_spheres.push_back(sphere);
+}
+
+void PrimitivePool::addBox(Primitive* prim, const Matrix4x4& inv) {
+    Shape box;
+    box.inv = Affine(inv);
+    box.prim = prim;
+
+    AABB* bbox = prim->getWorldBBox();
+
+    addRef(Type::box, m_boxes.size(), Bounds(bbox->m_min, bbox->m_max));
+    m_boxes.push_back(box);
+}
+
+void PrimitivePool::addTriangle(Primitive* prim, const Point3D& p0, const Point3D& p1, const Point3D& p2) {
+    Tri tri;
+    tri.v0 = p0;
+    tri.e1 = p1 - p0;
+    tri.e2 = p2 - p0;
+    tri.prim = prim;
+
+    Point3D min = Point3D::min(p0, Point3D::min(p1, p2));
+    Point3D max = Point3D::max(p0, Point3D::max(p1, p2));
+
+    addRef(Type::triangle, m_triangles.size(), Bounds(min, max));
+    m_triangles.push_back(tri);
+}
+
+void PrimitivePool::addMesh(Primitive* prim, const TriangleMesh& mesh,
+        const Matrix4x4& trans, const Matrix4x4& inv)
+{
+    MeshInstance instance;
+    instance.first = m_numMeshTriangles;
+    instance.mesh = &mesh;
+    instance.inv = Affine(inv);
+    instance.prim = prim;
+    m_meshes.push_back(instance);
+
+    int numTriangles = mesh.getNumTriangles();
+    m_numMeshTriangles += numTriangles;
+
+    m_refs.reserve(m_refs.size() + numTriangles);
+    m_bounds.reserve(m_bounds.size() + numTriangles);
+
+    for(int i = 0; i < numTriangles; ++i) {
+        const unsigned int* tri = mesh.getTriangle(i);
+
+        Point3D min;
+        Point3D max;
+
+        for(int j = 0; j < 3; ++j) {
+            Point3D vertex = trans * mesh.getVertex(tri[j]);
+
+            min = (j == 0) ? vertex : Point3D::min(min, vertex);
+            max = (j == 0) ? vertex : Point3D::max(max, vertex);
+        }
+
+        addRef(Type::meshTriangle, instance.first + i, Bounds(min, max));
+    }
+}
+
+void PrimitivePool::addOther(Primitive* prim) {
+    AABB* bbox = prim->getWorldBBox();
+
+    addRef(Type::other, m_others.size(), Bounds(bbox->m_min, bbox->m_max));
+    m_others.push_back(prim);
+}
+
+void PrimitivePool::swapRefs(int i, int j) {
+    std::swap(m_refs[i], m_refs[j]);
+    std::swap(m_bounds[i], m_bounds[j]);
+}
+
+void PrimitivePool::releaseBounds() {
+    vector<Bounds>().swap(m_bounds);
+}
+
+bool PrimitivePool::getIntersection(unsigned int ref, const Ray& ray, Intersection* isect) const {
+    int index = getIndex(ref);
+
+    switch(getType(ref)) {
+        case Type::worldSphere:
+            return intersectWorldSphere(m_worldSpheres[index], ray, isect);
+        case Type::sphere:
+            return intersectSphere(m_spheres[index], ray, isect);
+        case Type::box:
+            return intersectBox(m_boxes[index], ray, isect);
+        case Type::triangle:
+            return intersectTriangle(m_triangles[index], ray, isect);
+        case Type::meshTriangle:
+            return intersectMeshTriangle(index, ray, isect);
+        default:
+            return m_others[index]->getIntersection(ray, isect);
+    }
+}
+
+void PrimitivePool::getIntersection(unsigned int ref, Packet& packet, LaneMask& active,
+        vector<bool>& v_hit, vector<Intersection>* v_isect) const
+{
+    Type type = getType(ref);
+
+    if(type == Type::worldSphere || type == Type::sphere) {
+        intersectSpheres(ref, packet, active, v_hit, v_isect);
+        return;
+    }
+
+    vector<Ray*>* rays = packet.getRays();
+    LaneIterator it(active);
+
+    for(int i = it.next(); i >= 0; i = it.next()) {
+        Ray* ray = rays->at(i);
+        Intersection* isect = v_isect == NULL ? NULL : &v_isect->at(i);
+
+        if(!getIntersection(ref, *ray, isect)) {
+            continue;
+        }
+
+        v_hit.at(i) = true;
+
+        if(isect != NULL) {
+            rays->at(i) = new Ray(ray->shorten(isect->getPoint()));
+            delete ray;
+        } else {
+            active.clear(i);
+        }
+    }
+}
+
+// Lanes of the packet are tested against one sphere by gathering their
+// quadratics and solving them together, a chunk at a time. Both kinds of
+// sphere give t along the world space ray, as in the scalar tests.
+
+#define SPHERE_CHUNK 64
+
+void PrimitivePool::intersectSpheres(unsigned int ref, Packet& packet, LaneMask& active,
+        vector<bool>& v_hit, vector<Intersection>* v_isect) const
+{
+    vector<Ray*>* rays = packet.getRays();
+
+    bool world = getType(ref) == Type::worldSphere;
+
+    const Ball* ball = world ? &m_worldSpheres[getIndex(ref)] : NULL;
+    const Shape* sphere = world ? NULL : &m_spheres[getIndex(ref)];
+
+    double A[SPHERE_CHUNK];
+    double B[SPHERE_CHUNK];
+    double C[SPHERE_CHUNK];
+    double roots[2*SPHERE_CHUNK];
+    int numRoots[SPHERE_CHUNK];
+    int lanes[SPHERE_CHUNK];
+
+    LaneIterator it(active);
+    int i = it.next();
+
+    while(i >= 0) {
+        int count = 0;
+
+        for(; i >= 0 && count < SPHERE_CHUNK; i = it.next()) {
+            Ray* ray = rays->at(i);
+
+            Vector3D o;
+            Vector3D d;
+
+            if(world) {
+                o = ray->getOrigin() - ball->center;
+                d = ray->getDirection();
+            } else {
+                o = Vector3D(sphere->inv.transformPoint(ray->getOrigin()));
+                d = sphere->inv.transformVector(ray->getDirection());
+            }
+
+            double radius = world ? ball->radius : 1.0;
+
+            A[count] = d.length2();
+            B[count] = 2*d.dot(o);
+            C[count] = o.length2() - radius*radius;
+            lanes[count] = i;
+            ++count;
+        }
+
+        solveQuadratics(count, A, B, C, roots, numRoots);
+
+        for(int k = 0; k < count; ++k) {
+            int lane = lanes[k];
+            Ray* ray = rays->at(lane);
+
+            bool hit = false;
+            double t = std::numeric_limits<double>::infinity();
+
+            for(int r = 0; r < numRoots[k]; ++r) {
+                double root = roots[r*count + k];
+
+                if(ray->checkParam(root) && root < t) {
+                    t = root;
+                    hit = true;
+                }
+            }
+
+            if(!hit) {
+                continue;
+            }
+
+            v_hit.at(lane) = true;
+
+            if(v_isect == NULL) {
+                active.clear(lane);
+                continue;
+            }
+
+            Point3D point = (*ray)(t);
+            Vector3D normal;
+
+            if(world) {
+                normal = (1.0 / ball->radius) * (point - ball->center);
+            } else {
+                Vector3D o = Vector3D(sphere->inv.transformPoint(ray->getOrigin()));
+                Vector3D d = sphere->inv.transformVector(ray->getDirection());
+
+                normal = sphere->inv.transformNormal(o + t*d);
+                normal.normalize();
+            }
+
+            v_isect->at(lane) = Intersection(point, t, world ? ball->prim : sphere->prim, normal);
+
+            rays->at(lane) = new Ray(ray->shorten(point));
+            delete ray;
+        }
+    }
+}
+
+bool PrimitivePool::intersectWorldSphere(const Ball& ball, const Ray& ray, Intersection* isect) const {
+    double t;
+
+    if(!getSphereParam(ball.center, ball.radius, ray, &t)) {
+        return false;
+    }
+
+    if(isect != NULL) {
+        Point3D point = ray(t);
+        *isect = Intersection(point, t, ball.prim, (1.0 / ball.radius) * (point - ball.center));
+    }
+
+    return true;
+}
+
+// The model space ray is left unnormalized so that t is the same
+// parameter as along the world space ray, and checkParam applies as is.
+
+bool PrimitivePool::intersectSphere(const Shape& sphere, const Ray& ray, Intersection* isect) const {
+    Vector3D o = Vector3D(sphere.inv.transformPoint(ray.getOrigin()));
+    Vector3D d = sphere.inv.transformVector(ray.getDirection());
+
+    double A = d.length2();
+    double B = 2*d.dot(o);
+    double C = o.length2() - 1.0;
+
+    double roots[2];
+    int numRoots = quadraticRoots(A, B, C, roots);
+
+    bool hit = false;
+    double t = std::numeric_limits<double>::infinity();
+
+    for(int i = 0; i < numRoots; ++i) {
+        if(ray.checkParam(roots[i]) && roots[i] < t) {
+            t = roots[i];
+            hit = true;
+        }
+    }
+
+    if(hit && isect != NULL) {
+        Vector3D normal = sphere.inv.transformNormal(o + t*d);
+        normal.normalize();
+
+        *isect = Intersection(ray(t), t, sphere.prim, normal);
+    }
+
+    return hit;
+}
+
+bool PrimitivePool::intersectBox(const Shape& box, const Ray& ray, Intersection* isect) const {
+    Point3D o = box.inv.transformPoint(ray.getOrigin());
+    Vector3D d = box.inv.transformVector(ray.getDirection());
+
+    double t_min = -std::numeric_limits<double>::infinity();
+    double t_max = std::numeric_limits<double>::infinity();
+
+    int axis_min = 0;
+    int axis_max = 0;
+
+    bool finite_ray = ray.hasEndpoint();
+
+    double ray_length = ray.getLength();
+    double epsilon = ray.getEpsilon();
+
+    for(int i = 0; i < 3; i++) {
+        if(fabs(d[i]) > 1.0e-15) {
+            double t1 = (1.0 - o[i]) / d[i];
+            double t2 = -o[i] / d[i];
+
+            if(t1 > t2) {
+                std::swap(t1, t2);
+            }
+
+            if(t1 > t_min) {
+                t_min = t1;
+                axis_min = i;
+            }
+            if(t2 < t_max) {
+                t_max = t2;
+                axis_max = i;
+            }
+
+            if(t_min > t_max || t_max < epsilon) {
+                return false;
+            }
+
+        } else if(o[i] < 0.0 || o[i] > 1.0) {
+            return false;
+        }
+
+        if(finite_ray && t_min > ray_length) {
+            return false;
+        }
+    }
+
+    if(finite_ray && t_min <= epsilon && t_max > ray_length) {
+        return false;
+    }
+
+    if(isect != NULL) {
+        double t = (t_min > epsilon) ? t_min : t_max;
+        int axis = (t_min > epsilon) ? axis_min : axis_max;
+
+        Vector3D normal(0.0, 0.0, 0.0);
+        normal[axis] = -d[axis];
+
+        normal = box.inv.transformNormal(normal);
+        normal.normalize();
+
+        *isect = Intersection(ray(t), t, box.prim, normal);
+    }
+
+    return true;
+}
+
+bool PrimitivePool::intersectTriangle(const Tri& tri, const Ray& ray, Intersection* isect) const {
+    double t;
+
+    if(!getTriangleParam(tri.v0, tri.e1, tri.e2, ray, &t)) {
+        return false;
+    }
+
+    if(isect != NULL) {
+        Vector3D normal = tri.e1.cross(tri.e2);
+        normal.normalize();
+
+        *isect = Intersection(ray(t), t, tri.prim, normal);
+    }
+
+    return true;
+}
+
+// As for spheres, the ray is taken to model space unnormalized so that t
+// is its parameter along the world space ray.
+
+bool PrimitivePool::intersectMeshTriangle(int index, const Ray& ray, Intersection* isect) const {
+    // The last instance starting at or before this triangle
+    auto it = std::upper_bound(m_meshes.begin(), m_meshes.end(), index,
+            [](int i, const MeshInstance& instance) { return i < instance.first; });
+
+    const MeshInstance& instance = *(it - 1);
+    const TriangleMesh* mesh = instance.mesh;
+    const unsigned int* tri = mesh->getTriangle(index - instance.first);
+
+    Point3D v0 = mesh->getVertex(tri[0]);
+    Vector3D e1 = mesh->getVertex(tri[1]) - v0;
+    Vector3D e2 = mesh->getVertex(tri[2]) - v0;
+
+    Point3D o = instance.inv.transformPoint(ray.getOrigin());
+    Vector3D d = instance.inv.transformVector(ray.getDirection());
+
+    double t;
+
+    if(!getTriangleParam(v0, e1, e2, o, d, ray, &t)) {
+        return false;
+    }
+
+    if(isect != NULL) {
+        Vector3D normal = instance.inv.transformNormal(e1.cross(e2));
+        normal.normalize();
+
+        *isect = Intersection(ray(t), t, instance.prim, normal);
+    }
+
+    return true;
+}
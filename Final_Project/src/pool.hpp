@@ -0,0 +1,157 @@
+#ifndef CS488_POOL_HPP
+#define CS488_POOL_HPP
+
+#include <vector>
+
+#include "algebra.hpp"
+#include "ray.hpp"
+#include "intersection.hpp"
+#include "packet.hpp"
+#include "lanemask.hpp"
+
+class Primitive;
+class TriangleMesh;
+
+// The top three rows of an affine matrix
+struct Affine {
+    Affine() {}
+    Affine(const Matrix4x4& mat);
+
+    Point3D transformPoint(const Point3D& p) const;
+    Vector3D transformVector(const Vector3D& v) const;
+
+    // Multiplies by the transpose, which takes model normals to world
+    // space when this is the world to model transform
+    Vector3D transformNormal(const Vector3D& n) const;
+
+    double m[12];
+};
+
+// World space bounds of a pool entry, only kept while the BIH is built.
+// Stored as floats rounded outward, so they still enclose the entry.
+struct Bounds {
+    Bounds() {}
+    Bounds(const Point3D& min, const Point3D& max);
+
+    double getMedian(int axis) const { return ((double)m_max[axis] + m_min[axis]) / 2.0; }
+
+    Point3D getMin() const { return Point3D(m_min[0], m_min[1], m_min[2]); }
+    Point3D getMax() const { return Point3D(m_max[0], m_max[1], m_max[2]); }
+
+    float m_min[3];
+    float m_max[3];
+};
+
+/*  PrimitivePool
+ *
+ *  The geometry of a scene copied out of the Primitive objects into one
+ *  array per shape. Uniformly scaled spheres are stored as a world
+ *  space centre and radius, other spheres and boxes as the transform
+ *  into a unit shape, and polygons as triangles. Indexed meshes are not
+ *  copied: each instance refers to the buffers of its TriangleMesh and
+ *  keeps the transform into model space, where its rays are tested.
+ *
+ *  The BIH refers to entries by a ref that holds the shape type in its
+ *  top three bits, so a leaf test is a switch instead of a virtual
+ *  call. Each entry keeps its Primitive for shading, and anything
+ *  without a compact form is tested through it.
+ */
+class PrimitivePool {
+public:
+    enum Type {
+        worldSphere,
+        sphere,
+        box,
+        triangle,
+        meshTriangle,
+        other
+    };
+
+    PrimitivePool(std::vector<Primitive*>* primitives);
+
+    // For spheres that are still spheres in world space
+    void addWorldSphere(Primitive* prim, const Point3D& center, double radius);
+
+    // inv takes world space to the unit sphere at the origin
+    void addSphere(Primitive* prim, const Matrix4x4& inv);
+
+    // inv takes world space to the unit box from (0, 0, 0) to (1, 1, 1)
+    void addBox(Primitive* prim, const Matrix4x4& inv);
+
+    void addTriangle(Primitive* prim, const Point3D& p0, const Point3D& p1, const Point3D& p2);
+
+    // trans takes the mesh to world space and inv back. The mesh must
+    // outlive the pool.
+    void addMesh(Primitive* prim, const TriangleMesh& mesh,
+            const Matrix4x4& trans, const Matrix4x4& inv);
+
+    void addOther(Primitive* prim);
+
+    int getNumRefs() const { return m_refs.size(); }
+    unsigned int getRef(int index) const { return m_refs[index]; }
+
+    const Bounds& getBounds(int index) const { return m_bounds[index]; }
+    void swapRefs(int i, int j);
+    void releaseBounds();
+
+    static Type getType(unsigned int ref) { return (Type)(ref >> 29); }
+    static int getIndex(unsigned int ref) { return ref & 0x1fffffff; }
+
+    bool getIntersection(unsigned int ref, const Ray& ray, Intersection* isect) const;
+    // Tests the lanes set in active. Lanes of shadow packets, which have
+    // no v_isect, are cleared from active once they hit.
+    void getIntersection(unsigned int ref, Packet& packet, LaneMask& active,
+            std::vector<bool>& v_hit, std::vector<Intersection>* v_isect) const;
+
+private:
+    struct Shape {
+        Affine inv;
+        Primitive* prim;
+    };
+
+    struct Ball {
+        Point3D center;
+        double radius;
+        Primitive* prim;
+    };
+
+    struct Tri {
+        Point3D v0;
+        Vector3D e1;
+        Vector3D e2;
+        Primitive* prim;
+    };
+
+    // The triangles of one mesh instance are numbered from first
+    struct MeshInstance {
+        int first;
+        const TriangleMesh* mesh;
+        Affine inv;
+        Primitive* prim;
+    };
+
+    void addRef(Type type, int index, const Bounds& bounds);
+
+    void intersectSpheres(unsigned int ref, Packet& packet, LaneMask& active,
+            std::vector<bool>& v_hit, std::vector<Intersection>* v_isect) const;
+
+    bool intersectWorldSphere(const Ball& ball, const Ray& ray, Intersection* isect) const;
+    bool intersectSphere(const Shape& sphere, const Ray& ray, Intersection* isect) const;
+    bool intersectBox(const Shape& box, const Ray& ray, Intersection* isect) const;
+    bool intersectTriangle(const Tri& tri, const Ray& ray, Intersection* isect) const;
+    bool intersectMeshTriangle(int index, const Ray& ray, Intersection* isect) const;
+
+    std::vector<Ball> m_worldSpheres;
+    std::vector<Shape> m_spheres;
+    std::vector<Shape> m_boxes;
+    std::vector<Tri> m_triangles;
+    std::vector<Primitive*> m_others;
+
+    std::vector<MeshInstance> m_meshes;
+    int m_numMeshTriangles;
+
+    std::vector<unsigned int> m_refs;
+    std::vector<Bounds> m_bounds;
+};
+
+#endif
@@ -1,7 +1,10 @@
 #include "primitive.hpp"
 #include "polyroots.hpp"
+#include "pool.hpp"
+#include "a4.hpp"
 
 #include <math.h>
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <vector>
@@ -10,6 +13,30 @@ using std::cout;
 using std::endl;
 using std::vector;
 
+// ************************ WorldSphere *****************************
+
+void WorldSphere::update(const Matrix4x4& trans, const Point3D& pos, double modelRadius) {
+    Vector3D axes[3];
+
+    for(int i = 0; i < 3; ++i) {
+        axes[i] = Vector3D(trans[0][i], trans[1][i], trans[2][i]);
+    }
+
+    double scale2 = axes[0].length2();
+    double tolerance = 1.0e-9 * scale2;
+
+    uniform = fabs(axes[1].length2() - scale2) < tolerance &&
+        fabs(axes[2].length2() - scale2) < tolerance &&
+        fabs(axes[0].dot(axes[1])) < tolerance &&
+        fabs(axes[0].dot(axes[2])) < tolerance &&
+        fabs(axes[1].dot(axes[2])) < tolerance;
+
+    center = trans * pos;
+    radius = sqrt(scale2) * modelRadius;
+}
+
+// ************************ Primitive *****************************
+
 Primitive::~Primitive()
 {
 }
@@ -56,40 +83,38 @@ bool Primitive::allMiss(const Packet& packet) {
     return m_worldBBox.allMiss(packet);
 }
 
-void Primitive::getIntersection(Packet& packet, int firstActive, vector<bool>& v_hit, vector<Intersection>* v_isect) {
+void Primitive::getIntersection(Packet& packet, LaneMask& active, vector<bool>& v_hit, vector<Intersection>* v_isect) {
 /*    if(allMiss(packet)) {
         return;
     }*/
 
     vector<Ray*>* rays = packet.getRays();
-    int n = rays->size();
+    LaneIterator it(active);
 
-    for(int i = firstActive; i < n; ++i) {
+    for(int i = it.next(); i >= 0; i = it.next()) {
         Ray* ray = rays->at(i);
+        Intersection* isect = v_isect == NULL ? NULL : &v_isect->at(i);
 
-        if(ray != NULL) {
-            Intersection* isect = v_isect == NULL ? NULL : &v_isect->at(i);
-
-            if(isect != NULL || !v_hit.at(i)) {
-                bool hit = getIntersection(*ray, isect);
-
-                if(hit) {
-                    v_hit.at(i) = true;
+        if(getIntersection(*ray, isect)) {
+            v_hit.at(i) = true;
 
-                    if(isect != NULL) {
-                        Ray* oldRay = rays->at(i);
-                        rays->at(i) = new Ray(ray->getOrigin(), isect->getPoint());
-
-                        delete oldRay;
-                    }
-                }
+            if(isect != NULL) {
+                rays->at(i) = new Ray(ray->shorten(isect->getPoint()));
+                delete ray;
+            } else {
+                active.clear(i);
             }
         }
     }
 }
 
-Colour Primitive::getColour(const Point3D& point) {
+void Primitive::addToPool(PrimitivePool* pool) {
+    pool->addOther(this);
+}
+
+Colour Primitive::getColour(const Point3D& point, double footprint) {
     (void)point;
+    (void)footprint;
 
     return m_material->getKD();
 }
@@ -105,20 +130,51 @@ Sphere::Sphere() {
     Point3D max(1, 1, 1);
 
     setBBox(min, max);
+    m_world.update(m_trans, Point3D(0, 0, 0), 1.0);
 }
 
 Sphere::~Sphere()
 {
 }
 
-Sphere::Sphere(const Sphere& other) : Primitive(other) {}
+Sphere::Sphere(const Sphere& other) : Primitive(other), m_world(other.m_world) {}
 
 Sphere& Sphere::operator=(const Sphere& other) {
     Primitive::operator=(other);
+    m_world = other.m_world;
+
     return *this;
 }
 
+void Sphere::setTransform(const Matrix4x4& trans, const Matrix4x4& inv) {
+    Primitive::setTransform(trans, inv);
+    m_world.update(m_trans, Point3D(0, 0, 0), 1.0);
+}
+
+// Shared by Sphere and NonhierSphere when the sphere is still a sphere
+// in world space
+static bool getWorldIntersection(const WorldSphere& sphere, Primitive* prim,
+        const Ray& ray, Intersection* isect)
+{
+    double t;
+
+    if(!getSphereParam(sphere.center, sphere.radius, ray, &t)) {
+        return false;
+    }
+
+    if(isect != NULL) {
+        Point3D point = ray(t);
+        *isect = Intersection(point, t, prim, (1.0 / sphere.radius) * (point - sphere.center));
+    }
+
+    return true;
+}
+
 bool Sphere::getIntersection(const Ray& ray, Intersection* isect) {
+    if(FAST_SPHERES && m_world.uniform) {
+        return getWorldIntersection(m_world, this, ray, isect);
+    }
+
     Ray modelRay = ray.getTransform(m_inv);
 
     if(!m_modelBBox.intersect(modelRay)) {
@@ -169,6 +225,14 @@ bool Sphere::getIntersection(const Ray& ray, Intersection* isect) {
     return hit;
 }
 
+void Sphere::addToPool(PrimitivePool* pool) {
+    if(FAST_SPHERES && m_world.uniform) {
+        pool->addWorldSphere(this, m_world.center, m_world.radius);
+    } else {
+        pool->addSphere(this, m_inv);
+    }
+}
+
 Cube::Cube() {
     Point3D min(0, 0, 0);
     Point3D max(1, 1, 1);
@@ -270,6 +334,10 @@ bool Cube::getIntersection(const Ray& ray, Intersection* isect) {
     return true;
 }
 
+void Cube::addToPool(PrimitivePool* pool) {
+    pool->addBox(this, m_inv);
+}
+
 int getDropIndex(const Point3D& point) {
     int index = 0;
     double min = fabs(point[0]);
@@ -290,7 +358,7 @@ int getDropIndex(const Point3D& point) {
     return index;
 }
 
-Colour Cube::getColour(const Point3D& point) {
+Colour Cube::getColour(const Point3D& point, double footprint) {
     if(m_texture == NULL) {
         return m_material->getKD();
     }
@@ -298,7 +366,17 @@ Colour Cube::getColour(const Point3D& point) {
     Point3D modelPoint = m_inv * point;
     int index = getDropIndex(modelPoint);
 
-    return m_texture->getColour(modelPoint.dropDim(index));
+    // Widest model space stretch of the footprint along the texture axes
+    double scale = 0.0;
+
+    for(int i = 0; i < 3; ++i) {
+        if(i != index) {
+            double* row = m_inv.getRow(i);
+            scale = std::max(scale, Vector3D(row[0], row[1], row[2]).length());
+        }
+    }
+
+    return m_texture->getColour(modelPoint.dropDim(index), scale * footprint);
 }
 
 Vector3D Cube::getOffset(const Point3D& point) {
@@ -334,6 +412,7 @@ NonhierSphere::NonhierSphere(const Point3D& pos, double radius) :
     Point3D max(m_pos[0] + m_radius, m_pos[1] + m_radius, m_pos[2] + m_radius);
 
     setBBox(min, max);   
+    m_world.update(m_trans, m_pos, m_radius);
 }
 
 NonhierSphere::~NonhierSphere()
@@ -345,6 +424,7 @@ NonhierSphere::NonhierSphere(const NonhierSphere& other) : Primitive(other)
 {
     m_pos = other.m_pos;
     m_radius = other.m_radius;
+    m_world = other.m_world;
 }
 
 NonhierSphere& NonhierSphere::operator=(const NonhierSphere& other) {
@@ -353,11 +433,21 @@ NonhierSphere& NonhierSphere::operator=(const NonhierSphere& other) {
 
         m_pos = other.m_pos;
         m_radius = other.m_radius;
+        m_world = other.m_world;
     }
     return *this;
 }
 
+void NonhierSphere::setTransform(const Matrix4x4& trans, const Matrix4x4& inv) {
+    Primitive::setTransform(trans, inv);
+    m_world.update(m_trans, m_pos, m_radius);
+}
+
 bool NonhierSphere::getIntersection(const Ray& ray, Intersection* isect) {
+    if(FAST_SPHERES && m_world.uniform) {
+        return getWorldIntersection(m_world, this, ray, isect);
+    }
+
     Ray modelRay = ray.getTransform(m_inv);
 
     if(!m_modelBBox.intersect(modelRay)) {
@@ -408,6 +498,18 @@ bool NonhierSphere::getIntersection(const Ray& ray, Intersection* isect) {
     return hit;
 }
 
+void NonhierSphere::addToPool(PrimitivePool* pool) {
+    if(FAST_SPHERES && m_world.uniform) {
+        pool->addWorldSphere(this, m_world.center, m_world.radius);
+        return;
+    }
+
+    double scale = 1.0 / m_radius;
+
+    pool->addSphere(this, Matrix4x4::getScaleMat(Vector3D(scale, scale, scale)) *
+            Matrix4x4::getTransMat(-Vector3D(m_pos)) * m_inv);
+}
+
 NonhierBox::NonhierBox(const Point3D& pos, double size) :
     m_pos(pos), m_size(size)
 {
@@ -518,3 +620,10 @@ bool NonhierBox::getIntersection(const Ray& ray, Intersection* isect) {
 
     return true;
 }
+
+void NonhierBox::addToPool(PrimitivePool* pool) {
+    double scale = 1.0 / m_size;
+
+    pool->addBox(this, Matrix4x4::getScaleMat(Vector3D(scale, scale, scale)) *
+            Matrix4x4::getTransMat(-Vector3D(m_pos)) * m_inv);
+}
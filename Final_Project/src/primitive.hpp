@@ -9,6 +9,46 @@
 #include "map.hpp"
 #include "material.hpp"
 
+class PrimitivePool;
+
+// Sets t and returns true if the ray hits the sphere within its parameter
+// range. Works from the point of closest approach, which keeps the
+// discriminant accurate for small spheres far from the ray origin.
+inline bool getSphereParam(const Point3D& center, double radius, const Ray& ray, double* t) {
+    const Vector3D& d = ray.getDirection();
+    Vector3D oc = ray.getOrigin() - center;
+
+    double b = oc.dot(d);
+    Vector3D f = oc - b * d;
+
+    double h = radius * radius - f.length2();
+    if(h < 0.0) {
+        return false;
+    }
+
+    h = sqrt(h);
+
+    *t = -b - h;
+    if(ray.checkParam(*t)) {
+        return true;
+    }
+
+    *t = -b + h;
+    return ray.checkParam(*t);
+}
+
+// A sphere in world space. Only valid when the transform scales all axes
+// alike, since the sphere is then still a sphere.
+struct WorldSphere {
+    WorldSphere() : uniform(false), radius(0.0) {}
+
+    void update(const Matrix4x4& trans, const Point3D& pos, double modelRadius);
+
+    bool uniform;
+    Point3D center;
+    double radius;
+};
+
 class Primitive {
 public:
     Primitive() {}
@@ -17,7 +57,7 @@ public:
     Primitive(const Primitive& other);
     Primitive& operator=(const Primitive& other);
 
-    void setTransform(const Matrix4x4& trans, const Matrix4x4& inv);
+    virtual void setTransform(const Matrix4x4& trans, const Matrix4x4& inv);
 
     PhongMaterial* getMaterial() const { return m_material; }
     void setMaterial(PhongMaterial* material) { m_material = material; }
@@ -29,9 +69,9 @@ public:
     void setBump(Bump* bump) { m_bump = bump; }
 
     virtual bool allMiss(const Packet& packet);
-    void getIntersection(Packet& packet, int firstActive, std::vector<bool>& v_hit, std::vector<Intersection>* v_isect);   
+    void getIntersection(Packet& packet, LaneMask& active, std::vector<bool>& v_hit, std::vector<Intersection>* v_isect);   
     
-    virtual Colour getColour(const Point3D& point);
+    virtual Colour getColour(const Point3D& point, double footprint);
     virtual Vector3D getOffset(const Point3D& point);
    
     virtual Primitive* clone() = 0;
@@ -39,6 +79,10 @@ public:
 
     virtual bool isMesh() { return false; }
 
+    // Copies the geometry into the pool the BIH traverses. Anything
+    // without a compact form is added as is.
+    virtual void addToPool(PrimitivePool* pool);
+
     AABB* getWorldBBox() { return &m_worldBBox; }
 
 protected:
@@ -65,6 +109,12 @@ public:
    
     virtual Sphere* clone() { return new Sphere(*this); }
     virtual bool getIntersection(const Ray& ray, Intersection* isect);
+    virtual void addToPool(PrimitivePool* pool);
+
+    virtual void setTransform(const Matrix4x4& trans, const Matrix4x4& inv);
+
+private:
+    WorldSphere m_world;
 };
 
 class Cube : public Primitive {
@@ -77,8 +127,9 @@ public:
 
     virtual Cube* clone() { return new Cube(*this); }
     virtual bool getIntersection(const Ray& ray, Intersection* isect);
+    virtual void addToPool(PrimitivePool* pool);
 
-    virtual Colour getColour(const Point3D& point);
+    virtual Colour getColour(const Point3D& point, double footprint);
     virtual Vector3D getOffset(const Point3D& point);
 };
 
@@ -92,10 +143,15 @@ public:
 
     virtual NonhierSphere* clone() { return new NonhierSphere(*this); }
     virtual bool getIntersection(const Ray& ray, Intersection* isect);
+    virtual void addToPool(PrimitivePool* pool);
+
+    virtual void setTransform(const Matrix4x4& trans, const Matrix4x4& inv);
 
 private:
     Point3D m_pos;
     double m_radius;
+
+    WorldSphere m_world;
 };
 
 class NonhierBox : public Primitive {
@@ -108,6 +164,7 @@ public:
 
     virtual NonhierBox* clone() { return new NonhierBox(*this); }
     virtual bool getIntersection(const Ray& ray, Intersection* isect);
+    virtual void addToPool(PrimitivePool* pool);
 
 private:
     Point3D m_pos;
@@ -16,6 +16,9 @@ Ray::Ray(Point3D origin, Vector3D direction, double epsilon) {
 
     m_epsilon = epsilon;
     m_length = std::numeric_limits<double>::infinity();
+
+    m_coneWidth = 0.0;
+    m_coneSpread = 0.0;
 }
 
 Ray::Ray(Point3D origin, Point3D endpoint, double epsilon) {
@@ -30,6 +33,9 @@ Ray::Ray(Point3D origin, Point3D endpoint, double epsilon) {
     m_endpoint = endpoint;
 
     m_epsilon = epsilon;
+
+    m_coneWidth = 0.0;
+    m_coneSpread = 0.0;
 }
 
 void Ray::copy(const Ray& other) {
@@ -41,6 +47,9 @@ void Ray::copy(const Ray& other) {
 
     m_epsilon = other.m_epsilon;
     m_length = other.m_length;
+
+    m_coneWidth = other.m_coneWidth;
+    m_coneSpread = other.m_coneSpread;
 }
 
 Ray::Ray(const Ray& other) {
@@ -55,6 +64,10 @@ Ray& Ray::operator=(const Ray& other) {
     return *this;
 }
 
+double Ray::getFootprint(const Point3D& point) const {
+    return m_coneWidth + m_coneSpread * (point - m_origin).length();
+}
+
 bool Ray::checkParam(double t) const {
     if(t < m_epsilon) {
         return false;
@@ -85,5 +98,17 @@ Ray Ray::getTransform(Matrix4x4& trans) const {
     (r.m_direction).normalize();
     r.m_epsilon = m_epsilon;
 
+    r.m_coneWidth = m_coneWidth;
+    r.m_coneSpread = m_coneSpread;
+
+    return r;
+}
+
+Ray Ray::shorten(const Point3D& endpoint) const {
+    Ray r(m_origin, endpoint, m_epsilon);
+
+    r.m_coneWidth = m_coneWidth;
+    r.m_coneSpread = m_coneSpread;
+
     return r;
 }
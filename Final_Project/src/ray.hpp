@@ -6,7 +6,7 @@
 class Ray {
 
 public:
-    Ray() {}
+    Ray() : m_coneWidth(0.0), m_coneSpread(0.0) {}
 
     Ray(Point3D origin, Vector3D direction, double epsilon = 1.0e-9); 
     Ray(Point3D origin, Point3D endpoint, double epsilon = 1.0e-9); 
@@ -26,9 +26,18 @@ public:
     double getEpsilon() const { return m_epsilon; }
     double getLength() const { return m_length; }
 
+    // The ray stands for a cone that is m_coneWidth wide at its origin
+    // and widens by m_coneSpread per unit of distance
+    void setCone(double width, double spread) { m_coneWidth = width; m_coneSpread = spread; }
+    double getConeSpread() const { return m_coneSpread; }
+    double getFootprint(const Point3D& point) const;
+
     bool checkParam(double t) const;
     Ray getTransform(Matrix4x4& trans) const;
 
+    // The same ray ending at endpoint, keeping its epsilon and cone
+    Ray shorten(const Point3D& endpoint) const;
+
 private:
     void copy(const Ray& other);
 
@@ -40,6 +49,9 @@ private:
 
     double m_epsilon;
     double m_length;
+
+    double m_coneWidth;
+    double m_coneSpread;
 };
 
 inline Ray operator*(const Matrix4x4& mat, const Ray& ray) {
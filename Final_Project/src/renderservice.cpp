@@ -0,0 +1,709 @@
+#include "renderservice.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <QElapsedTimer>
+
+#include "a4.hpp"
+#include "perfcounters.hpp"
+#include "imagewriter.hpp"
+#include "tracejob.hpp"
+
+using std::deque;
+using std::list;
+using std::vector;
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+// The auto-tune probe is this fraction of the frame on each side, but
+// no smaller than PROBE_MIN_SIZE pixels
+#define PROBE_SCALE 0.5
+#define PROBE_MIN_SIZE 128
+
+// Each packet size is timed this many times and the fastest run is kept,
+// which is the one least disturbed by the rest of the machine
+#define PROBE_RUNS 5
+
+// Packet sizes tried by the auto-tune, in rays across and down
+static const int PROBE_SIZES[][2] = {
+    {4, 4}, {8, 4}, {8, 8}, {16, 8}, {8, 16}, {16, 16}
+};
+
+namespace {
+    // Identifies a primitive across rebuilds of the primitive list
+    struct PrimitiveKey {
+        PrimitiveKey(Primitive* prim) :
+            m_bbox(*prim->getWorldBBox()), m_material(prim->getMaterial()) {}
+
+        bool operator<(const PrimitiveKey& other) const {
+            for(int i = 0; i < 3; ++i) {
+                if(m_bbox.m_min[i] != other.m_bbox.m_min[i]) {
+                    return m_bbox.m_min[i] < other.m_bbox.m_min[i];
+                }
+                if(m_bbox.m_max[i] != other.m_bbox.m_max[i]) {
+                    return m_bbox.m_max[i] < other.m_bbox.m_max[i];
+                }
+            }
+
+            return m_material < other.m_material;
+        }
+
+        AABB m_bbox;
+        PhongMaterial* m_material;
+    };
+}
+
+static vector<PrimitiveKey> getKeys(vector<Primitive*>* primitives) {
+    vector<PrimitiveKey> keys;
+
+    for(auto it = primitives->begin(); it != primitives->end(); ++it) {
+        keys.push_back(PrimitiveKey(*it));
+    }
+
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// Collects the bounding boxes of primitives that appear in only one of
+// the two lists, padded so that hits on their surface still count
+static vector<AABB> getMovedBBoxes(const vector<PrimitiveKey>& before, const vector<PrimitiveKey>& after) {
+    vector<PrimitiveKey> moved;
+
+    std::set_symmetric_difference(before.begin(), before.end(), after.begin(), after.end(),
+            std::back_inserter(moved));
+
+    vector<AABB> bboxes;
+    Vector3D pad(1.0e-6, 1.0e-6, 1.0e-6);
+
+    for(auto it = moved.begin(); it != moved.end(); ++it) {
+        bboxes.push_back(AABB(it->m_bbox.m_min - pad, it->m_bbox.m_max + pad));
+    }
+
+    return bboxes;
+}
+
+static void deletePrimitives(vector<Primitive*>* primitives) {
+    for(auto it = primitives->begin(); it != primitives->end(); ++it) {
+        delete *it;
+    }
+
+    delete primitives;
+}
+
+//*************************** RenderCommand *****************************
+
+RenderCommand::RenderCommand(Type type) :
+    type(type), primitives(NULL), camera(NULL), width(0), height(0), sampleWidth(1), enabled(false),
+    bih(false), packets(false)
+{}
+
+//*************************** RenderService *****************************
+
+RenderService::RenderService(const Camera& cam, vector<Primitive*>* primitives, const Colour& ambient,
+        const list<Light*>* lights, int deadline) :
+    m_lights(lights), m_primitives(primitives),
+    m_width(cam.getWidth()), m_height(cam.getHeight()), m_sampleWidth(1),
+    m_budget(deadline, 1, 0), m_costs(NUMTHREADS), m_measureCosts(false), m_frameNsecs(0),
+    m_hasFrame(false), m_interactive(false),
+    m_budgetEnabled(true), m_cacheEnabled(CACHE), m_profileEnabled(PROFILE), m_heatmapEnabled(HEATMAP),
+    m_printStatus(false)
+{
+    m_cam = new Camera(cam);
+    m_tracer = new Tracer(m_primitives, ambient, lights);
+
+    m_fullDepth = m_tracer->getMaxDepth();
+    m_budget.setLimits(m_sampleWidth, m_fullDepth);
+    m_settings = m_budget.getFullSettings();
+
+    m_frame = new FrameBuffer(m_width, m_height);
+    m_packets = CameraPacket::genPackets(m_frame, m_tracer, *m_cam, m_sampleWidth);
+
+    pthread_mutex_init(&m_queueMutex, NULL);
+    pthread_cond_init(&m_queueCond, NULL);
+
+    pthread_create(&m_renderThread, NULL, render_bootstrap, this);
+
+    if(AUTOTUNE) {
+        autoTune();
+    }
+}
+
+RenderService::~RenderService() {
+    push(RenderCommand(RenderCommand::Quit));
+    pthread_join(m_renderThread, NULL);
+
+    pthread_cond_destroy(&m_queueCond);
+    pthread_mutex_destroy(&m_queueMutex);
+
+    // The packets point into the tracer, whose BIH points into the
+    // primitives
+    CameraPacket::deletePackets(m_packets);
+    delete m_tracer;
+    deletePrimitives(m_primitives);
+
+    delete m_frame;
+    delete m_cam;
+}
+
+void RenderService::push(const RenderCommand& command) {
+    pthread_mutex_lock(&m_queueMutex);
+    m_queue.push_back(command);
+    pthread_cond_signal(&m_queueCond);
+    pthread_mutex_unlock(&m_queueMutex);
+}
+
+void RenderService::updateScene(vector<Primitive*>* primitives) {
+    RenderCommand command(RenderCommand::SceneUpdate);
+    command.primitives = primitives;
+
+    push(command);
+}
+
+void RenderService::setCamera(const Camera& cam) {
+    RenderCommand command(RenderCommand::CameraChange);
+    command.camera = new Camera(cam);
+
+    push(command);
+}
+
+void RenderService::resize(int width, int height, int sampleWidth) {
+    RenderCommand command(RenderCommand::Resize);
+    command.width = width;
+    command.height = height;
+    command.sampleWidth = sampleWidth;
+
+    push(command);
+}
+
+void RenderService::save(const QString& filename, int width, int height) {
+    RenderCommand command(RenderCommand::Save);
+    command.filename = filename;
+    command.width = width;
+    command.height = height;
+
+    push(command);
+}
+
+void RenderService::autoTune() {
+    push(RenderCommand(RenderCommand::AutoTune));
+}
+
+void RenderService::setCache(bool enabled) {
+    pthread_mutex_lock(&m_queueMutex);
+    m_cacheEnabled = enabled;
+    pthread_mutex_unlock(&m_queueMutex);
+
+    RenderCommand command(RenderCommand::SetCache);
+    command.enabled = enabled;
+
+    push(command);
+}
+
+bool RenderService::isCacheEnabled() {
+    pthread_mutex_lock(&m_queueMutex);
+    bool enabled = m_cacheEnabled;
+    pthread_mutex_unlock(&m_queueMutex);
+
+    return enabled;
+}
+
+void RenderService::setAcceleration(bool bih, bool packets) {
+    RenderCommand command(RenderCommand::SetAccel);
+    command.bih = bih;
+    command.packets = packets;
+
+    push(command);
+}
+
+void RenderService::setProfile(bool enabled) {
+    pthread_mutex_lock(&m_queueMutex);
+    m_profileEnabled = enabled;
+    pthread_mutex_unlock(&m_queueMutex);
+
+    RenderCommand command(RenderCommand::SetProfile);
+    command.enabled = enabled;
+
+    push(command);
+}
+
+bool RenderService::isProfileEnabled() {
+    pthread_mutex_lock(&m_queueMutex);
+    bool enabled = m_profileEnabled;
+    pthread_mutex_unlock(&m_queueMutex);
+
+    return enabled;
+}
+
+void RenderService::setHeatmap(bool enabled) {
+    pthread_mutex_lock(&m_queueMutex);
+    m_heatmapEnabled = enabled;
+    pthread_mutex_unlock(&m_queueMutex);
+
+    RenderCommand command(RenderCommand::SetHeatmap);
+    command.enabled = enabled;
+
+    push(command);
+}
+
+bool RenderService::isHeatmapEnabled() {
+    pthread_mutex_lock(&m_queueMutex);
+    bool enabled = m_heatmapEnabled;
+    pthread_mutex_unlock(&m_queueMutex);
+
+    return enabled;
+}
+
+void RenderService::setInteractive(bool interactive) {
+    pthread_mutex_lock(&m_queueMutex);
+    m_interactive = interactive;
+    pthread_mutex_unlock(&m_queueMutex);
+}
+
+void RenderService::setBudget(bool enabled) {
+    pthread_mutex_lock(&m_queueMutex);
+    m_budgetEnabled = enabled;
+    pthread_mutex_unlock(&m_queueMutex);
+}
+
+bool RenderService::isBudgetEnabled() {
+    pthread_mutex_lock(&m_queueMutex);
+    bool enabled = m_budgetEnabled;
+    pthread_mutex_unlock(&m_queueMutex);
+
+    return enabled;
+}
+
+void RenderService::setPrintStatus(bool printStatus) {
+    pthread_mutex_lock(&m_queueMutex);
+    m_printStatus = printStatus;
+    pthread_mutex_unlock(&m_queueMutex);
+}
+
+bool RenderService::getPrintStatus() {
+    pthread_mutex_lock(&m_queueMutex);
+    bool printStatus = m_printStatus;
+    pthread_mutex_unlock(&m_queueMutex);
+
+    return printStatus;
+}
+
+bool RenderService::takeFrame(QImage& img) {
+    pthread_mutex_lock(&m_queueMutex);
+
+    bool hasFrame = m_hasFrame;
+
+    if(hasFrame) {
+        img.swap(m_ready);
+        m_hasFrame = false;
+    }
+
+    pthread_mutex_unlock(&m_queueMutex);
+
+    return hasFrame;
+}
+
+void* RenderService::render_bootstrap(void* service) {
+    ((RenderService*)service)->renderLoop();
+    return NULL;
+}
+
+void RenderService::renderLoop() {
+    while(true) {
+        pthread_mutex_lock(&m_queueMutex);
+
+        while(m_queue.empty()) {
+            pthread_cond_wait(&m_queueCond, &m_queueMutex);
+        }
+
+        deque<RenderCommand> commands;
+        commands.swap(m_queue);
+
+        bool budget = m_budgetEnabled && m_interactive;
+        m_printProgress = m_printStatus;
+
+        pthread_mutex_unlock(&m_queueMutex);
+
+        // Only the newest scene in a batch is built, but the packet cache
+        // is invalidated against the one that was last displayed
+        vector<Primitive*>* scene = NULL;
+
+        bool render = false;
+        bool resize = false;
+        bool quit = false;
+
+        for(auto it = commands.begin(); it != commands.end(); ++it) {
+            switch(it->type) {
+                case RenderCommand::SceneUpdate:
+                    if(scene != NULL) {
+                        deletePrimitives(scene);
+                    }
+
+                    scene = it->primitives;
+                    render = true;
+                    break;
+
+                case RenderCommand::CameraChange:
+                    *m_cam = *it->camera;
+                    delete it->camera;
+
+                    render = resize = true;
+                    break;
+
+                case RenderCommand::Resize:
+                    m_width = it->width;
+                    m_height = it->height;
+                    m_sampleWidth = it->sampleWidth;
+
+                    render = resize = true;
+                    break;
+
+                case RenderCommand::Save:
+                    if(scene != NULL) {
+                        setScene(scene);
+                        scene = NULL;
+                    }
+
+                    saveImage(it->filename, it->width, it->height);
+                    resize = true;
+                    break;
+
+                case RenderCommand::AutoTune:
+                    if(scene != NULL) {
+                        setScene(scene);
+                        scene = NULL;
+                    }
+
+                    tunePackets();
+                    render = resize = true;
+                    break;
+
+                case RenderCommand::SetCache:
+                    // Rays traced with the cache off kept no mirror paths
+                    // and had their dirty flags cleared all the same
+                    if(it->enabled && !CACHE) {
+                        CameraPacket::resetPackets(m_packets);
+                    }
+
+                    CACHE = it->enabled;
+                    render = true;
+                    break;
+
+                case RenderCommand::SetAccel:
+                    // The tracer skips its BIH while BIH is off, so the one
+                    // it has may be of primitives since deleted
+                    if(it->bih && !BIH) {
+                        BIH = true;
+                        m_tracer->updatePrimitives(m_primitives);
+                    }
+
+                    BIH = it->bih;
+                    PACKETS = it->packets;
+                    render = true;
+                    break;
+
+                case RenderCommand::SetProfile:
+                    PROFILE = it->enabled;
+                    break;
+
+                case RenderCommand::SetHeatmap:
+                    HEATMAP = it->enabled;
+                    break;
+
+                case RenderCommand::Quit:
+                    quit = true;
+                    break;
+            }
+        }
+
+        if(scene != NULL) {
+            if(quit) {
+                deletePrimitives(scene);
+            } else {
+                setScene(scene);
+            }
+        }
+
+        if(quit) {
+            return;
+        }
+
+        if(render || resize) {
+            renderFrame(resize, budget);
+        }
+    }
+}
+
+void RenderService::renderFrame(bool resize, bool budget) {
+    QElapsedTimer timer;
+    timer.start();
+
+    if(resize) {
+        m_budget.setLimits(m_sampleWidth, m_fullDepth);
+    }
+
+    FrameSettings settings = budget ? m_budget.getSettings() : m_budget.getFullSettings();
+
+    if(resize || settings != m_settings) {
+        updateSettings(settings);
+    }
+
+    m_costs.reset();
+    computeFrame(HEATMAP);
+
+    int elapsed = timer.elapsed();
+    timer.invalidate();
+
+    if(budget) {
+        double tracedFraction = m_raysTraced / (double)CameraPacket::countRays(m_packets);
+        m_budget.update(elapsed, tracedFraction);
+    }
+
+    QImage frame(m_frame->width(), m_frame->height(), QImage::Format_RGB32);
+    m_frame->resolve(&frame);
+
+    pthread_mutex_lock(&m_queueMutex);
+    m_ready.swap(frame);
+    m_hasFrame = true;
+    pthread_mutex_unlock(&m_queueMutex);
+
+    emit frameReady();
+
+    cout << "Time to compute image: " << elapsed << endl;
+
+    if(m_measureCosts) {
+        m_costs.printLoad(cout, m_frameNsecs);
+    }
+
+    if(PROFILE) {
+        PerfCounters::report(cout);
+        PerfCounters::reset();
+    }
+}
+
+/*  saveImage
+ *
+ *  Traces the image in bands of whole tile rows, so only one band of
+ *  samples is ever held. PNGs are written band by band as they finish,
+ *  and PFM and EXR files get the band's float colours without
+ *  quantizing. Other formats are gathered into one QImage and left to
+ *  Qt to write.
+ */
+void RenderService::saveImage(const QString& filename, int width, int height) {
+    Camera t_cam(*m_cam);
+    t_cam.updateDimensions(width, height);
+
+    m_tracer->setMaxDepth(m_fullDepth);
+
+    int bandRows = ImageWriter::getBandRows(width, CameraPacket::getPacketHeight() / m_sampleWidth);
+
+    ImageWriter writer;
+
+    if(!writer.open(filename.toStdString(), width, height)) {
+        return;
+    }
+
+    bool heatmap = HEATMAP;
+    m_costs.reset();
+
+    long long traceNsecs = 0;
+    bool ok = true;
+
+    vector<CameraPacket*>* t_packets = m_packets;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(int top = 0; top < height; top += bandRows) {
+        int rows = std::min(bandRows, height - top);
+
+        FrameBuffer band(width, height, top, rows);
+
+        m_packets = CameraPacket::genPackets(&band, m_tracer, t_cam, m_sampleWidth);
+        computeFrame(heatmap);
+        traceNsecs += m_frameNsecs;
+        CameraPacket::deletePackets(m_packets);
+
+        ok = writer.writeRows(band) && ok;
+    }
+
+    m_packets = t_packets;
+    ok = writer.close() && ok;
+
+    if(!ok) {
+        cerr << "Could not save " << filename.toStdString() << endl;
+    }
+
+    cout << "Time to save image: " << timer.elapsed() << endl;
+    timer.invalidate();
+
+    // The heatmap goes next to the image, as name_heat.png, and is
+    // streamed the same way
+    if(heatmap) {
+        int dot = filename.lastIndexOf('.');
+        QString heatName = ((dot < 0) ? filename : filename.left(dot)) + "_heat.png";
+
+        PngWriter heatWriter;
+
+        if(heatWriter.open(heatName.toStdString(), width, height)) {
+            for(int top = 0; top < height; top += bandRows) {
+                QImage img(width, std::min(bandRows, height - top), QImage::Format_RGB32);
+                m_costs.draw(&img, top);
+                heatWriter.writeRows(img);
+            }
+
+            if(heatWriter.close()) {
+                cout << "Saved cost heatmap to " << heatName.toStdString() << endl;
+            }
+        }
+
+        m_costs.printLoad(cout, traceNsecs);
+    }
+}
+
+/*  tunePackets
+ *
+ *  Renders a small version of the current view with each packet size in
+ *  PROBE_SIZES and keeps the fastest. Packets are made fresh for every
+ *  run, so the frame cache never hides the cost of tracing, and packet
+ *  costs aren't recorded, so the heatmap's timers aren't part of it.
+ */
+void RenderService::tunePackets() {
+    int width = std::max(PROBE_MIN_SIZE, (int)(m_width * PROBE_SCALE));
+    int height = std::max(PROBE_MIN_SIZE, (int)(m_height * PROBE_SCALE));
+
+    Camera probe(*m_cam);
+    probe.updateDimensions(width, height);
+
+    int numSizes = sizeof(PROBE_SIZES) / sizeof(PROBE_SIZES[0]);
+
+    int best = -1;
+    long long bestTime = 0;
+
+    for(int i = 0; i < numSizes; ++i) {
+        CameraPacket::setPacketSize(PROBE_SIZES[i][0], PROBE_SIZES[i][1]);
+
+        long long elapsed = timeProbe(probe);
+
+        for(int run = 1; run < PROBE_RUNS; ++run) {
+            elapsed = std::min(elapsed, timeProbe(probe));
+        }
+
+        cout << "Packet size " << PROBE_SIZES[i][0] << "x" << PROBE_SIZES[i][1] << ": " 
+            << elapsed / 1.0e6 << " ms" << endl;
+
+        if(best < 0 || elapsed < bestTime) {
+            best = i;
+            bestTime = elapsed;
+        }
+    }
+
+    CameraPacket::setPacketSize(PROBE_SIZES[best][0], PROBE_SIZES[best][1]);
+
+    cout << "Auto-tuned packet size: " << PROBE_SIZES[best][0] << "x" << PROBE_SIZES[best][1] 
+        << " rays (" << m_settings.sampleWidth << "x" << m_settings.sampleWidth 
+        << " samples, " << NUMTHREADS << " threads, " << width << "x" << height << " probe)" << endl;
+}
+
+// Traces the view from cam into a scratch frame with the current packet
+// size and returns the time taken in nanoseconds
+long long RenderService::timeProbe(const Camera& cam) {
+    FrameBuffer t_frame(cam.getWidth(), cam.getHeight());
+
+    vector<CameraPacket*>* t_packets = m_packets;
+    m_packets = CameraPacket::genPackets(&t_frame, m_tracer, cam, m_settings.sampleWidth);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    computeFrame(false);
+
+    long long elapsed = timer.nsecsElapsed();
+    timer.invalidate();
+
+    CameraPacket::deletePackets(m_packets);
+    m_packets = t_packets;
+
+    return elapsed;
+}
+
+void RenderService::setScene(vector<Primitive*>* primitives) {
+    vector<PrimitiveKey> before = getKeys(m_primitives);
+
+    m_tracer->updatePrimitives(primitives);
+
+    vector<AABB> moved = getMovedBBoxes(before, getKeys(primitives));
+    CameraPacket::invalidatePackets(m_packets, moved, m_lights);
+
+    deletePrimitives(m_primitives);
+    m_primitives = primitives;
+}
+
+// Rebuilds the image and packets for new frame settings
+void RenderService::updateSettings(const FrameSettings& settings) {
+    QElapsedTimer timer;
+    timer.start();
+
+    m_settings = settings;
+
+    int width = std::max(1, (int)(m_width * settings.scale));
+    int height = std::max(1, (int)(m_height * settings.scale));
+
+    m_cam->updateDimensions(width, height);
+    m_tracer->setMaxDepth(settings.maxDepth);
+
+    delete m_frame;
+    m_frame = new FrameBuffer(width, height);
+
+    CameraPacket::deletePackets(m_packets);
+    m_packets = CameraPacket::genPackets(m_frame, m_tracer, *m_cam, settings.sampleWidth);
+
+    cout << "Time to resize image: " << timer.elapsed() << endl;
+    timer.invalidate();
+}
+
+void RenderService::computeFrame(bool measureCosts) {
+    m_k = 1;
+    m_measureCosts = measureCosts;
+
+    if(m_measureCosts) {
+        m_costs.beginPackets(m_packets->size());
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if(m_printProgress) {
+        cout << "0\% complete" << endl;
+    }
+
+    bool watch = m_measureCosts || m_printProgress;
+    m_raysTraced = TraceJob::run(m_packets, NUMTHREADS, watch ? packet_done : NULL, this);
+
+    m_frameNsecs = timer.nsecsElapsed();
+
+    if(m_measureCosts) {
+        m_costs.endPackets(*m_packets);
+    }
+
+    if(m_printProgress) {
+        cout << "100\% complete" << endl;
+    }
+}
+
+void RenderService::packet_done(int index, int thread, long long nsecs, int rays, void* service) {
+    ((RenderService*)service)->finishPacket(index, thread, nsecs, rays);
+}
+
+void RenderService::finishPacket(int index, int thread, long long nsecs, int rays) {
+    if(m_measureCosts) {
+        m_costs.addPacket(index, thread, nsecs, rays);
+    }
+
+    if(m_printProgress && index == (int) ((m_k/10.0) * m_packets->size())) {
+        cout << m_k*10 << "\% complete" << endl;
+        m_k++;
+    }
+}
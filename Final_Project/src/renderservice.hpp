@@ -0,0 +1,182 @@
+#ifndef CS488_RENDERSERVICE_HPP
+#define CS488_RENDERSERVICE_HPP
+
+#include <deque>
+#include <list>
+#include <vector>
+#include <pthread.h>
+#include <QObject>
+#include <QImage>
+#include <QString>
+
+#include "algebra.hpp"
+#include "light.hpp"
+#include "camera.hpp"
+#include "tracer.hpp"
+#include "packet.hpp"
+#include "framebuffer.hpp"
+#include "primitive.hpp"
+#include "budget.hpp"
+#include "costmap.hpp"
+
+// A request from the GUI thread to the render thread
+struct RenderCommand {
+    enum Type { SceneUpdate, CameraChange, Resize, Save, AutoTune, SetCache, SetAccel, SetProfile,
+        SetHeatmap, Quit };
+
+    RenderCommand(Type type);
+
+    Type type;
+
+    // SceneUpdate: the new primitives, owned by the service once queued
+    std::vector<Primitive*>* primitives;
+
+    // CameraChange: the new camera, owned by the service once queued
+    Camera* camera;
+
+    // Resize and Save: the image size in pixels
+    int width;
+    int height;
+
+    // Resize: samples per pixel along each axis
+    int sampleWidth;
+
+    // Save: where to write the image
+    QString filename;
+
+    // SetCache, SetProfile and SetHeatmap: whether to turn the setting on
+    bool enabled;
+
+    // SetAccel: the new BIH and PACKETS, which only change together
+    bool bih;
+    bool packets;
+};
+
+// Owns the tracer and renders on its own thread. Commands are queued by
+// the GUI thread and applied in order before the next frame. The runtime
+// flags the tracing threads read are only changed by these commands, so
+// they hold still for a whole frame. Each frame
+// is traced into a float back buffer, quantized into a QImage and then
+// handed over through takeFrame once frameReady has been emitted.
+class RenderService : public QObject {
+
+    Q_OBJECT
+
+public:
+    // Takes ownership of primitives, as of those passed to updateScene
+    RenderService(const Camera& cam, std::vector<Primitive*>* primitives, const Colour& ambient,
+        const std::list<Light*>* lights, int deadline);
+    virtual ~RenderService();
+
+    void updateScene(std::vector<Primitive*>* primitives);
+    void setCamera(const Camera& cam);
+    void resize(int width, int height, int sampleWidth);
+    void save(const QString& filename, int width, int height);
+
+    // Times a small render of the scene at a few packet sizes and keeps
+    // the fastest
+    void autoTune();
+
+    // Turns the frame cache on or off from the next frame. Turning it on
+    // retraces every pixel once.
+    void setCache(bool enabled);
+    bool isCacheEnabled();
+
+    // Packets are only traced through the BIH, so packets implies bih
+    void setAcceleration(bool bih, bool packets);
+
+    void setProfile(bool enabled);
+    bool isProfileEnabled();
+    void setHeatmap(bool enabled);
+    bool isHeatmapEnabled();
+
+    // The frame budget only applies while the scene is interactive
+    void setInteractive(bool interactive);
+    void setBudget(bool enabled);
+    bool isBudgetEnabled();
+
+    void setPrintStatus(bool printStatus);
+    bool getPrintStatus();
+
+    // Swaps the newest frame into img. Returns false if there is no new frame.
+    bool takeFrame(QImage& img);
+
+signals:
+    void frameReady();
+
+private:
+    void push(const RenderCommand& command);
+
+    static void* render_bootstrap(void* service);
+    void renderLoop();
+
+    void renderFrame(bool resize, bool budget);
+    void saveImage(const QString& filename, int width, int height);
+    void tunePackets();
+    long long timeProbe(const Camera& cam);
+
+    void setScene(std::vector<Primitive*>* primitives);
+    void updateSettings(const FrameSettings& settings);
+
+    // Traces m_packets, timing each packet into m_costs if measureCosts
+    void computeFrame(bool measureCosts);
+
+    // Called by the tracing threads after each packet while costs are
+    // measured or progress printed
+    static void packet_done(int index, int thread, long long nsecs, int rays, void* service);
+    void finishPacket(int index, int thread, long long nsecs, int rays);
+
+    Camera* m_cam;
+    Tracer* m_tracer;
+    FrameBuffer* m_frame;
+
+    const std::list<Light*>* m_lights;
+    std::vector<Primitive*>* m_primitives;
+
+    std::vector<CameraPacket*>* m_packets;
+
+    int m_width;
+    int m_height;
+    int m_sampleWidth;
+
+    FrameBudget m_budget;
+    FrameSettings m_settings;
+    int m_fullDepth;
+
+    // Progress through the frame being traced
+    int m_k;
+    int m_raysTraced;
+    bool m_printProgress;
+
+    // Packet costs of the last frame or saved image, kept while HEATMAP is
+    // on
+    CostMap m_costs;
+    bool m_measureCosts;
+    long long m_frameNsecs;
+
+    static const int NUMTHREADS = 8;
+
+    pthread_t m_renderThread;
+    pthread_cond_t m_queueCond;
+
+    // Guards everything below it
+    pthread_mutex_t m_queueMutex;
+
+    std::deque<RenderCommand> m_queue;
+
+    QImage m_ready;
+    bool m_hasFrame;
+
+    bool m_interactive;
+    bool m_budgetEnabled;
+
+    // What CACHE, PROFILE and HEATMAP were last set to through the
+    // service. The render thread changes the flags themselves, between
+    // frames.
+    bool m_cacheEnabled;
+    bool m_profileEnabled;
+    bool m_heatmapEnabled;
+    bool m_printStatus;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "scene.hpp"
 #include "mesh.hpp"
+#include "perfcounters.hpp"
 
 #include <iostream>
 #include <limits>
@@ -7,6 +8,10 @@
 
 using namespace std;
 
+// How far matrix times its inverse may be from the identity before the
+// matrix is taken as singular
+#define SINGULAR_EPSILON 1.0e-6
+
 SceneNode::SceneNode(const std::string& name)
   : m_num_parents(0), m_name(name), m_firstRun(true)
 {
@@ -24,6 +29,8 @@ SceneNode::~SceneNode()
 }
 
 void SceneNode::getPrimitives(vector<Primitive*>* primitives, Game* game, double fallAmount) {
+    PerfPhase phase(PerfCounters::flatten);
+
     Matrix4x4 eye;
     getPrimitives(primitives, eye, eye, game, fallAmount);
 }
@@ -75,6 +82,31 @@ void SceneNode::translate(const Vector3D& amount)
     m_inv = invMat * m_inv;
 }
 
+bool SceneNode::transform(const Matrix4x4& matrix)
+{
+    Matrix4x4 inv = matrix.invert();
+
+    // invert gives up at a zero pivot, and a nearly singular matrix comes
+    // back with an inverse too far off to use, so check the product
+    Matrix4x4 product = matrix * inv;
+
+    for(int i = 0; i < 4; ++i) {
+        for(int j = 0; j < 4; ++j) {
+            double expected = (i == j) ? 1.0 : 0.0;
+
+            // Written so NaNs fail too
+            if(!(fabs(product[i][j] - expected) <= SINGULAR_EPSILON)) {
+                return false;
+            }
+        }
+    }
+
+    m_trans = m_trans * matrix;
+    m_inv = inv * m_inv;
+
+    return true;
+}
+
 bool SceneNode::is_joint() const
 {
   return false;
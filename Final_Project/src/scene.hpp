@@ -38,6 +38,10 @@ public:
     void scale(const Vector3D& amount);
     void translate(const Vector3D& amount);
 
+    // Applies any invertible matrix, after the transformations so far.
+    // Returns false, leaving the node as it was, if matrix is singular.
+    bool transform(const Matrix4x4& matrix);
+
     // Returns true if and only if this node is a JointNode
     virtual bool is_joint() const;
  
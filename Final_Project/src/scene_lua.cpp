@@ -39,9 +39,12 @@
 
 #include <iostream>
 #include <cctype>
+#include <cmath>
 #include <cstring>
 #include <cstdio>
+#include <stdint.h>
 #include <vector>
+#include <QElapsedTimer>
 
 #include "lua488.hpp"
 #include "light.hpp"
@@ -49,6 +52,9 @@
 #include "mesh.hpp"
 #include "tetris.hpp"
 #include "map.hpp"
+#include "packet.hpp"
+#include "pngwriter.hpp"
+#include "animation.hpp"
 
 // Uncomment the following line to enable debugging messages
 // #define GRLUA_ENABLE_DEBUG
@@ -113,6 +119,42 @@ void get_tuple(lua_State* L, int arg, T* data, int n)
   }
 }
 
+// Retrieve a flat list of numbers in groups of stride, either from a
+// table or from a string of packed Packed values in machine byte order,
+// such as one read from a binary file. Strings are copied whole, without
+// a Lua call per number.
+template<typename Packed>
+void get_flat(lua_State* L, int arg, int stride, std::vector<double>* data)
+{
+  if (lua_type(L, arg) == LUA_TSTRING) {
+    size_t size;
+    const char* bytes = lua_tolstring(L, arg, &size);
+
+    luaL_argcheck(L, size % (stride * sizeof(Packed)) == 0, arg,
+                  "Packed values in whole groups expected");
+
+    data->resize(size / sizeof(Packed));
+    for (size_t i = 0; i < data->size(); i++) {
+      Packed value;
+      std::memcpy(&value, bytes + i * sizeof(Packed), sizeof(Packed));
+      (*data)[i] = value;
+    }
+    return;
+  }
+
+  luaL_checktype(L, arg, LUA_TTABLE);
+  int count = luaL_getn(L, arg);
+
+  luaL_argcheck(L, count % stride == 0, arg, "Numbers in whole groups expected");
+
+  data->resize(count);
+  for (int i = 1; i <= count; i++) {
+    lua_rawgeti(L, arg, i);
+    (*data)[i - 1] = luaL_checknumber(L, -1);
+    lua_pop(L, 1);
+  }
+}
+
 // Create a node
 extern "C"
 int gr_node_cmd(lua_State* L)
@@ -288,11 +330,56 @@ int gr_mesh_cmd(lua_State* L)
 
     faces[i - 1].resize(index_count);
     get_tuple(L, -1, &faces[i - 1][0], index_count);
+
+    for (int j = 0; j < index_count; j++) {
+      int index = faces[i - 1][j];
+      luaL_argcheck(L, index >= 0 && index < vert_count, 3, "Vertex index out of range");
+    }
     
     lua_pop(L, 1);
   }
 
-  Mesh* mesh = new Mesh(verts, faces);
+  // Optional: store the vertices in 16 bits per axis
+  bool quantize = lua_toboolean(L, 4);
+
+  Mesh* mesh = new Mesh(verts, faces, quantize);
+  GRLUA_DEBUG(*mesh);
+  data->node = new GeometryNode(name, mesh);
+
+  luaL_getmetatable(L, "gr.node");
+  lua_setmetatable(L, -2);
+
+  return 1;
+}
+
+// Create a triangle mesh node from an OBJ file, without going through
+// Lua tables
+extern "C"
+int gr_obj_mesh_cmd(lua_State* L)
+{
+  GRLUA_DEBUG_CALL;
+
+  gr_node_ud* data = (gr_node_ud*)lua_newuserdata(L, sizeof(gr_node_ud));
+  data->node = 0;
+
+  const char* name = luaL_checkstring(L, 1);
+  const char* filename = luaL_checkstring(L, 2);
+
+  // Optional: store the vertices in 16 bits per axis
+  bool quantize = lua_toboolean(L, 3);
+
+  TriangleMesh* triangles = TriangleMesh::readObj(filename, quantize);
+
+  if (triangles == NULL) {
+    return luaL_error(L, "Could not read %s", filename);
+  }
+
+  if (triangles->getNumTriangles() < 1) {
+    delete triangles;
+    return luaL_argerror(L, 2, "OBJ file without faces");
+  }
+
+  Mesh* mesh = new Mesh(triangles);
   GRLUA_DEBUG(*mesh);
   data->node = new GeometryNode(name, mesh);
 
@@ -302,6 +389,163 @@ int gr_mesh_cmd(lua_State* L)
   return 1;
 }
 
+// Create a triangle mesh node from flat lists: x, y, z of each vertex,
+// then the three vertex indices, from 0, of each triangle. Either can be
+// a table or a packed string, of 32 bit floats for the vertices and 32
+// bit integers for the indices.
+extern "C"
+int gr_flat_mesh_cmd(lua_State* L)
+{
+  GRLUA_DEBUG_CALL;
+
+  gr_node_ud* data = (gr_node_ud*)lua_newuserdata(L, sizeof(gr_node_ud));
+  data->node = 0;
+
+  const char* name = luaL_checkstring(L, 1);
+
+  std::vector<double> verts, indices;
+  get_flat<float>(L, 2, 3, &verts);
+  get_flat<int32_t>(L, 3, 3, &indices);
+
+  int vert_count = verts.size() / 3;
+
+  luaL_argcheck(L, vert_count >= 1, 2, "Vertices expected");
+  luaL_argcheck(L, indices.size() >= 3, 3, "Triangles expected");
+
+  for (size_t i = 0; i < indices.size(); i++) {
+    if (indices[i] != floor(indices[i])) {
+      lua_pushfstring(L, "Index %d is not an integer", (int)i + 1);
+      return luaL_argerror(L, 3, lua_tostring(L, -1));
+    }
+
+    if (indices[i] < 0 || indices[i] >= vert_count) {
+      lua_pushfstring(L, "Index %d is out of range", (int)i + 1);
+      return luaL_argerror(L, 3, lua_tostring(L, -1));
+    }
+  }
+
+  // Optional: store the vertices in 16 bits per axis
+  bool quantize = lua_toboolean(L, 4);
+
+  TriangleMesh* triangles = new TriangleMesh();
+
+  for (int i = 0; i < vert_count; i++) {
+    triangles->addVertex(Point3D(verts[3 * i], verts[3 * i + 1], verts[3 * i + 2]));
+  }
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    triangles->addTriangle(indices[i], indices[i + 1], indices[i + 2]);
+  }
+
+  triangles->finalize(quantize);
+
+  Mesh* mesh = new Mesh(triangles);
+  GRLUA_DEBUG(*mesh);
+  data->node = new GeometryNode(name, mesh);
+
+  luaL_getmetatable(L, "gr.node");
+  lua_setmetatable(L, -2);
+
+  return 1;
+}
+
+// Create a node holding many non-hierarchical spheres of one material,
+// from a flat list of x, y, z and radius of each, as a table or a string
+// of packed 32 bit floats
+extern "C"
+int gr_nh_spheres_cmd(lua_State* L)
+{
+  GRLUA_DEBUG_CALL;
+
+  gr_node_ud* data = (gr_node_ud*)lua_newuserdata(L, sizeof(gr_node_ud));
+  data->node = 0;
+
+  const char* name = luaL_checkstring(L, 1);
+
+  std::vector<double> spheres;
+  get_flat<float>(L, 2, 4, &spheres);
+
+  gr_material_ud* matdata = (gr_material_ud*)luaL_checkudata(L, 3, "gr.material");
+  luaL_argcheck(L, matdata != 0, 3, "Material expected");
+
+  SceneNode* node = new SceneNode(name);
+
+  for (size_t i = 0; i < spheres.size(); i += 4) {
+    Point3D pos(spheres[i], spheres[i + 1], spheres[i + 2]);
+
+    GeometryNode* sphere = new GeometryNode(name, new NonhierSphere(pos, spheres[i + 3]));
+    sphere->set_material(matdata->material);
+    sphere->m_num_parents += 1;
+
+    node->add_child(sphere);
+  }
+
+  data->node = node;
+
+  luaL_getmetatable(L, "gr.node");
+  lua_setmetatable(L, -2);
+
+  return 1;
+}
+
+// Create a node holding many instances of a node, one per 4x4 matrix in
+// a flat list of row major matrices, as a table or a string of packed
+// 32 bit floats. Replaces a gr.node, transformations and add_child per
+// instance.
+extern "C"
+int gr_instances_cmd(lua_State* L)
+{
+  GRLUA_DEBUG_CALL;
+
+  gr_node_ud* data = (gr_node_ud*)lua_newuserdata(L, sizeof(gr_node_ud));
+  data->node = 0;
+
+  const char* name = luaL_checkstring(L, 1);
+
+  gr_node_ud* childdata = (gr_node_ud*)luaL_checkudata(L, 2, "gr.node");
+  luaL_argcheck(L, childdata != 0, 2, "Node expected");
+
+  SceneNode* child = childdata->node;
+
+  std::vector<double> matrices;
+  get_flat<float>(L, 3, 16, &matrices);
+
+  // Every matrix is checked before child gets any new parents
+  std::vector<SceneNode*> instances;
+
+  for (size_t i = 0; i < matrices.size(); i += 16) {
+    SceneNode* instance = new SceneNode(name);
+    instances.push_back(instance);
+
+    if (!instance->transform(Matrix4x4(&matrices[i]))) {
+      for (size_t j = 0; j < instances.size(); j++) {
+        delete instances[j];
+      }
+
+      lua_pushfstring(L, "Matrix %d is singular", (int)(i / 16) + 1);
+      return luaL_argerror(L, 3, lua_tostring(L, -1));
+    }
+  }
+
+  SceneNode* node = new SceneNode(name);
+
+  for (size_t i = 0; i < instances.size(); i++) {
+    SceneNode* instance = instances[i];
+    instance->m_num_parents += 1;
+
+    instance->add_child(child);
+    child->m_num_parents += 1;
+
+    node->add_child(instance);
+  }
+
+  data->node = node;
+
+  luaL_getmetatable(L, "gr.node");
+  lua_setmetatable(L, -2);
+
+  return 1;
+}
+
 // Create a tetris node
 extern "C"
 int gr_tetris_cmd(lua_State* L)
@@ -349,54 +593,193 @@ int gr_light_cmd(lua_State* L)
   return 1;
 }
 
-// Render a scene
+// Set the rays across and down each camera packet, or "auto" to time a
+// few sizes once rendering starts and use the fastest
 extern "C"
-int gr_render_cmd(lua_State* L)
+int gr_packet_size_cmd(lua_State* L)
 {
   GRLUA_DEBUG_CALL;
-  
+
+  if (lua_type(L, 1) == LUA_TSTRING) {
+    const char* mode = lua_tostring(L, 1);
+    luaL_argcheck(L, strcmp(mode, "auto") == 0, 1, "Packet size or \"auto\" expected");
+
+    AUTOTUNE = true;
+    return 0;
+  }
+
+  int width = luaL_checknumber(L, 1);
+  int height = lua_isnoneornil(L, 2) ? width : luaL_checknumber(L, 2);
+
+  luaL_argcheck(L, CameraPacket::setPacketSize(width, height), 1,
+                "Packet sides must be between 1 and 16 rays");
+
+  AUTOTUNE = false;
+  return 0;
+}
+
+// Set the zlib level of saved PNGs from 0 (fastest) to 9 (smallest),
+// and optionally the row filter ("none", "sub", "up", "average", "paeth"
+// or "adaptive") and how many threads encode them
+extern "C"
+int gr_png_compression_cmd(lua_State* L)
+{
+  GRLUA_DEBUG_CALL;
+
+  int level = luaL_checknumber(L, 1);
+
+  PngWriter::Filter filter = PngWriter::getFilter();
+  if (!lua_isnoneornil(L, 2)) {
+    luaL_argcheck(L, PngWriter::parseFilter(luaL_checkstring(L, 2), &filter), 2,
+                  "Unknown PNG filter");
+  }
+
+  int threads = lua_isnoneornil(L, 3) ? PngWriter::getThreads() : luaL_checknumber(L, 3);
+
+  luaL_argcheck(L, PngWriter::setCompression(level, filter, threads), 1,
+                "Level must be between 0 and 9, threads between 1 and 64");
+
+  return 0;
+}
+
+// What gr.render and gr.animate take before their own arguments
+struct RenderArgs {
+  SceneNode* root;
+  const char* filename;
+  int width;
+  int height;
+  Point3D eye;
+  Vector3D view;
+  Vector3D up;
+  double fov;
+  Colour ambient;
+  std::list<Light*> lights;
+};
+
+static void get_render_args(lua_State* L, RenderArgs* args)
+{
   gr_node_ud* root = (gr_node_ud*)luaL_checkudata(L, 1, "gr.node");
   luaL_argcheck(L, root != 0, 1, "Root node expected");
+  args->root = root->node;
 
-  const char* filename = luaL_checkstring(L, 2);
+  args->filename = luaL_checkstring(L, 2);
 
-  int width = luaL_checknumber(L, 3);
-  int height = luaL_checknumber(L, 4);
+  args->width = luaL_checknumber(L, 3);
+  args->height = luaL_checknumber(L, 4);
 
-  Point3D eye;
-  Vector3D view, up;
-  
-  get_tuple(L, 5, &eye[0], 3);
-  get_tuple(L, 6, &view[0], 3);
-  get_tuple(L, 7, &up[0], 3);
+  get_tuple(L, 5, &args->eye[0], 3);
+  get_tuple(L, 6, &args->view[0], 3);
+  get_tuple(L, 7, &args->up[0], 3);
 
-  double fov = luaL_checknumber(L, 8);
+  args->fov = luaL_checknumber(L, 8);
 
   double ambient_data[3];
   get_tuple(L, 9, ambient_data, 3);
-  Colour ambient(ambient_data[0], ambient_data[1], ambient_data[2]);
+  args->ambient = Colour(ambient_data[0], ambient_data[1], ambient_data[2]);
 
   luaL_checktype(L, 10, LUA_TTABLE);
   int light_count = luaL_getn(L, 10);
   
   luaL_argcheck(L, light_count >= 1, 10, "Tuple of lights expected");
-  std::list<Light*> lights;
   for (int i = 1; i <= light_count; i++) {
     lua_rawgeti(L, 10, i);
     gr_light_ud* ldata = (gr_light_ud*)luaL_checkudata(L, -1, "gr.light");
     luaL_argcheck(L, ldata != 0, 10, "Light expected");
 
-    lights.push_back(ldata->light);
+    args->lights.push_back(ldata->light);
     lua_pop(L, 1);
   }
+}
+
+// Time spent in gr.render and gr.animate during the current script, to
+// tell apart from the time spent building the scene
+static long long s_render_nsecs = 0;
+
+// Render a scene
+extern "C"
+int gr_render_cmd(lua_State* L)
+{
+  GRLUA_DEBUG_CALL;
+  
+  RenderArgs args;
+  get_render_args(L, &args);
 
-  launch_qt(root->node, filename, width, height,
-            eye, view, up, fov,
-            ambient, lights);
+  QElapsedTimer timer;
+  timer.start();
+
+  RENDER(args.root, args.filename, args.width, args.height,
+         args.eye, args.view, args.up, args.fov,
+         args.ambient, args.lights);
+
+  s_render_nsecs += timer.nsecsElapsed();
   
   return 0;
 }
 
+// Where gr.animate leaves its update function on the stack
+#define ANIMATE_UPDATE_ARG 12
+
+// gr.animate's optional samples per pixel along each axis
+#define ANIMATE_SAMPLES_ARG 13
+
+// Calls the update function given to gr.animate with the frame number
+static bool call_update(int frame, void* data)
+{
+  lua_State* L = (lua_State*)data;
+
+  lua_pushvalue(L, ANIMATE_UPDATE_ARG);
+  lua_pushnumber(L, frame);
+
+  if (lua_pcall(L, 1, 0, 0)) {
+    std::cerr << "Error updating frame " << frame << ": " << lua_tostring(L, -1) << std::endl;
+    lua_pop(L, 1);
+    return false;
+  }
+
+  return true;
+}
+
+// Render frames 1 to n of a scene without a window. Takes the arguments
+// of gr.render, with a file name holding one %d for the frame number,
+// then n, optionally a function called with each frame number before
+// that frame is rendered, which may move nodes of the scene, and
+// optionally the samples per pixel along each axis, 1 by default
+extern "C"
+int gr_animate_cmd(lua_State* L)
+{
+  GRLUA_DEBUG_CALL;
+
+  RenderArgs args;
+  get_render_args(L, &args);
+
+  luaL_argcheck(L, Animation::checkPattern(args.filename), 2,
+                "File name with one %d for the frame number expected");
+
+  int frames = luaL_checknumber(L, 11);
+  luaL_argcheck(L, frames >= 1, 11, "Number of frames expected");
+
+  bool has_update = !lua_isnoneornil(L, ANIMATE_UPDATE_ARG);
+  if (has_update) {
+    luaL_checktype(L, ANIMATE_UPDATE_ARG, LUA_TFUNCTION);
+  }
+
+  int samples = lua_isnoneornil(L, ANIMATE_SAMPLES_ARG) ? 1 : luaL_checknumber(L, ANIMATE_SAMPLES_ARG);
+  luaL_argcheck(L, samples >= 1, ANIMATE_SAMPLES_ARG, "Samples per pixel expected");
+
+  Camera cam(args.width, args.height, args.eye, args.view, args.up, args.fov);
+  Animation animation(args.root, cam, args.ambient, &args.lights, args.filename, samples);
+
+  QElapsedTimer timer;
+  timer.start();
+
+  bool ok = animation.render(frames, has_update ? call_update : NULL, L);
+
+  s_render_nsecs += timer.nsecsElapsed();
+
+  lua_pushboolean(L, ok);
+  return 1;
+}
+
 // Create a material
 extern "C"
 int gr_material_cmd(lua_State* L)
@@ -667,7 +1050,14 @@ static const luaL_reg grlib_functions[] = {
   {"tetris", gr_tetris_cmd},
   {"light", gr_light_cmd},
   {"render", gr_render_cmd},
+  {"animate", gr_animate_cmd},
+  {"packet_size", gr_packet_size_cmd},
+  {"png_compression", gr_png_compression_cmd},
   {"mesh", gr_mesh_cmd},
+  {"obj_mesh", gr_obj_mesh_cmd},
+  {"flat_mesh", gr_flat_mesh_cmd},
+  {"nh_spheres", gr_nh_spheres_cmd},
+  {"instances", gr_instances_cmd},
   {0, 0}
 };
 
@@ -726,11 +1116,30 @@ bool run_lua(const std::string& filename)
   luaL_openlib(L, "gr", grlib_functions, 0);
 
   GRLUA_DEBUG("Parsing the scene");
-  // Now parse the actual scene
-  if (luaL_loadfile(L, filename.c_str()) || lua_pcall(L, 0, 0, 0)) {
+  // Now parse the actual scene, timing the parse, the rest of the script
+  // and the renders it starts apart
+  QElapsedTimer timer;
+  timer.start();
+
+  s_render_nsecs = 0;
+
+  int error = luaL_loadfile(L, filename.c_str());
+  long long parse_nsecs = timer.nsecsElapsed();
+
+  if (!error) {
+    error = lua_pcall(L, 0, 0, 0);
+  }
+
+  if (error) {
     std::cerr << "Error loading " << filename << ": " << lua_tostring(L, -1) << std::endl;
     return false;
   }
+
+  long long build_nsecs = timer.nsecsElapsed() - parse_nsecs - s_render_nsecs;
+
+  std::cout << "Scene " << filename << ": parse " << parse_nsecs / 1000000
+            << " ms, build " << build_nsecs / 1000000 << " ms, render "
+            << s_render_nsecs / 1000000 << " ms" << std::endl;
   GRLUA_DEBUG("Closing the interpreter");
   
   // Close the interpreter, free up any resources not needed
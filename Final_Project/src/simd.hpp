@@ -0,0 +1,121 @@
+#ifndef CS488_SIMD_HPP
+#define CS488_SIMD_HPP
+
+#include <math.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// A few doubles worked on together: two in an SSE2 register, or just
+// one without SSE2, so code written against SimdDouble builds either way.
+// Comparisons give a SimdMask that is set in the lanes where they hold.
+
+#ifdef __SSE2__
+
+struct SimdMask {
+    SimdMask(__m128d mask) : v(mask) {}
+
+    bool any() const { return _mm_movemask_pd(v) != 0; }
+    bool all() const { return _mm_movemask_pd(v) == 3; }
+    bool get(int lane) const { return (_mm_movemask_pd(v) >> lane) & 1; }
+
+    // One bit per lane, lane 0 lowest
+    unsigned int bits() const { return _mm_movemask_pd(v); }
+
+    __m128d v;
+};
+
+struct SimdDouble {
+    static const int WIDTH = 2;
+
+    SimdDouble() {}
+    SimdDouble(double d) : v(_mm_set1_pd(d)) {}
+    SimdDouble(__m128d d) : v(d) {}
+
+    static SimdDouble load(const double* src) { return _mm_loadu_pd(src); }
+    void store(double* dest) const { _mm_storeu_pd(dest, v); }
+
+    __m128d v;
+};
+
+inline SimdDouble operator+(SimdDouble a, SimdDouble b) { return _mm_add_pd(a.v, b.v); }
+inline SimdDouble operator-(SimdDouble a, SimdDouble b) { return _mm_sub_pd(a.v, b.v); }
+inline SimdDouble operator*(SimdDouble a, SimdDouble b) { return _mm_mul_pd(a.v, b.v); }
+inline SimdDouble operator/(SimdDouble a, SimdDouble b) { return _mm_div_pd(a.v, b.v); }
+inline SimdDouble operator-(SimdDouble a) { return _mm_sub_pd(_mm_setzero_pd(), a.v); }
+
+inline SimdMask operator<(SimdDouble a, SimdDouble b) { return _mm_cmplt_pd(a.v, b.v); }
+inline SimdMask operator>(SimdDouble a, SimdDouble b) { return _mm_cmpgt_pd(a.v, b.v); }
+inline SimdMask operator<=(SimdDouble a, SimdDouble b) { return _mm_cmple_pd(a.v, b.v); }
+inline SimdMask operator>=(SimdDouble a, SimdDouble b) { return _mm_cmpge_pd(a.v, b.v); }
+inline SimdMask operator==(SimdDouble a, SimdDouble b) { return _mm_cmpeq_pd(a.v, b.v); }
+
+inline SimdMask operator&(SimdMask a, SimdMask b) { return _mm_and_pd(a.v, b.v); }
+inline SimdMask operator|(SimdMask a, SimdMask b) { return _mm_or_pd(a.v, b.v); }
+inline SimdMask operator!(SimdMask a) { return _mm_xor_pd(a.v, _mm_castsi128_pd(_mm_set1_epi32(-1))); }
+
+inline SimdDouble simdSqrt(SimdDouble a) { return _mm_sqrt_pd(a.v); }
+inline SimdDouble simdMin(SimdDouble a, SimdDouble b) { return _mm_min_pd(a.v, b.v); }
+inline SimdDouble simdMax(SimdDouble a, SimdDouble b) { return _mm_max_pd(a.v, b.v); }
+inline SimdDouble simdAbs(SimdDouble a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a.v); }
+
+// a where mask is set, b elsewhere
+inline SimdDouble simdSelect(SimdMask mask, SimdDouble a, SimdDouble b) {
+    return _mm_or_pd(_mm_and_pd(mask.v, a.v), _mm_andnot_pd(mask.v, b.v));
+}
+
+#else
+
+struct SimdMask {
+    SimdMask(bool mask) : v(mask) {}
+
+    bool any() const { return v; }
+    bool all() const { return v; }
+    bool get(int lane) const { (void)lane; return v; }
+
+    unsigned int bits() const { return v ? 1 : 0; }
+
+    bool v;
+};
+
+struct SimdDouble {
+    static const int WIDTH = 1;
+
+    SimdDouble() {}
+    SimdDouble(double d) : v(d) {}
+
+    static SimdDouble load(const double* src) { return *src; }
+    void store(double* dest) const { *dest = v; }
+
+    double v;
+};
+
+inline SimdDouble operator+(SimdDouble a, SimdDouble b) { return a.v + b.v; }
+inline SimdDouble operator-(SimdDouble a, SimdDouble b) { return a.v - b.v; }
+inline SimdDouble operator*(SimdDouble a, SimdDouble b) { return a.v * b.v; }
+inline SimdDouble operator/(SimdDouble a, SimdDouble b) { return a.v / b.v; }
+inline SimdDouble operator-(SimdDouble a) { return -a.v; }
+
+inline SimdMask operator<(SimdDouble a, SimdDouble b) { return a.v < b.v; }
+inline SimdMask operator>(SimdDouble a, SimdDouble b) { return a.v > b.v; }
+inline SimdMask operator<=(SimdDouble a, SimdDouble b) { return a.v <= b.v; }
+inline SimdMask operator>=(SimdDouble a, SimdDouble b) { return a.v >= b.v; }
+inline SimdMask operator==(SimdDouble a, SimdDouble b) { return a.v == b.v; }
+
+inline SimdMask operator&(SimdMask a, SimdMask b) { return a.v && b.v; }
+inline SimdMask operator|(SimdMask a, SimdMask b) { return a.v || b.v; }
+inline SimdMask operator!(SimdMask a) { return !a.v; }
+
+inline SimdDouble simdSqrt(SimdDouble a) { return sqrt(a.v); }
+inline SimdDouble simdMin(SimdDouble a, SimdDouble b) { return a.v < b.v ? a.v : b.v; }
+inline SimdDouble simdMax(SimdDouble a, SimdDouble b) { return a.v > b.v ? a.v : b.v; }
+inline SimdDouble simdAbs(SimdDouble a) { return fabs(a.v); }
+
+inline SimdDouble simdSelect(SimdMask mask, SimdDouble a, SimdDouble b) {
+    return mask.v ? a : b;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,305 @@
+#include "simdroots.hpp"
+#include "simd.hpp"
+
+#define W SimdDouble::WIDTH
+
+// Root polishing and bracketed Newton stop once a step is this small
+// relative to the root
+#define ROOT_EPSILON 1.0e-14
+#define MAX_ITERATIONS 100
+
+// Loads count values and pads the rest of the lanes, so the tail of an
+// array can go through the same code as the rest
+static SimdDouble loadLanes(const double* src, int count, double pad) {
+    if(count == W) {
+        return SimdDouble::load(src);
+    }
+
+    double lanes[W];
+
+    for(int i = 0; i < W; ++i) {
+        lanes[i] = (i < count) ? src[i] : pad;
+    }
+
+    return SimdDouble::load(lanes);
+}
+
+static void storeLanes(SimdDouble value, double* dest, int count) {
+    if(count == W) {
+        value.store(dest);
+        return;
+    }
+
+    double lanes[W];
+    value.store(lanes);
+
+    for(int i = 0; i < count; ++i) {
+        dest[i] = lanes[i];
+    }
+}
+
+static void storeCounts(SimdDouble value, int* dest, int count) {
+    double lanes[W];
+    value.store(lanes);
+
+    for(int i = 0; i < count; ++i) {
+        dest[i] = (int)lanes[i];
+    }
+}
+
+static SimdDouble sign(SimdDouble a) {
+    return simdSelect(a < SimdDouble(0.0), SimdDouble(-1.0), SimdDouble(1.0));
+}
+
+// ************************** Quadratic ******************************
+
+// Same method as quadraticRoots, including A == 0. Both roots are
+// written in every lane; count says how many are real.
+static void quadratic(SimdDouble A, SimdDouble B, SimdDouble C,
+        SimdDouble* r0, SimdDouble* r1, SimdDouble* count)
+{
+    SimdDouble zero(0.0);
+
+    SimdDouble D = B*B - SimdDouble(4.0)*A*C;
+    SimdDouble q = -(B + sign(B)*simdSqrt(simdMax(D, zero))) * SimdDouble(0.5);
+
+    SimdMask linear = A == zero;
+    SimdMask constant = linear & (B == zero);
+
+    *r0 = simdSelect(linear, -C / B, q / A);
+    *r1 = simdSelect(q == zero, *r0, C / q);
+
+    *count = simdSelect(D < zero, zero, SimdDouble(2.0));
+    *count = simdSelect(linear, SimdDouble(1.0), *count);
+    *count = simdSelect(constant, zero, *count);
+}
+
+void solveQuadratics(int n, const double* A, const double* B, const double* C,
+        double* roots, int* numRoots)
+{
+    for(int i = 0; i < n; i += W) {
+        int m = (n - i < W) ? n - i : W;
+
+        SimdDouble r0, r1, count;
+        quadratic(loadLanes(A + i, m, 1.0), loadLanes(B + i, m, 0.0), loadLanes(C + i, m, 1.0),
+                &r0, &r1, &count);
+
+        storeLanes(r0, roots + i, m);
+        storeLanes(r1, roots + n + i, m);
+        storeCounts(count, numRoots + i, m);
+    }
+}
+
+// ************************** Newton ******************************
+
+// x^3 + a x^2 + b x + c and its derivative
+static void evalCubic(SimdDouble a, SimdDouble b, SimdDouble c, SimdDouble x,
+        SimdDouble* f, SimdDouble* df)
+{
+    *f = ((x + a)*x + b)*x + c;
+    *df = (SimdDouble(3.0)*x + SimdDouble(2.0)*a)*x + b;
+}
+
+// x^4 + a x^3 + b x^2 + c x + d and its derivative
+static void evalQuartic(SimdDouble a, SimdDouble b, SimdDouble c, SimdDouble d, SimdDouble x,
+        SimdDouble* f, SimdDouble* df)
+{
+    *f = (((x + a)*x + b)*x + c)*x + d;
+    *df = ((SimdDouble(4.0)*x + SimdDouble(3.0)*a)*x + SimdDouble(2.0)*b)*x + c;
+}
+
+// A root of the monic cubic in [lo, hi], given f(lo) <= 0 < f(hi).
+// Newton steps that leave the bracket are replaced by bisection, so
+// every lane converges without transcendental functions.
+static SimdDouble bracketedCubicRoot(SimdDouble a, SimdDouble b, SimdDouble c,
+        SimdDouble lo, SimdDouble hi)
+{
+    SimdDouble x = hi;
+
+    for(int i = 0; i < MAX_ITERATIONS; ++i) {
+        SimdDouble f, df;
+        evalCubic(a, b, c, x, &f, &df);
+
+        SimdMask below = f < SimdDouble(0.0);
+        lo = simdSelect(below, x, lo);
+        hi = simdSelect(below, hi, x);
+
+        SimdDouble newton = x - f / df;
+        SimdMask inside = (newton > lo) & (newton < hi);
+
+        SimdDouble next = simdSelect(inside, newton, SimdDouble(0.5)*(lo + hi));
+        SimdMask done = (f == SimdDouble(0.0)) |
+            (simdAbs(next - x) <= SimdDouble(ROOT_EPSILON)*simdMax(SimdDouble(1.0), simdAbs(next)));
+
+        x = simdSelect(f == SimdDouble(0.0), x, next);
+
+        if(done.all()) {
+            break;
+        }
+    }
+
+    return x;
+}
+
+// Two Newton steps on the original polynomial, like PolishRoot. Steps
+// that don't reduce the residual are dropped.
+static SimdDouble polishCubic(SimdDouble a, SimdDouble b, SimdDouble c, SimdDouble x) {
+    for(int i = 0; i < 2; ++i) {
+        SimdDouble f, df, fn, dfn;
+        evalCubic(a, b, c, x, &f, &df);
+
+        SimdDouble next = x - f / df;
+        evalCubic(a, b, c, next, &fn, &dfn);
+
+        x = simdSelect(simdAbs(fn) < simdAbs(f), next, x);
+    }
+
+    return x;
+}
+
+static SimdDouble polishQuartic(SimdDouble a, SimdDouble b, SimdDouble c, SimdDouble d, SimdDouble x) {
+    for(int i = 0; i < 2; ++i) {
+        SimdDouble f, df, fn, dfn;
+        evalQuartic(a, b, c, d, x, &f, &df);
+
+        SimdDouble next = x - f / df;
+        evalQuartic(a, b, c, d, next, &fn, &dfn);
+
+        x = simdSelect(simdAbs(fn) < simdAbs(f), next, x);
+    }
+
+    return x;
+}
+
+// 1 + the largest magnitude coefficient bounds every root of a monic
+// polynomial
+static SimdDouble rootBound(SimdDouble a, SimdDouble b, SimdDouble c) {
+    return SimdDouble(1.0) + simdMax(simdAbs(a), simdMax(simdAbs(b), simdAbs(c)));
+}
+
+// ************************** Cubic ******************************
+
+// One real root is found by bracketed Newton, and the other two come
+// from the quadratic left after dividing it out
+static void cubic(SimdDouble a, SimdDouble b, SimdDouble c,
+        SimdDouble* r0, SimdDouble* r1, SimdDouble* r2, SimdDouble* count)
+{
+    SimdDouble bound = rootBound(a, b, c);
+    SimdDouble x = bracketedCubicRoot(a, b, c, -bound, bound);
+
+    SimdDouble qb = a + x;
+    SimdDouble qc = b + qb*x;
+
+    SimdDouble q0, q1, qcount;
+    quadratic(SimdDouble(1.0), qb, qc, &q0, &q1, &qcount);
+
+    *r0 = x;
+    *r1 = polishCubic(a, b, c, q0);
+    *r2 = polishCubic(a, b, c, q1);
+    *count = SimdDouble(1.0) + qcount;
+}
+
+void solveCubics(int n, const double* A, const double* B, const double* C,
+        double* roots, int* numRoots)
+{
+    for(int i = 0; i < n; i += W) {
+        int m = (n - i < W) ? n - i : W;
+
+        SimdDouble r0, r1, r2, count;
+        // Padding lanes solve x^3 - x
+        cubic(loadLanes(A + i, m, 0.0), loadLanes(B + i, m, -1.0), loadLanes(C + i, m, 0.0),
+                &r0, &r1, &r2, &count);
+
+        storeLanes(r0, roots + i, m);
+        storeLanes(r1, roots + n + i, m);
+        storeLanes(r2, roots + 2*n + i, m);
+        storeCounts(count, numRoots + i, m);
+    }
+}
+
+// ************************** Quartic ******************************
+
+// Ferrari's method. The quartic is shifted to y^4 + p y^2 + q y + r and
+// split into two quadratics using a root m > 0 of the resolvent cubic
+// m^3 + p m^2 + (p^2/4 - r) m - q^2/8. The resolvent is negative at 0
+// and positive past its root bound, so bracketed Newton always finds m.
+// When q vanishes the quartic is a quadratic in y^2 instead.
+static void quartic(SimdDouble a, SimdDouble b, SimdDouble c, SimdDouble d,
+        SimdDouble* roots, SimdDouble* count)
+{
+    SimdDouble zero(0.0);
+    SimdDouble half(0.5);
+
+    SimdDouble a2 = a*a;
+    SimdDouble shift = SimdDouble(0.25)*a;
+
+    SimdDouble p = b - SimdDouble(3.0/8.0)*a2;
+    SimdDouble q = c - half*a*b + SimdDouble(1.0/8.0)*a2*a;
+    SimdDouble r = d - SimdDouble(0.25)*a*c + SimdDouble(1.0/16.0)*a2*b - SimdDouble(3.0/256.0)*a2*a2;
+
+    SimdDouble rb = p;
+    SimdDouble rc = SimdDouble(0.25)*p*p - r;
+    SimdDouble rd = SimdDouble(-1.0/8.0)*q*q;
+
+    SimdDouble m = bracketedCubicRoot(rb, rc, rd, zero, rootBound(rb, rc, rd));
+    SimdDouble s = simdSqrt(simdMax(SimdDouble(2.0)*m, zero));
+
+    SimdMask biquadratic = s <= SimdDouble(1.0e-12)*simdMax(SimdDouble(1.0), simdAbs(p));
+
+    // y^2 - s y + (p/2 + m + q/2s) and y^2 + s y + (p/2 + m - q/2s)
+    SimdDouble base = half*p + m;
+    SimdDouble offset = half*q / simdSelect(biquadratic, SimdDouble(1.0), s);
+
+    SimdDouble b1 = -s;
+    SimdDouble c1 = base + offset;
+    SimdDouble b2 = s;
+    SimdDouble c2 = base - offset;
+
+    // y^2 = -p/2 -+ sqrt(p^2/4 - r). Without real y^2 there are no roots,
+    // which y^2 + 1 = 0 stands in for.
+    SimdDouble disc = SimdDouble(0.25)*p*p - r;
+    SimdDouble root = simdSqrt(simdMax(disc, zero));
+    SimdMask real = disc >= zero;
+
+    b1 = simdSelect(biquadratic, zero, b1);
+    b2 = simdSelect(biquadratic, zero, b2);
+    c1 = simdSelect(biquadratic, simdSelect(real, half*p + root, SimdDouble(1.0)), c1);
+    c2 = simdSelect(biquadratic, simdSelect(real, half*p - root, SimdDouble(1.0)), c2);
+
+    SimdDouble y[4], n1, n2;
+    quadratic(SimdDouble(1.0), b1, c1, &y[0], &y[1], &n1);
+    quadratic(SimdDouble(1.0), b2, c2, &y[2], &y[3], &n2);
+
+    for(int i = 0; i < 4; ++i) {
+        y[i] = polishQuartic(a, b, c, d, y[i] - shift);
+    }
+
+    // Move the second pair forward when the first has no roots
+    SimdMask first = n1 > zero;
+
+    roots[0] = simdSelect(first, y[0], y[2]);
+    roots[1] = simdSelect(first, y[1], y[3]);
+    roots[2] = y[2];
+    roots[3] = y[3];
+
+    *count = n1 + n2;
+}
+
+void solveQuartics(int n, const double* A, const double* B, const double* C, const double* D,
+        double* roots, int* numRoots)
+{
+    for(int i = 0; i < n; i += W) {
+        int m = (n - i < W) ? n - i : W;
+
+        SimdDouble r[4], count;
+        // Padding lanes solve (x^2 - 1)(x^2 - 4)
+        quartic(loadLanes(A + i, m, 0.0), loadLanes(B + i, m, -5.0), loadLanes(C + i, m, 0.0),
+                loadLanes(D + i, m, 4.0), r, &count);
+
+        for(int k = 0; k < 4; ++k) {
+            storeLanes(r[k], roots + k*n + i, m);
+        }
+
+        storeCounts(count, numRoots + i, m);
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef CS488_SIMDROOTS_HPP
+#define CS488_SIMDROOTS_HPP
+
+// Lane parallel versions of the solvers in polyroots.hpp. Each call solves
+// n polynomials at once, SimdDouble::WIDTH at a time. Coefficient i of
+// every argument belongs to polynomial i. Root k of polynomial i is
+// written to roots[k*n + i], and numRoots[i] of them are real. Roots are
+// not sorted.
+
+// A x^2 + B x + C. roots holds 2n values.
+void solveQuadratics(int n, const double* A, const double* B, const double* C,
+        double* roots, int* numRoots);
+
+// x^3 + A x^2 + B x + C, as in cubicRoots. roots holds 3n values.
+void solveCubics(int n, const double* A, const double* B, const double* C,
+        double* roots, int* numRoots);
+
+// x^4 + A x^3 + B x^2 + C x + D, as in quarticRoots. roots holds 4n values.
+void solveQuartics(int n, const double* A, const double* B, const double* C, const double* D,
+        double* roots, int* numRoots);
+
+#endif
@@ -0,0 +1,93 @@
+#include "tracejob.hpp"
+
+#include <algorithm>
+#include <QElapsedTimer>
+
+using std::vector;
+
+TraceJob::TraceJob(vector<CameraPacket*>* packets, int numThreads, PacketFunction done, void* data) :
+    m_packets(packets), m_done(done), m_data(data), m_threads(std::max(1, numThreads)),
+    m_running(false), m_next(0), m_nextThread(0), m_traced(0)
+{
+    pthread_mutex_init(&m_mutex, NULL);
+}
+
+TraceJob::~TraceJob() {
+    finish();
+    pthread_mutex_destroy(&m_mutex);
+}
+
+void TraceJob::start() {
+    if(m_running) {
+        return;
+    }
+
+    m_next = 0;
+    m_nextThread = 0;
+    m_traced = 0;
+    m_running = true;
+
+    for(size_t t = 0; t < m_threads.size(); ++t) {
+        pthread_create(&m_threads[t], NULL, thread_bootstrap, this);
+    }
+}
+
+long TraceJob::finish() {
+    if(m_running) {
+        for(size_t t = 0; t < m_threads.size(); ++t) {
+            pthread_join(m_threads[t], NULL);
+        }
+
+        m_running = false;
+    }
+
+    return m_traced;
+}
+
+long TraceJob::run(vector<CameraPacket*>* packets, int numThreads, PacketFunction done, void* data) {
+    TraceJob job(packets, numThreads, done, data);
+
+    job.start();
+    return job.finish();
+}
+
+void* TraceJob::thread_bootstrap(void* job) {
+    ((TraceJob*)job)->traceThread();
+    return NULL;
+}
+
+void TraceJob::traceThread() {
+    int numPackets = m_packets->size();
+    long traced = 0;
+
+    pthread_mutex_lock(&m_mutex);
+    int thread = m_nextThread++;
+    pthread_mutex_unlock(&m_mutex);
+
+    while(true) {
+        pthread_mutex_lock(&m_mutex);
+        int index = m_next++;
+        pthread_mutex_unlock(&m_mutex);
+
+        if(index >= numPackets) {
+            break;
+        }
+
+        // Packets are only timed for someone who asked
+        if(m_done != NULL) {
+            QElapsedTimer timer;
+            timer.start();
+
+            int rays = m_packets->at(index)->trace();
+
+            m_done(index, thread, timer.nsecsElapsed(), rays, m_data);
+            traced += rays;
+        } else {
+            traced += m_packets->at(index)->trace();
+        }
+    }
+
+    pthread_mutex_lock(&m_mutex);
+    m_traced += traced;
+    pthread_mutex_unlock(&m_mutex);
+}
@@ -0,0 +1,58 @@
+#ifndef CS488_TRACEJOB_HPP
+#define CS488_TRACEJOB_HPP
+
+#include <vector>
+#include <pthread.h>
+
+#include "packet.hpp"
+
+// Traces a set of camera packets on several threads. Each thread takes
+// the next packet nobody has taken until none are left, so a thread
+// that draws cheap packets traces more of them.
+class TraceJob {
+public:
+    // Called on the tracing thread after each packet, with the packet's
+    // index, the thread's number from 0, the time the packet took and
+    // the camera rays it traced
+    typedef void (*PacketFunction)(int index, int thread, long long nsecs, int rays, void* data);
+
+    TraceJob(std::vector<CameraPacket*>* packets, int numThreads,
+            PacketFunction done = NULL, void* data = NULL);
+
+    // Waits for the threads if the job was started and not finished
+    ~TraceJob();
+
+    // Starts the threads and returns, so the caller can do other work
+    // while the packets are traced
+    void start();
+
+    // Waits until every packet is traced. Returns the camera rays traced.
+    long finish();
+
+    // Traces every packet before returning
+    static long run(std::vector<CameraPacket*>* packets, int numThreads,
+            PacketFunction done = NULL, void* data = NULL);
+
+private:
+    TraceJob(const TraceJob& other);
+    TraceJob& operator=(const TraceJob& other);
+
+    static void* thread_bootstrap(void* job);
+    void traceThread();
+
+    std::vector<CameraPacket*>* m_packets;
+
+    PacketFunction m_done;
+    void* m_data;
+
+    std::vector<pthread_t> m_threads;
+    bool m_running;
+
+    // Guards the packet and thread counters and the total
+    pthread_mutex_t m_mutex;
+    int m_next;
+    int m_nextThread;
+    long m_traced;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "tracer.hpp"
 #include "material.hpp"
+#include "perfcounters.hpp"
 
 #include <iostream>
 #include <assert.h>
@@ -12,27 +13,22 @@ using std::vector;
 #define MAX_DEPTH 5
 #define REFLECTION_ATTENUATION 0.5
 
-static Primitive** unpackPrimitives(vector<Primitive*>* primitives) {
-    Primitive** primArray = new Primitive* [primitives->size()];
-    for(uint i = 0; i < primitives->size(); i++) {
-        primArray[i] = primitives->at(i);
-    }
-
-    return primArray;
-}
-
 Tracer::Tracer(std::vector<Primitive*>* primitives, const Colour& ambient, const std::list<Light*>* lights) :
-    m_primitives(primitives), m_ambient(ambient), m_lights(lights) 
+    m_primitives(primitives), m_ambient(ambient), m_lights(lights), m_maxDepth(MAX_DEPTH)
 {
     if(BIH) { 
-        Primitive** primArray = unpackPrimitives(primitives);
-        m_bih = new BIHTree(primArray, primitives->size());
+        PerfPhase phase(PerfCounters::build);
+        m_bih = new BIHTree(primitives);
     } else {
         m_bih = NULL;
     }
 
 }
 
+Tracer::~Tracer() {
+    delete m_bih;
+}
+
 void Tracer::updatePrimitives(vector<Primitive*>* primitives) {
     m_primitives = primitives;
     
@@ -41,8 +37,8 @@ void Tracer::updatePrimitives(vector<Primitive*>* primitives) {
             delete m_bih;
         }
 
-        Primitive** primArray = unpackPrimitives(primitives);
-        m_bih = new BIHTree(primArray, primitives->size());
+        PerfPhase phase(PerfCounters::build);
+        m_bih = new BIHTree(primitives);
     }
 }
 
@@ -61,7 +57,7 @@ bool Tracer::getIntersection(const Ray& ray, Intersection* isect) {
 
         if(isect != NULL && hit) {
             hitAny = true;
-            testRay = Ray(testRay.getOrigin(), best->getPoint());
+            testRay = testRay.shorten(best->getPoint());
         
         } else if(hit) {
             return true;
@@ -80,27 +76,28 @@ bool Tracer::getIntersection(const Ray& ray, Intersection* isect) {
 
 Colour Tracer::castShadowRays(const Ray& ray, Intersection* isect) {
     Colour colour = Colour(0.0, 0.0, 0.0);
-    Material* material = isect->getPrimitive()->getMaterial();
+    const ShadingRecord& shading = isect->getShading();
 
     for(auto it = m_lights->begin(); it != m_lights->end(); it++) {
         Point3D origin = isect->getPoint();
         Ray shadowRay = Ray(origin, (*it)->position);
 
         if(!getIntersection(shadowRay, NULL)) {
-            colour += material->getColour(shadowRay.getDirection(), -ray.getDirection(), isect, *(*it));
+            colour += PhongMaterial::getLighting(shadowRay.getDirection(), -ray.getDirection(), 
+                    shading, origin, *(*it));
         }
     } 
 
     return colour;
 }
 
-Colour Tracer::castReflectionRay(const Ray& ray, Intersection* isect, int depth) {
-    if(depth > MAX_DEPTH) {
+Colour Tracer::castReflectionRay(const Ray& ray, Intersection* isect, int depth, MirrorPath* path) {
+    if(depth > m_maxDepth) {
         return Colour(0.0, 0.0, 0.0);
     }
 
     Vector3D dir = -ray.getDirection();
-    Vector3D norm = isect->getNormal();
+    Vector3D norm = isect->getShading().normal;
 
     if(norm.dot(dir) < 0) {
         norm = -norm;
@@ -109,18 +106,22 @@ Colour Tracer::castReflectionRay(const Ray& ray, Intersection* isect, int depth)
     Vector3D refl = 2 * norm.dot(dir) * norm - dir;
 
     Ray reflected = Ray(isect->getPoint(), refl);
+    reflected.setCone(isect->getFootprint(), ray.getConeSpread());
+
     Colour colour(0.0, 0.0, 0.0);
     
-    traceRay(reflected, colour, depth);
+    traceRay(reflected, colour, depth, NULL, path);
 
-    Colour ks = isect->getSpecular();
+    Colour ks = isect->getShading().ks;
     return REFLECTION_ATTENUATION * ks * colour;
 }
 
 // I got the equation for refracted from the Wikipedia entry for Snell's law
 Ray getRefracted(const Ray& ray, Intersection* isect) {
+    const ShadingRecord& shading = isect->getShading();
+
     Vector3D in = ray.getDirection();
-    Vector3D norm = isect->getNormal();
+    Vector3D norm = shading.normal;
 
     double cos_theta1 = -in.dot(norm);
     bool incoming = cos_theta1 >= 0.0;
@@ -130,8 +131,7 @@ Ray getRefracted(const Ray& ray, Intersection* isect) {
         cos_theta1 = -cos_theta1;
     }
 
-    PhongMaterial* material = isect->getPrimitive()->getMaterial();
-    double materialMedium = material->getMedium();
+    double materialMedium = shading.medium;
 
     double mediumRatio;
 
@@ -144,11 +144,14 @@ Ray getRefracted(const Ray& ray, Intersection* isect) {
     double cos_theta2 = sqrt(1 - (mediumRatio * mediumRatio) * (1 - (cos_theta1 * cos_theta1)));
     Vector3D refracted = (mediumRatio * in) + ((mediumRatio * cos_theta1) - cos_theta2) * norm;
 
-    return Ray(isect->getPoint(), refracted);
+    Ray refractedRay(isect->getPoint(), refracted);
+    refractedRay.setCone(isect->getFootprint(), ray.getConeSpread());
+
+    return refractedRay;
 }
 
 Colour Tracer::castRefractionRay(const Ray& ray, Intersection* isect, int depth) {
-    if(depth > MAX_DEPTH) {
+    if(depth > m_maxDepth) {
         return Colour(0.0, 0.0, 0.0);
     }
 
@@ -159,32 +162,54 @@ Colour Tracer::castRefractionRay(const Ray& ray, Intersection* isect, int depth)
     return colour;
 }
 
-bool Tracer::traceRay(Ray& ray, Colour& colour, int depth) {
+bool Tracer::traceRay(Ray& ray, Colour& colour, int depth, Intersection* primary, MirrorPath* path) {
     Intersection* isect = new Intersection();
     bool hit = getIntersection(ray, isect);
 
+    // Only reflected rays are given a path past the camera ray
+    bool bounce = path != NULL && depth > 0;
+
     if(!hit) {
+        if(bounce) {
+            path->escaped = true;
+            path->escapeDir = ray.getDirection();
+        }
+
         delete isect;
         return false;
     }
 
-    PhongMaterial* material = isect->getPrimitive()->getMaterial();
-    double transmitRatio = material->getTransmitRatio();
+    isect->finalize(ray);
+
+    if(bounce) {
+        path->points.push_back(isect->getPoint());
+    }
+
+    if(primary != NULL) {
+        *primary = *isect;
+    }
+
+    const ShadingRecord& shading = isect->getShading();
+    double transmitRatio = shading.transmitRatio;
     double reflectRatio = 1.0 - transmitRatio;
 
     if(reflectRatio > 1.0e-10) {    
-        if(material->isDiffuse()) {
-            colour = reflectRatio * isect->getDiffuse() * m_ambient;
+        if(shading.diffuse) {
+            colour = reflectRatio * shading.albedo * m_ambient;
         }
 
         colour += reflectRatio * castShadowRays(ray, isect);
         
-        if(material->isSpecular()) {
-            colour += reflectRatio * castReflectionRay(ray, isect, depth + 1);
+        if(shading.specular) {
+            colour += reflectRatio * castReflectionRay(ray, isect, depth + 1, path);
         }
     }
 
     if(transmitRatio > 1.0e-10) {
+        if(path != NULL) {
+            path->refracted = true;
+        }
+
         colour += transmitRatio * castRefractionRay(ray, isect, depth + 1);
     }
 
@@ -195,6 +220,8 @@ bool Tracer::traceRay(Ray& ray, Colour& colour, int depth) {
 void Tracer::castShadowRays(const vector<Ray*>* rays, ColourVector* colours, 
         const vector<bool>& v_hit, vector<Intersection>* v_isect)
 {
+    PerfPhase phase(PerfCounters::shadow);
+
     int n = rays->size();
     vector<bool>* l_hits = new vector<bool>(n);
 
@@ -212,6 +239,10 @@ void Tracer::castShadowRays(const vector<Ray*>* rays, ColourVector* colours,
         }
 
         if(j != n) {
+            if(PROFILE) {
+                PerfCounters::addRays(PerfCounters::shadow, n - j);
+            }
+
             Packet packet;
             packet.setRays(shadowRays);
 
@@ -220,13 +251,13 @@ void Tracer::castShadowRays(const vector<Ray*>* rays, ColourVector* colours,
             for(int i = 0; i < n; ++i) {
                 if(v_hit.at(i) && !l_hits->at(i)) {
                     Intersection* isect = &v_isect->at(i);
-                    Material* material = isect->getPrimitive()->getMaterial();
 
                     Colour shadowColour = 
-                        material->getColour(
+                        PhongMaterial::getLighting(
                             -shadowRays->at(i)->getDirection(),
                             -rays->at(i)->getDirection(), 
-                            isect, 
+                            isect->getShading(),
+                            isect->getPoint(),
                             *(*it_light)
                         );
 
@@ -242,12 +273,14 @@ void Tracer::castShadowRays(const vector<Ray*>* rays, ColourVector* colours,
 }
 
 void Tracer::castReflectionRays(const vector<Ray*>* rays, ColourVector* colours, 
-        const vector<bool>& v_hit, vector<Intersection>* v_isect, int depth) 
+        const vector<bool>& v_hit, vector<Intersection>* v_isect, int depth, vector<MirrorPath>* paths) 
 {
-    if(depth > MAX_DEPTH) {
+    if(depth > m_maxDepth) {
         return;
     }
 
+    PerfPhase phase(PerfCounters::reflection);
+
     int n = rays->size();
     vector<bool>* l_hits = new vector<bool>(n);
 
@@ -257,11 +290,11 @@ void Tracer::castReflectionRays(const vector<Ray*>* rays, ColourVector* colours,
     for(int i = 0; i < n; ++i) {
         if(v_hit.at(i)) {
             Intersection* isect = &v_isect->at(i);
-            PhongMaterial* material = v_isect->at(i).getPrimitive()->getMaterial();
+            const ShadingRecord& shading = isect->getShading();
 
-            if(material->isSpecular() && 1 - material->getTransmitRatio() > 1.0e-10) {
+            if(shading.specular && 1 - shading.transmitRatio > 1.0e-10) {
                 Vector3D dir = -rays->at(i)->getDirection();
-                Vector3D norm = isect->getNormal();
+                Vector3D norm = shading.normal;
 
                 if(norm.dot(dir) < 0) {
                     norm = -norm;
@@ -270,6 +303,7 @@ void Tracer::castReflectionRays(const vector<Ray*>* rays, ColourVector* colours,
                 Vector3D refl = 2 * norm.dot(dir) * norm - dir;
 
                 reflectionRays->at(i) = new Ray(isect->getPoint(), refl);
+                reflectionRays->at(i)->setCone(isect->getFootprint(), rays->at(i)->getConeSpread());
                 continue;
             }
         }
@@ -278,15 +312,25 @@ void Tracer::castReflectionRays(const vector<Ray*>* rays, ColourVector* colours,
         j++;
     }
 
-    if(j > (n/2.0)) {
+    // A packet that starts out with too few live lanes is traced one ray
+    // at a time, by the same measure traversal uses to give up on packets
+    // deeper down
+    double minLive = HYBRID ? HYBRID_COHERENCE : 0.5;
+
+    if(PROFILE) {
+        PerfCounters::addRays(PerfCounters::reflection, n - j);
+    }
+
+    if(n - j < minLive * n) {
         for(int i = 0; i < n; i++) {
             Ray* ray = reflectionRays->at(i);
 
             if(ray != NULL) {
-                bool hit = traceRay(*ray, colours->at(i), depth+1);
+                bool hit = traceRay(*ray, colours->at(i), depth+1, NULL,
+                        (paths == NULL) ? NULL : &paths->at(i));
 
                 if(hit) { 
-                    Colour ks = v_isect->at(i).getSpecular();
+                    Colour ks = v_isect->at(i).getShading().ks;
                     colours->at(i) *= REFLECTION_ATTENUATION * ks;
                 }
 
@@ -300,11 +344,11 @@ void Tracer::castReflectionRays(const vector<Ray*>* rays, ColourVector* colours,
         Packet packet;
         packet.setRays(reflectionRays);
 
-        tracePacket(packet, colours, *l_hits, depth + 1);
+        tracePacket(packet, colours, *l_hits, depth + 1, NULL, paths);
 
         for(int i = 0; i < n; ++i) {
             if(v_hit.at(i) && l_hits->at(i)) {
-                Colour ks = v_isect->at(i).getSpecular();
+                Colour ks = v_isect->at(i).getShading().ks;
                 colours->at(i) *= REFLECTION_ATTENUATION * ks;
             }
         }
@@ -319,10 +363,12 @@ void Tracer::castReflectionRays(const vector<Ray*>* rays, ColourVector* colours,
 void Tracer::castRefractionRays(const vector<Ray*>* rays, ColourVector* colours, 
         const vector<bool>& v_hit, vector<Intersection>* v_isect, int depth)
 {
-    if(depth > MAX_DEPTH) {
+    if(depth > m_maxDepth) {
         return;
     }
 
+    PerfPhase phase(PerfCounters::refraction);
+
     int n = rays->size();
     vector<bool>* l_hits = new vector<bool>(n);
 
@@ -332,9 +378,8 @@ void Tracer::castRefractionRays(const vector<Ray*>* rays, ColourVector* colours,
     for(int i = 0; i < n; ++i) {
         if(v_hit.at(i)) {
             Intersection* isect = &v_isect->at(i);
-            PhongMaterial * material = isect->getPrimitive()->getMaterial();
 
-            if(material->getTransmitRatio() > 1.0e-10) {
+            if(isect->getShading().transmitRatio > 1.0e-10) {
                 refractionRays->at(i) = new Ray(getRefracted(*rays->at(i), isect));
                 continue;
             }
@@ -355,6 +400,10 @@ void Tracer::castRefractionRays(const vector<Ray*>* rays, ColourVector* colours,
         delete refractionRays;
 
     } else */
+    if(PROFILE) {
+        PerfCounters::addRays(PerfCounters::refraction, n - j);
+    }
+
     if(j < n) {
         Packet packet;
         packet.setRays(refractionRays);
@@ -367,19 +416,61 @@ void Tracer::castRefractionRays(const vector<Ray*>* rays, ColourVector* colours,
     delete l_hits;
 }
 
-void Tracer::tracePacket(Packet& packet, ColourVector* colours, vector<bool>& v_hit, int depth) {
+void Tracer::tracePacket(Packet& packet, ColourVector* colours, vector<bool>& v_hit, int depth,
+        vector<Intersection>* primary, vector<MirrorPath>* paths) 
+{
     vector<Ray*>* rays = packet.getRays();
     int n = rays->size();
 
     vector<Intersection>* v_isect = new vector<Intersection>(n);
     m_bih->getIntersection(packet, v_hit, v_isect); 
 
+    for(int i = 0; i < n; i++) {
+        if(v_hit.at(i)) {
+            v_isect->at(i).finalize(*rays->at(i));
+        }
+    }
+
+    if(primary != NULL) {
+        for(int i = 0; i < n; i++) {
+            if(v_hit.at(i)) {
+                primary->at(i) = v_isect->at(i);
+            }
+        }
+    }
+
+    if(paths != NULL) {
+        for(int i = 0; i < n; i++) {
+            if(rays->at(i) == NULL) {
+                continue;
+            }
+
+            MirrorPath& path = paths->at(i);
+
+            if(!v_hit.at(i)) {
+                if(depth > 0) {
+                    path.escaped = true;
+                    path.escapeDir = rays->at(i)->getDirection();
+                }
+                continue;
+            }
+
+            if(depth > 0) {
+                path.points.push_back(v_isect->at(i).getPoint());
+            }
+
+            if(v_isect->at(i).getShading().transmitRatio > 1.0e-10) {
+                path.refracted = true;
+            }
+        }
+    }
+
     ColourVector* shadowColours = new ColourVector(n);
     castShadowRays(rays, shadowColours, v_hit, v_isect);
 
 #ifndef NO_SECONDARY
     ColourVector* reflectColours = new ColourVector(n);
-    castReflectionRays(rays, reflectColours, v_hit, v_isect, depth + 1);
+    castReflectionRays(rays, reflectColours, v_hit, v_isect, depth + 1, paths);
 
     ColourVector* refractColours = new ColourVector(n);
     castRefractionRays(rays, refractColours, v_hit, v_isect, depth + 1);
@@ -389,20 +480,21 @@ void Tracer::tracePacket(Packet& packet, ColourVector* colours, vector<bool>& v_
         if(v_hit.at(i)) {
             Intersection* isect = &v_isect->at(i);
 
-            PhongMaterial* material = isect->getPrimitive()->getMaterial();
-            double transmitRatio = material->getTransmitRatio();
+            const ShadingRecord& shading = isect->getShading();
+            double transmitRatio = shading.transmitRatio;
             double reflectRatio = 1.0 - transmitRatio;
 
             if(reflectRatio > 1.0e-10) {    
-                if(material->isDiffuse()) {
-                    colours->at(i) = reflectRatio * isect->getDiffuse() * m_ambient;
+                if(shading.diffuse) {
+                    colours->at(i) = reflectRatio * shading.albedo * m_ambient;
                 }
 
                 colours->at(i) += reflectRatio * shadowColours->at(i);
                 
-                if(material->isSpecular()) {
+                if(shading.specular) {
 #ifdef NO_SECONDARY
-                    colours->at(i) += reflectRatio * castReflectionRay(*rays->at(i), isect, depth + 1);
+                    colours->at(i) += reflectRatio * castReflectionRay(*rays->at(i), isect, depth + 1,
+                            (paths == NULL) ? NULL : &paths->at(i));
 #else
                     colours->at(i) += reflectRatio * reflectColours->at(i);
 #endif
@@ -16,22 +16,33 @@
 class Tracer {
 public:
     Tracer(std::vector<Primitive*>* primitives, const Colour& ambient, const std::list<Light*>* lights);
+    ~Tracer();
 
-    bool traceRay(Ray& ray, Colour& colour, int depth = 0);
-    void tracePacket(Packet& packet, ColourVector* colours, std::vector<bool>& v_hit, int depth = 0);
+    // primary gets the first hit. path, or paths for each ray of a
+    // packet, gets where the ray's mirror bounces went.
+    bool traceRay(Ray& ray, Colour& colour, int depth = 0, Intersection* primary = NULL,
+            MirrorPath* path = NULL);
+    void tracePacket(Packet& packet, ColourVector* colours, std::vector<bool>& v_hit, int depth = 0,
+            std::vector<Intersection>* primary = NULL, std::vector<MirrorPath>* paths = NULL);
 
     void updatePrimitives(std::vector<Primitive*>* primitives);
 
+    const std::list<Light*>* getLights() const { return m_lights; }
+
+    int getMaxDepth() const { return m_maxDepth; }
+    void setMaxDepth(int depth) { m_maxDepth = depth; }
+
 private:
     Colour castShadowRays(const Ray& ray, Intersection* isect);
-    Colour castReflectionRay(const Ray& ray, Intersection* isect, int depth);
+    Colour castReflectionRay(const Ray& ray, Intersection* isect, int depth, MirrorPath* path);
     Colour castRefractionRay(const Ray& ray, Intersection* isect, int depth);
 
     void castShadowRays(const std::vector<Ray*>* rays, ColourVector* colours, 
             const std::vector<bool>& v_hit, std::vector<Intersection>* v_isect);
 
     void castReflectionRays(const std::vector<Ray*>* rays, ColourVector* colours, 
-            const std::vector<bool>& v_hit, std::vector<Intersection>* v_isect, int depth);
+            const std::vector<bool>& v_hit, std::vector<Intersection>* v_isect, int depth,
+            std::vector<MirrorPath>* paths);
 
     void castRefractionRays(const std::vector<Ray*>* rays, ColourVector* colours, 
             const std::vector<bool>& v_hit, std::vector<Intersection>* v_isect, int depth);
@@ -46,6 +57,8 @@ private:
     const Camera* m_cam;
     Colour m_ambient;
     const std::list<Light*>* m_lights;
+
+    int m_maxDepth;
 };
 
 #endif
@@ -0,0 +1,111 @@
+#!/bin/sh
+# Renders a small scene with the render farm while workers die or hang,
+# and checks every image matches one rendered by a single healthy worker.
+#
+# Usage: farm_test.sh [path to rt]
+#
+# rt defaults to ../src/rt next to this script. The exit status is 1 if
+# any case failed.
+
+here=$(cd "$(dirname "$0")" && pwd)
+rt=${1:-$here/../src/rt}
+
+if [ ! -x "$rt" ]; then
+    echo "No rt at $rt, build it first" >&2
+    exit 2
+fi
+
+rt=$(cd "$(dirname "$rt")" && pwd)/$(basename "$rt")
+
+dir=$(mktemp -d "${TMPDIR:-/tmp}/farm-test.XXXXXX") || exit 2
+trap 'rm -rf "$dir"' EXIT
+cd "$dir" || exit 2
+
+cat > scene.lua <<'LUA'
+mat = gr.material({0.7, 1.0, 0.7}, {0.5, 0.7, 0.5}, 25)
+root = gr.node('root')
+
+for i = 0, 15 do
+  s = gr.nh_sphere('s' .. i, {(i % 4) * 60 - 90, math.floor(i / 4) * 60 - 90, -200}, 25)
+  s:set_material(mat)
+  root:add_child(s)
+end
+
+light = gr.light({-100.0, 150.0, 400.0}, {0.9, 0.9, 0.9}, {1, 0, 0})
+
+gr.render(root, 'out.png', 96, 96,
+          {0, 0, 400}, {0, 0, -400}, {0, 1, 0}, 50,
+          {0.3, 0.3, 0.3}, {light})
+LUA
+
+passed=0
+failed=0
+
+# A farm that never gives up on a hung worker would hang the test too
+run() {
+    if command -v timeout > /dev/null; then
+        timeout 120 "$@"
+    else
+        "$@"
+    fi
+}
+
+# Runs the farm with the given worker command and options and checks
+# its exit status and image. Worker 0 takes the extra worker options.
+check() {
+    name=$1
+    expect=$2
+    worker0=$3
+    shift 3
+
+    rm -f out.png
+    command="if [ \"\$FARM_WORKER\" = 0 ]; then exec '$rt' --worker $worker0 scene.lua;"
+    command="$command else exec '$rt' --worker scene.lua; fi"
+
+    run "$rt" --farm "$@" --command "$command" scene.lua > "$name.log" 2>&1
+    status=$?
+
+    if [ "$expect" = fail ]; then
+        if [ $status -ne 0 ]; then
+            echo "$name: ok, failed as expected"
+            passed=$((passed + 1))
+        else
+            echo "$name: FAIL, rendered although every worker died"
+            failed=$((failed + 1))
+        fi
+        return
+    fi
+
+    if [ $status -ne 0 ]; then
+        echo "$name: FAIL, exit status $status"
+        sed 's/^/    /' "$name.log"
+        failed=$((failed + 1))
+    elif ! cmp -s out.png reference.png; then
+        echo "$name: FAIL, image differs from the single worker's"
+        failed=$((failed + 1))
+    elif [ -n "$expect" ] && ! grep -q "$expect" "$name.log"; then
+        echo "$name: FAIL, no \"$expect\" in the output"
+        sed 's/^/    /' "$name.log"
+        failed=$((failed + 1))
+    else
+        echo "$name: ok"
+        passed=$((passed + 1))
+    fi
+}
+
+if ! run "$rt" --farm 1 --tile 1 scene.lua > reference.log 2>&1 || [ ! -f out.png ]; then
+    echo "reference: FAIL, a single worker could not render the scene"
+    sed 's/^/    /' reference.log
+    exit 1
+fi
+
+mv out.png reference.png
+
+check healthy "" "" 3 --tile 1
+check fail-after "sending its" "--fail-after 2" 3 --tile 1
+check fail-all fail "--fail-after 1" 1 --tile 1
+check stall "timed out on a tile" "--stall-after 1" 3 --tile 1 --timeout 2
+
+echo "$passed passed, $failed failed"
+
+[ $failed -eq 0 ]
@@ -0,0 +1,466 @@
+// Renders scenes headlessly and checks the output against reference
+// images. Each scene is first rendered by brute force, with the BIH,
+// packets and every other fast path off, so every ray goes through the
+// primitive list in Tracer::getIntersection. That image is compared with
+// the stored reference, and every acceleration mode is then compared
+// with it, so a fast path that changes the output fails even when the
+// references are stale.
+//
+// Two images match when no more than --max-bad of their pixels differ by
+// more than --tolerance in any channel, and their PSNR is at least
+// --psnr. Every scene runs in its own process, so a crash or a Lua error
+// only fails that scene.
+//
+// Usage: golden-test [options] [scene.lua ...]
+//     --size 128x128            frame size
+//     --samples 1               samples per pixel along each axis
+//     --threads n               worker threads, all cores by default
+//     --references dir          reference PNGs, ../test/golden by default
+//     --update                  write the brute force images as references
+//     --tolerance 2             allowed difference per channel, 0 to 255
+//     --max-bad 0.001           allowed fraction of pixels over tolerance
+//     --psnr 40                 lowest allowed PSNR in dB
+//
+// Without scenes, the scene of each reference is run: golden/hier.png
+// checks hier.lua. With --update and no scenes, every .lua file in the
+// current directory is run instead. Run it from the data directory so
+// the scene's require calls resolve. A scene without a reference, or
+// whose script fails, fails unless --update is given. The exit status
+// is 1 if any scene failed.
+//
+// The references in test/golden are rendered at the default size and
+// samples. secondary.lua is left out, since its refracted rays differ
+// between packets and brute force.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QStringList>
+
+#include "a4.hpp"
+#include "camera.hpp"
+#include "capture.hpp"
+#include "framebuffer.hpp"
+#include "packet.hpp"
+#include "primitive.hpp"
+#include "tracejob.hpp"
+#include "tracer.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+// Exit statuses of a scene's child process
+#define SCENE_PASSED 0
+#define SCENE_FAILED 1
+#define SCENE_SKIPPED 2
+
+struct Options {
+    Options() : width(128), height(128), samples(1), threads(1), update(false),
+        references("../test/golden"), tolerance(2), maxBad(0.001), psnr(40.0) {}
+
+    vector<string> scenes;
+
+    int width;
+    int height;
+    int samples;
+    int threads;
+
+    bool update;
+    string references;
+
+    int tolerance;
+    double maxBad;
+    double psnr;
+};
+
+// The runtime flags a render is made with
+struct Mode {
+    const char* name;
+
+    bool bih;
+    bool packets;
+    bool fastSpheres;
+    bool frusta;
+    bool hybrid;
+
+    // Camera packet size in rays, as gr.packet_size takes it
+    int packetWidth;
+    int packetHeight;
+};
+
+// The first mode is the brute force one the rest are checked against.
+// Packets are only traced through the BIH, as in the Accel menu. The
+// last mode traces packets one ray tall, whose corners coincide in
+// pairs.
+static const Mode MODES[] = {
+    { "brute",       false, false, false, false, false, 16, 16 },
+    { "bih",         true,  false, false, false, false, 16, 16 },
+    { "bih+packets", true,  true,  false, false, false, 16, 16 },
+    { "all",         true,  true,  true,  true,  true,  16, 16 },
+    { "all 16x1",    true,  true,  true,  true,  true,  16, 1  },
+};
+
+//*************************** Rendering *****************************
+
+// The scene the script passed to gr.render
+static CapturedScene s_scene;
+
+/*  renderMode
+ *
+ *  Sets the runtime flags for the mode and renders one frame with a
+ *  tracer of its own, since the tracer only builds a BIH when BIH is on
+ *  as it is made.
+ */
+static QImage renderMode(const Mode& mode, vector<Primitive*>* primitives, const Options& options) {
+    BIH = mode.bih;
+    PACKETS = mode.packets;
+    FAST_SPHERES = mode.fastSpheres;
+    FRUSTA = mode.frusta;
+    HYBRID = mode.hybrid;
+
+    CameraPacket::setPacketSize(mode.packetWidth, mode.packetHeight);
+
+    // A single frame is traced either way
+    CACHE = false;
+
+    Tracer tracer(primitives, s_scene.ambient, &s_scene.lights);
+
+    s_scene.camera->updateDimensions(options.width, options.height);
+    FrameBuffer frame(options.width, options.height);
+
+    vector<CameraPacket*>* packets = CameraPacket::genPackets(&frame, &tracer, *s_scene.camera, options.samples);
+    TraceJob::run(packets, options.threads);
+    CameraPacket::deletePackets(packets);
+
+    QImage img(options.width, options.height, QImage::Format_RGB32);
+    frame.resolve(&img);
+
+    return img;
+}
+
+//*************************** Comparison *****************************
+
+struct Difference {
+    Difference() : badPixels(0), maxError(0), psnr(INFINITY) {}
+
+    // Pixels with a channel over the tolerance
+    int badPixels;
+    int maxError;
+
+    // In dB, infinite for identical images
+    double psnr;
+};
+
+static Difference compareImages(const QImage& a, const QImage& b, int tolerance) {
+    Difference diff;
+    double squared = 0.0;
+
+    for(int y = 0; y < a.height(); ++y) {
+        for(int x = 0; x < a.width(); ++x) {
+            QRgb p = a.pixel(x, y);
+            QRgb q = b.pixel(x, y);
+
+            int error = std::max(abs(qRed(p) - qRed(q)),
+                std::max(abs(qGreen(p) - qGreen(q)), abs(qBlue(p) - qBlue(q))));
+
+            if(error > tolerance) {
+                ++diff.badPixels;
+            }
+
+            diff.maxError = std::max(diff.maxError, error);
+
+            squared += (qRed(p) - qRed(q)) * (qRed(p) - qRed(q)) +
+                (qGreen(p) - qGreen(q)) * (qGreen(p) - qGreen(q)) +
+                (qBlue(p) - qBlue(q)) * (qBlue(p) - qBlue(q));
+        }
+    }
+
+    double mse = squared / (3.0 * a.width() * a.height());
+
+    if(mse > 0.0) {
+        diff.psnr = 10.0 * log10(255.0 * 255.0 / mse);
+    }
+
+    return diff;
+}
+
+// Prints one line for the comparison and returns whether it passed
+static bool report(std::ostream& out, const string& scene, const string& what,
+        const QImage& image, const QImage& expected, const Options& options)
+{
+    out << scene << ": " << what << ": ";
+
+    if(image.size() != expected.size()) {
+        out << "FAIL, " << image.width() << "x" << image.height() << " image against "
+            << expected.width() << "x" << expected.height() << endl;
+        return false;
+    }
+
+    Difference diff = compareImages(image, expected, options.tolerance);
+
+    double badFraction = diff.badPixels / (double)(image.width() * image.height());
+    bool passed = badFraction <= options.maxBad && diff.psnr >= options.psnr;
+
+    out << (passed ? "ok" : "FAIL") << ", " << diff.badPixels << " pixels over tolerance, max error "
+        << diff.maxError << ", PSNR ";
+
+    if(isinf(diff.psnr)) {
+        out << "inf" << endl;
+    } else {
+        out << std::fixed << std::setprecision(1) << diff.psnr << " dB" << endl;
+    }
+
+    return passed;
+}
+
+static string getReferencePath(const string& scene, const Options& options) {
+    string name = QFileInfo(QString::fromStdString(scene)).completeBaseName().toStdString();
+    return options.references + "/" + name + ".png";
+}
+
+/*  testScene
+ *
+ *  Loads the scene, renders it in every mode and reports each comparison
+ *  to out. Returns one of the SCENE_ statuses. Meant to run in a process
+ *  of its own.
+ */
+static int testScene(const string& filename, const Options& options, std::ostream& out) {
+    if(!captureScene(filename, &s_scene)) {
+        out << filename << ": FAIL, the script failed" << endl;
+        return SCENE_FAILED;
+    }
+
+    if(s_scene.root == NULL) {
+        out << filename << ": no scene to render, skipped" << endl;
+        return SCENE_SKIPPED;
+    }
+
+    vector<Primitive*>* primitives = new vector<Primitive*>();
+    s_scene.root->getPrimitives(primitives);
+
+    if(primitives->empty()) {
+        out << filename << ": no primitives, skipped" << endl;
+        return SCENE_SKIPPED;
+    }
+
+    QImage brute = renderMode(MODES[0], primitives, options);
+    string reference = getReferencePath(filename, options);
+
+    bool passed = true;
+
+    if(options.update) {
+        if(!brute.save(QString::fromStdString(reference))) {
+            out << filename << ": could not write " << reference << endl;
+            return SCENE_FAILED;
+        }
+
+        out << filename << ": wrote " << reference << endl;
+    } else {
+        QImage expected(QString::fromStdString(reference));
+
+        if(expected.isNull()) {
+            out << filename << ": FAIL, no reference at " << reference << endl;
+            passed = false;
+        } else {
+            passed = report(out, filename, "brute vs reference",
+                brute, expected.convertToFormat(QImage::Format_RGB32), options);
+        }
+    }
+
+    int numModes = sizeof(MODES) / sizeof(MODES[0]);
+
+    for(int i = 1; i < numModes; ++i) {
+        QImage image = renderMode(MODES[i], primitives, options);
+
+        if(!report(out, filename, string(MODES[i].name) + " vs brute", image, brute, options)) {
+            passed = false;
+        }
+    }
+
+    return passed ? SCENE_PASSED : SCENE_FAILED;
+}
+
+// Runs testScene in a child process, prints its report and returns its
+// status
+static int runChild(const string& filename, const Options& options) {
+    int fds[2];
+
+    if(pipe(fds) != 0) {
+        return SCENE_FAILED;
+    }
+
+    pid_t pid = fork();
+
+    if(pid == 0) {
+        close(fds[0]);
+
+        // Keep what the scene prints out of the report
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+
+        std::ostringstream out;
+        int status = testScene(filename, options, out);
+
+        string text = out.str();
+
+        if(write(fds[1], text.c_str(), text.size()) != (ssize_t)text.size()) {
+            _exit(SCENE_FAILED);
+        }
+
+        close(fds[1]);
+        _exit(status);
+    }
+
+    close(fds[1]);
+
+    if(pid < 0) {
+        close(fds[0]);
+        cout << filename << ": FAIL, could not fork" << endl;
+        return SCENE_FAILED;
+    }
+
+    char buffer[256];
+    ssize_t n;
+
+    while((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+        cout.write(buffer, n);
+    }
+
+    close(fds[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+
+    if(WIFSIGNALED(status)) {
+        cout << filename << ": FAIL, killed by signal " << WTERMSIG(status) << endl;
+        return SCENE_FAILED;
+    }
+
+    return WEXITSTATUS(status);
+}
+
+//*************************** Options *****************************
+
+static bool parseOptions(int argc, char** argv, Options* options) {
+    options->threads = std::max(1, (int)sysconf(_SC_NPROCESSORS_ONLN));
+
+    for(int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+
+        if(arg.compare(0, 2, "--") != 0) {
+            options->scenes.push_back(arg);
+            continue;
+        }
+
+        if(arg == "--update") {
+            options->update = true;
+            continue;
+        }
+
+        if(i + 1 >= argc) {
+            cerr << arg << " needs a value" << endl;
+            return false;
+        }
+
+        string value = argv[++i];
+        bool ok = true;
+
+        if(arg == "--size") {
+            ok = sscanf(value.c_str(), "%dx%d", &options->width, &options->height) == 2 &&
+                options->width > 0 && options->height > 0;
+        } else if(arg == "--samples") {
+            options->samples = atoi(value.c_str());
+            ok = options->samples > 0;
+        } else if(arg == "--threads") {
+            options->threads = atoi(value.c_str());
+            ok = options->threads > 0;
+        } else if(arg == "--references") {
+            options->references = value;
+        } else if(arg == "--tolerance") {
+            options->tolerance = atoi(value.c_str());
+            ok = options->tolerance >= 0;
+        } else if(arg == "--max-bad") {
+            options->maxBad = atof(value.c_str());
+            ok = options->maxBad >= 0.0;
+        } else if(arg == "--psnr") {
+            options->psnr = atof(value.c_str());
+        } else {
+            cerr << "Unknown option " << arg << endl;
+            return false;
+        }
+
+        if(!ok) {
+            cerr << "Bad value for " << arg << ": " << value << endl;
+            return false;
+        }
+    }
+
+    if(options->scenes.empty() && options->update) {
+        QStringList files = QDir(".").entryList(QStringList("*.lua"), QDir::Files, QDir::Name);
+
+        for(auto it = files.begin(); it != files.end(); ++it) {
+            options->scenes.push_back(it->toStdString());
+        }
+    } else if(options->scenes.empty()) {
+        QDir references(QString::fromStdString(options->references));
+        QStringList files = references.entryList(QStringList("*.png"), QDir::Files, QDir::Name);
+
+        if(files.empty()) {
+            cerr << "No references in " << options->references << endl;
+            return false;
+        }
+
+        for(auto it = files.begin(); it != files.end(); ++it) {
+            options->scenes.push_back(QFileInfo(*it).completeBaseName().toStdString() + ".lua");
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+
+    if(!parseOptions(argc, argv, &options)) {
+        return 2;
+    }
+
+    if(options.update && !QDir().mkpath(QString::fromStdString(options.references))) {
+        cerr << "Could not create " << options.references << endl;
+        return 2;
+    }
+
+    int passed = 0;
+    int failed = 0;
+    int skipped = 0;
+
+    for(auto scene = options.scenes.begin(); scene != options.scenes.end(); ++scene) {
+        switch(runChild(*scene, options)) {
+        case SCENE_PASSED:
+            ++passed;
+            break;
+        case SCENE_SKIPPED:
+            ++skipped;
+            break;
+        default:
+            ++failed;
+            break;
+        }
+    }
+
+    cout << passed << " passed, " << failed << " failed, " << skipped << " skipped" << endl;
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,14 @@
+# Checks renders of the scenes in data against reference images, and
+# every acceleration mode against brute force
+#   qmake golden_test.pro && make && cd ../data && ../test/golden-test
+
+QT += widgets
+CONFIG += c++11
+QMAKE_CXXFLAGS += -W -Wall -O2 -pthread
+TEMPLATE = app
+TARGET = golden-test
+INCLUDEPATH += . "/usr/include/lua5.1"
+LIBS += -llua5.1 -pthread
+
+include(../src/core.pri)
+SOURCES += golden_test.cpp
@@ -0,0 +1,247 @@
+// Writes test images with PngWriter and checks that Qt reads every pixel
+// back exactly. Each image is written with every row filter at several
+// compression levels, encoding thread counts and band heights, so rows
+// are split into parts, and parts into bands, in as many ways as the
+// writer allows. The images mix noise, gradients and flat areas, so
+// every filter is picked somewhere by the adaptive one.
+//
+// Usage: png-test [--keep]
+//     --keep    leave the files of failed cases in the temporary directory
+//
+// The exit status is 1 if any case failed.
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <QDir>
+#include <QImage>
+
+#include "pngwriter.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+struct Size {
+    int width;
+    int height;
+};
+
+// One pixel, a column and a row, and sizes that don't divide into the
+// parts the writer makes
+static const Size SIZES[] = {
+    { 1, 1 },
+    { 1, 40 },
+    { 53, 1 },
+    { 97, 61 },
+    { 256, 130 },
+};
+
+static const int LEVELS[] = { 0, 1, 6, 9 };
+static const int THREADS[] = { 1, 3, 8 };
+
+// Rows per writeRows call. 0 writes the whole image at once.
+static const int BANDS[] = { 1, 17, 64, 0 };
+
+#define NUM_OF(array) ((int)(sizeof(array) / sizeof(array[0])))
+
+//*************************** Images *****************************
+
+// A fixed sequence, so a failure can be reproduced
+static unsigned int s_seed = 1;
+
+static int nextRandom() {
+    s_seed = s_seed * 1103515245 + 12345;
+    return (s_seed >> 16) & 0xff;
+}
+
+// Noise in the top left, a gradient in the top right, a flat colour in
+// the bottom left and stripes in the bottom right
+static QImage makeImage(int width, int height) {
+    QImage img(width, height, QImage::Format_RGB32);
+
+    for(int y = 0; y < height; ++y) {
+        for(int x = 0; x < width; ++x) {
+            bool left = x < width / 2;
+            bool top = y < height / 2;
+            QRgb colour;
+
+            if(left && top) {
+                colour = qRgb(nextRandom(), nextRandom(), nextRandom());
+            } else if(top) {
+                colour = qRgb(x & 0xff, y & 0xff, (x + y) & 0xff);
+            } else if(left) {
+                colour = qRgb(40, 200, 90);
+            } else {
+                colour = ((x / 3) % 2 == 0) ? qRgb(255, 255, 255) : qRgb(0, 0, (7 * y) & 0xff);
+            }
+
+            img.setPixel(x, y, colour);
+        }
+    }
+
+    return img;
+}
+
+// Rows first to first + rows - 1 of img
+static QImage getRows(const QImage& img, int first, int rows) {
+    QImage band(img.width(), rows, QImage::Format_RGB32);
+
+    for(int y = 0; y < rows; ++y) {
+        memcpy(band.scanLine(y), img.constScanLine(first + y), 4 * img.width());
+    }
+
+    return band;
+}
+
+//*************************** Cases *****************************
+
+struct Case {
+    Size size;
+    int level;
+    PngWriter::Filter filter;
+    int threads;
+    int band;
+};
+
+static string describe(const Case& c) {
+    static const char* filters[] = { "none", "sub", "up", "average", "paeth", "adaptive" };
+
+    std::ostringstream out;
+    out << c.size.width << "x" << c.size.height << " level " << c.level << " " << filters[c.filter]
+        << " threads " << c.threads << " band ";
+
+    if(c.band == 0) {
+        out << "all";
+    } else {
+        out << c.band;
+    }
+
+    return out.str();
+}
+
+// Writes img as the case says to filename
+static bool writeImage(const QImage& img, const Case& c, const string& filename) {
+    if(!PngWriter::setCompression(c.level, c.filter, c.threads)) {
+        return false;
+    }
+
+    PngWriter writer;
+
+    if(!writer.open(filename, img.width(), img.height())) {
+        return false;
+    }
+
+    int band = (c.band == 0) ? img.height() : c.band;
+
+    for(int y = 0; y < img.height(); y += band) {
+        int rows = std::min(band, img.height() - y);
+
+        if(!writer.writeRows(getRows(img, y, rows))) {
+            writer.close();
+            return false;
+        }
+    }
+
+    return writer.close();
+}
+
+/*  runCase
+ *
+ *  Writes img, reads it back with Qt and prints what went wrong if any
+ *  pixel changed. Returns whether the case passed.
+ */
+static bool runCase(const QImage& img, const Case& c, const string& filename, bool keep) {
+    bool passed = true;
+
+    if(!writeImage(img, c, filename)) {
+        cout << describe(c) << ": FAIL, could not write " << filename << endl;
+        passed = false;
+    } else {
+        QImage read(QString::fromStdString(filename));
+
+        if(read.isNull()) {
+            cout << describe(c) << ": FAIL, Qt could not read " << filename << endl;
+            passed = false;
+        } else if(read.width() != img.width() || read.height() != img.height()) {
+            cout << describe(c) << ": FAIL, read back as " << read.width() << "x" << read.height() << endl;
+            passed = false;
+        } else {
+            read = read.convertToFormat(QImage::Format_RGB32);
+
+            for(int y = 0; y < img.height() && passed; ++y) {
+                for(int x = 0; x < img.width(); ++x) {
+                    if((read.pixel(x, y) & 0xffffff) != (img.pixel(x, y) & 0xffffff)) {
+                        cout << describe(c) << ": FAIL, pixel " << x << "," << y << " is "
+                            << std::hex << (read.pixel(x, y) & 0xffffff) << " not "
+                            << (img.pixel(x, y) & 0xffffff) << std::dec << endl;
+                        passed = false;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    if(passed || !keep) {
+        unlink(filename.c_str());
+    } else {
+        cout << "    kept " << filename << endl;
+    }
+
+    return passed;
+}
+
+int main(int argc, char** argv) {
+    bool keep = false;
+
+    for(int i = 1; i < argc; ++i) {
+        if(string(argv[i]) == "--keep") {
+            keep = true;
+        } else {
+            cerr << "Unknown option " << argv[i] << endl;
+            return 2;
+        }
+    }
+
+    string directory = QDir::tempPath().toStdString();
+
+    int passed = 0;
+    int failed = 0;
+
+    for(int s = 0; s < NUM_OF(SIZES); ++s) {
+        QImage img = makeImage(SIZES[s].width, SIZES[s].height);
+
+        for(int l = 0; l < NUM_OF(LEVELS); ++l) {
+            for(int f = PngWriter::none; f <= PngWriter::adaptive; ++f) {
+                for(int t = 0; t < NUM_OF(THREADS); ++t) {
+                    for(int b = 0; b < NUM_OF(BANDS); ++b) {
+                        Case c = { SIZES[s], LEVELS[l], (PngWriter::Filter)f, THREADS[t], BANDS[b] };
+
+                        std::ostringstream filename;
+                        filename << directory << "/png-test-" << getpid() << "-" << s << "-" << l
+                            << "-" << f << "-" << t << "-" << b << ".png";
+
+                        if(runCase(img, c, filename.str(), keep)) {
+                            ++passed;
+                        } else {
+                            ++failed;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    cout << passed << " passed, " << failed << " failed" << endl;
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,13 @@
+# Round trips images through PngWriter and Qt's PNG reader
+#   qmake png_test.pro && make && ./png-test
+
+QT += widgets
+CONFIG += c++11
+QMAKE_CXXFLAGS += -W -Wall -O2 -pthread
+TEMPLATE = app
+TARGET = png-test
+INCLUDEPATH += . "/usr/include/lua5.1"
+LIBS += -llua5.1 -pthread
+
+include(../src/core.pri)
+SOURCES += png_test.cpp
@@ -0,0 +1,436 @@
+// Checks the lane parallel cubic and quartic solvers in simdroots.cpp
+// against cubicRoots and quarticRoots from polyroots.cpp on random
+// polynomials. Half are built from chosen roots, some of them pairs a
+// small gap apart, and half have random coefficients. Batches of every
+// size up to a few SIMD widths are solved, so padding lanes are covered.
+//
+// For each polynomial, every root either solver returns must leave a
+// residual of at most RESIDUAL_EPSILON relative to the size of the terms,
+// and the two solvers must return the same roots to within
+// ROOT_EPSILON. They may only disagree at a near-double root: two roots
+// closer than NEAR_DOUBLE_GAP, at which the polynomial barely crosses
+// zero, may be real for one solver and a complex pair for the other. Such polynomials are counted and reported but don't fail. In a
+// cluster of three or four roots that close, where the polynomial is
+// flat, the solvers may also settle on different roots of the cluster;
+// two roots that differ are accepted if the slope at both is at most
+// FLAT_EPSILON relative to the size of its terms.
+//
+// cubicRoots takes the acos of a value that rounding can push just past
+// 1 at a near-double root, and then returns NaN for all three roots, as
+// quarticRoots does through its resolvent cubic. Those polynomials are
+// counted apart, and only the residuals of the lane parallel roots are
+// checked.
+//
+// Usage: roots-test [--verbose]
+//     --verbose    print every polynomial that fails or that the solvers disagree on
+//
+// The exit status is 1 if any polynomial failed.
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "polyroots.hpp"
+#include "simdroots.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+// Polynomials of each degree
+#define NUM_POLYNOMIALS 20000
+
+// Batch sizes run from 1 up to this many polynomials
+#define MAX_BATCH 13
+
+#define RESIDUAL_EPSILON 1.0e-9
+#define ROOT_EPSILON 1.0e-6
+#define NEAR_DOUBLE_GAP 1.0e-3
+#define FLAT_EPSILON 1.0e-8
+
+//*************************** Polynomials *****************************
+
+// A fixed sequence, so a failure can be reproduced
+static unsigned int s_seed = 1;
+
+// Uniform in [lo, hi)
+static double nextRandom(double lo, double hi) {
+    s_seed = s_seed * 1103515245 + 12345;
+    return lo + (hi - lo) * ((s_seed >> 8) & 0xffffff) / (double)0x1000000;
+}
+
+// A monic polynomial of the given degree. coeffs[k] multiplies
+// x^(degree - 1 - k), so coeffs holds A, B, C and for quartics D.
+struct Polynomial {
+    int degree;
+    double coeffs[4];
+};
+
+// Multiplies the monic poly, of degree n, by x^2 + b x + c
+static void multiplyQuadratic(double* poly, int n, double b, double c) {
+    double result[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+    // poly[0] is the leading 1
+    for(int k = 0; k <= n; ++k) {
+        result[k] += poly[k];
+        result[k + 1] += b * poly[k];
+        result[k + 2] += c * poly[k];
+    }
+
+    memcpy(poly, result, sizeof(result));
+}
+
+static void multiplyLinear(double* poly, int n, double root) {
+    double result[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+    for(int k = 0; k <= n; ++k) {
+        result[k] += poly[k];
+        result[k + 1] -= root * poly[k];
+    }
+
+    memcpy(poly, result, sizeof(result));
+}
+
+/*  makePolynomial
+ *
+ *  Even polynomials have random coefficients in [-10, 10). Odd ones are
+ *  built from factors: real roots in [-10, 10), sometimes a complex
+ *  pair, and in one of four a pair of real roots a tiny gap apart, which
+ *  is where the solvers are least stable.
+ */
+static Polynomial makePolynomial(int degree, int index) {
+    Polynomial poly;
+    poly.degree = degree;
+
+    if(index % 2 == 0) {
+        for(int k = 0; k < degree; ++k) {
+            poly.coeffs[k] = nextRandom(-10.0, 10.0);
+        }
+
+        return poly;
+    }
+
+    double product[5] = { 1.0, 0.0, 0.0, 0.0, 0.0 };
+    int n = 0;
+
+    if(index % 8 == 1) {
+        double root = nextRandom(-10.0, 10.0);
+        double gap = pow(10.0, nextRandom(-9.0, -3.0));
+
+        multiplyLinear(product, n++, root);
+        multiplyLinear(product, n++, root + gap);
+    } else if(index % 8 == 3) {
+        double real = nextRandom(-10.0, 10.0);
+        double imag = nextRandom(0.1, 10.0);
+
+        multiplyQuadratic(product, n, -2.0 * real, real * real + imag * imag);
+        n += 2;
+    }
+
+    while(n < degree) {
+        multiplyLinear(product, n++, nextRandom(-10.0, 10.0));
+    }
+
+    for(int k = 0; k < degree; ++k) {
+        poly.coeffs[k] = product[k + 1];
+    }
+
+    return poly;
+}
+
+// The value at x, and the sum of the sizes of its terms, which the
+// residual is measured against
+static double evaluate(const Polynomial& poly, double x, double* scale) {
+    double value = 1.0;
+    *scale = pow(fabs(x), poly.degree);
+
+    for(int k = 0; k < poly.degree; ++k) {
+        value = value * x + poly.coeffs[k];
+        *scale += fabs(poly.coeffs[k]) * pow(fabs(x), poly.degree - 1 - k);
+    }
+
+    return value;
+}
+
+// The derivative at x, and the sum of the sizes of its terms
+static double slope(const Polynomial& poly, double x, double* scale) {
+    double value = poly.degree;
+    *scale = poly.degree * pow(fabs(x), poly.degree - 1);
+
+    for(int k = 0; k < poly.degree - 1; ++k) {
+        int power = poly.degree - 1 - k;
+
+        value = value * x + power * poly.coeffs[k];
+        *scale += power * fabs(poly.coeffs[k]) * pow(fabs(x), power - 1);
+    }
+
+    return value;
+}
+
+// Whether x sits in a cluster of near-equal roots
+static bool isFlat(const Polynomial& poly, double x) {
+    double scale;
+    double value = slope(poly, x, &scale);
+
+    return fabs(value) <= FLAT_EPSILON * scale;
+}
+
+//*************************** Comparison *****************************
+
+struct Result {
+    Result() : failed(false), nearDouble(false), scalarNan(false) {}
+
+    bool failed;
+    bool nearDouble;
+    bool scalarNan;
+    string reason;
+};
+
+static string describe(const Polynomial& poly, const vector<double>& expected, const vector<double>& roots) {
+    std::ostringstream out;
+    out << std::setprecision(17) << "x^" << poly.degree;
+
+    for(int k = 0; k < poly.degree; ++k) {
+        out << " + " << poly.coeffs[k] << " x^" << poly.degree - 1 - k;
+    }
+
+    out << "\n    polyroots:";
+    for(size_t k = 0; k < expected.size(); ++k) {
+        out << " " << expected[k];
+    }
+
+    out << "\n    simdroots:";
+    for(size_t k = 0; k < roots.size(); ++k) {
+        out << " " << roots[k];
+    }
+
+    return out.str();
+}
+
+// Whether two of the sorted roots are closer than NEAR_DOUBLE_GAP
+static bool hasNearDouble(const vector<double>& roots) {
+    for(size_t k = 1; k < roots.size(); ++k) {
+        if(roots[k] - roots[k - 1] <= NEAR_DOUBLE_GAP * std::max(1.0, fabs(roots[k]))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*  compare
+ *
+ *  Checks the residual of every root, then pairs up the sorted roots
+ *  when both solvers found as many. Otherwise the solver with more roots
+ *  must have found a near-double root the other missed: with those two
+ *  taken out, the rest must still pair up, except where both roots of a
+ *  pair lie in a flat cluster. NaN roots from polyroots are not
+ *  compared.
+ */
+static Result compare(const Polynomial& poly, vector<double> expected, vector<double> roots) {
+    Result result;
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(roots.begin(), roots.end());
+
+    for(size_t k = 0; k < expected.size(); ++k) {
+        if(isnan(expected[k])) {
+            result.scalarNan = true;
+            expected.clear();
+            break;
+        }
+    }
+
+    for(int s = 0; s < 2; ++s) {
+        const vector<double>& found = (s == 0) ? expected : roots;
+
+        for(size_t k = 0; k < found.size(); ++k) {
+            double scale;
+            double value = evaluate(poly, found[k], &scale);
+
+            if(!(fabs(value) <= RESIDUAL_EPSILON * scale)) {
+                result.failed = true;
+                result.reason = (s == 0) ? "polyroots residual" : "simdroots residual";
+                return result;
+            }
+        }
+    }
+
+    if(result.scalarNan) {
+        return result;
+    }
+
+    if(expected.size() != roots.size()) {
+        vector<double>& more = (expected.size() > roots.size()) ? expected : roots;
+        vector<double>& fewer = (expected.size() > roots.size()) ? roots : expected;
+
+        if(more.size() != fewer.size() + 2 || !hasNearDouble(more)) {
+            result.failed = true;
+            result.reason = "root counts differ";
+            return result;
+        }
+
+        result.nearDouble = true;
+
+        // Drop the closest pair so the rest can be matched
+        size_t closest = 1;
+
+        for(size_t k = 2; k < more.size(); ++k) {
+            if(more[k] - more[k - 1] < more[closest] - more[closest - 1]) {
+                closest = k;
+            }
+        }
+
+        more.erase(more.begin() + closest - 1, more.begin() + closest + 1);
+    }
+
+    for(size_t k = 0; k < roots.size(); ++k) {
+        double tolerance = ROOT_EPSILON * std::max(1.0, fabs(expected[k]));
+
+        // Near a double root, either solver's pair may sit anywhere in a
+        // band as wide as sqrt of the rounding error
+        if(hasNearDouble(expected) || hasNearDouble(roots)) {
+            tolerance = NEAR_DOUBLE_GAP * std::max(1.0, fabs(expected[k]));
+        }
+
+        if(fabs(roots[k] - expected[k]) > tolerance && isFlat(poly, roots[k]) &&
+                isFlat(poly, expected[k]))
+        {
+            result.nearDouble = true;
+            continue;
+        }
+
+        if(!(fabs(roots[k] - expected[k]) <= tolerance)) {
+            result.failed = true;
+            result.reason = "roots differ";
+            return result;
+        }
+    }
+
+    return result;
+}
+
+//*************************** Solving *****************************
+
+// Solves polys with the scalar solver, one at a time
+static vector<double> solveScalar(const Polynomial& poly) {
+    double roots[4];
+    size_t count;
+
+    if(poly.degree == 3) {
+        count = cubicRoots(poly.coeffs[0], poly.coeffs[1], poly.coeffs[2], roots);
+    } else {
+        count = quarticRoots(poly.coeffs[0], poly.coeffs[1], poly.coeffs[2], poly.coeffs[3], roots);
+    }
+
+    return vector<double>(roots, roots + count);
+}
+
+// Solves polys with the lane parallel solver in one batch, putting the
+// roots of polynomial i in roots[i]
+static void solveBatch(const vector<Polynomial>& polys, vector<vector<double> >* roots) {
+    int n = polys.size();
+    int degree = polys[0].degree;
+
+    vector<double> coeffs[4];
+
+    for(int k = 0; k < degree; ++k) {
+        for(int i = 0; i < n; ++i) {
+            coeffs[k].push_back(polys[i].coeffs[k]);
+        }
+    }
+
+    vector<double> found(degree * n);
+    vector<int> numRoots(n);
+
+    if(degree == 3) {
+        solveCubics(n, &coeffs[0][0], &coeffs[1][0], &coeffs[2][0], &found[0], &numRoots[0]);
+    } else {
+        solveQuartics(n, &coeffs[0][0], &coeffs[1][0], &coeffs[2][0], &coeffs[3][0], &found[0],
+            &numRoots[0]);
+    }
+
+    roots->assign(n, vector<double>());
+
+    for(int i = 0; i < n; ++i) {
+        for(int k = 0; k < numRoots[i]; ++k) {
+            roots->at(i).push_back(found[k * n + i]);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bool verbose = false;
+
+    for(int i = 1; i < argc; ++i) {
+        if(string(argv[i]) == "--verbose") {
+            verbose = true;
+        } else {
+            cerr << "Unknown option " << argv[i] << endl;
+            return 2;
+        }
+    }
+
+    int totalFailed = 0;
+
+    for(int degree = 3; degree <= 4; ++degree) {
+        const char* name = (degree == 3) ? "cubics" : "quartics";
+
+        int passed = 0;
+        int failed = 0;
+        int nearDouble = 0;
+        int scalarNan = 0;
+        int index = 0;
+
+        for(int batch = 1; index < NUM_POLYNOMIALS; batch = batch % MAX_BATCH + 1) {
+            vector<Polynomial> polys;
+
+            for(int i = 0; i < batch && index < NUM_POLYNOMIALS; ++i) {
+                polys.push_back(makePolynomial(degree, index++));
+            }
+
+            vector<vector<double> > roots;
+            solveBatch(polys, &roots);
+
+            for(size_t i = 0; i < polys.size(); ++i) {
+                vector<double> expected = solveScalar(polys[i]);
+                Result result = compare(polys[i], expected, roots[i]);
+
+                if(result.failed) {
+                    ++failed;
+                } else {
+                    ++passed;
+                }
+
+                if(result.nearDouble) {
+                    ++nearDouble;
+                }
+                if(result.scalarNan) {
+                    ++scalarNan;
+                }
+
+                if(verbose && (result.failed || result.nearDouble || result.scalarNan)) {
+                    string what = result.failed ? "FAIL, " + result.reason :
+                        (result.scalarNan ? "NaN from polyroots" : "near-double root");
+
+                    cout << name << ": " << what << ": " << describe(polys[i], expected, roots[i]) << endl;
+                }
+            }
+        }
+
+        cout << name << ": " << passed << " passed, " << failed << " failed, " << nearDouble
+            << " with near-double roots the solvers disagree on, " << scalarNan
+            << " where polyroots gave NaN" << endl;
+
+        totalFailed += failed;
+    }
+
+    return (totalFailed > 0) ? 1 : 0;
+}
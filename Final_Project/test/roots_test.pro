@@ -0,0 +1,13 @@
+# Checks the lane parallel cubic and quartic solvers against polyroots
+#   qmake roots_test.pro && make && ./roots-test
+
+QT += widgets
+CONFIG += c++11
+QMAKE_CXXFLAGS += -W -Wall -O2 -pthread
+TEMPLATE = app
+TARGET = roots-test
+INCLUDEPATH += . "/usr/include/lua5.1"
+LIBS += -llua5.1 -pthread
+
+include(../src/core.pri)
+SOURCES += roots_test.cpp